@@ -9,6 +9,8 @@ if(WITH_TESTING)
     new_test(SOURCES SMCTest.cpp ${SIMPLE_TEST_MAIN})
     new_test(SOURCES ObserverTest.cpp ${SIMPLE_TEST_MAIN})
     new_test(SOURCES TwistingTest.cpp ${SIMPLE_TEST_MAIN})
+    new_test(SOURCES RecorderTest.cpp ${SIMPLE_TEST_MAIN})
+    new_test(SOURCES EnsembleTest.cpp ${SIMPLE_TEST_MAIN})
   endif()
   
 endif()
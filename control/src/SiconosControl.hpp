@@ -51,8 +51,12 @@
 // Misc
 #include "ControlManager.hpp"
 #include "MatrixIntegrator.hpp"
+#include "MatrixRecorder.hpp"
+#include "RingBufferRecorder.hpp"
+#include "BinaryFileRecorder.hpp"
 
 // sugar
 #include "ControlZOHSimulation.hpp"
 #include "ControlLsodarSimulation.hpp"
+#include "ControlEnsemble.hpp"
 
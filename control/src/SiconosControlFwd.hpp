@@ -8,7 +8,12 @@
 DEFINE_SPTR(ControlSimulation)
 DEFINE_SPTR(ControlZOHSimulation)
 DEFINE_SPTR(ControlLsodarSimulation)
+DEFINE_SPTR(ControlEnsemble)
 DEFINE_SPTR(ControlManager)
+DEFINE_SPTR(ControlRecorder)
+DEFINE_SPTR(MatrixRecorder)
+DEFINE_SPTR(RingBufferRecorder)
+DEFINE_SPTR(BinaryFileRecorder)
 
 DEFINE_SPTR(Sensor)
 DEFINE_SPTR(ControlSensor)
@@ -0,0 +1,143 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "SiconosVector.hpp"
+#include "SiconosException.hpp"
+#include "BinaryFileRecorder.hpp"
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+struct BinaryFileRecorder::_Writer
+{
+  std::FILE* file = nullptr;
+
+  /** rows being written */
+  std::vector<double> pending;
+
+  /** true while pending holds rows to write */
+  bool busy = false;
+
+  bool stop = false;
+
+  bool failed = false;
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::thread thread;
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true)
+    {
+      cond.wait(lock, [this] { return busy || stop; });
+      if(busy)
+      {
+        // the simulation does not touch pending while busy is set
+        lock.unlock();
+        std::size_t n = std::fwrite(pending.data(), sizeof(double), pending.size(), file);
+        lock.lock();
+        failed = failed || n != pending.size();
+        pending.clear();
+        busy = false;
+        cond.notify_all();
+      }
+      else
+        break;
+    }
+  }
+
+  /* give the rows to the thread, rows is replaced by an empty buffer */
+  void handOver(std::vector<double>& rows)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this] { return !busy; });
+    pending.swap(rows);
+    busy = true;
+    cond.notify_all();
+  }
+
+  /* write the remaining rows and close the file */
+  bool finish()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    cond.notify_all();
+    thread.join();
+    failed = std::fclose(file) != 0 || failed;
+    file = nullptr;
+    return !failed;
+  }
+};
+
+BinaryFileRecorder::BinaryFileRecorder(const std::string& filename, unsigned bufferRows):
+  _filename(filename), _bufferRows(bufferRows > 0 ? bufferRows : 1)
+{
+}
+
+BinaryFileRecorder::~BinaryFileRecorder()
+{
+  if(_writer)
+    _writer->finish();
+}
+
+void BinaryFileRecorder::prepare(unsigned estimatedRows)
+{
+  if(_writer)
+    _writer->finish();
+  _writer.reset(new _Writer());
+  _writer->file = std::fopen(_filename.c_str(), "wb");
+  if(!_writer->file)
+  {
+    _writer.reset();
+    THROW_EXCEPTION("BinaryFileRecorder - cannot open " + _filename);
+  }
+  _writer->thread = std::thread(&_Writer::run, _writer.get());
+  _filling.clear();
+  _filling.reserve(_bufferRows * _nColumns);
+}
+
+void BinaryFileRecorder::write(const SiconosVector& row)
+{
+  for(unsigned j = 0; j < _nColumns; ++j)
+    _filling.push_back(row(j));
+  if(_filling.size() >= _bufferRows * _nColumns)
+  {
+    _writer->handOver(_filling);
+    _filling.reserve(_bufferRows * _nColumns);
+  }
+}
+
+void BinaryFileRecorder::flush()
+{
+  if(!_writer)
+    return;
+  if(!_filling.empty())
+    _writer->handOver(_filling);
+  bool ok = _writer->finish();
+  _writer.reset();
+  if(!ok)
+  {
+    THROW_EXCEPTION("BinaryFileRecorder - cannot write " + _filename);
+  }
+}
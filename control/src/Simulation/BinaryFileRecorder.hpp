@@ -0,0 +1,90 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file BinaryFileRecorder.hpp
+  \brief Streaming of the rows of a ControlSimulation to a binary file
+*/
+
+#ifndef BinaryFileRecorder_H
+#define BinaryFileRecorder_H
+
+#include "ControlRecorder.hpp"
+
+#include <vector>
+
+/** Stream the recorded rows to a binary file. The rows are gathered in
+ *  a buffer of a few rows, and the full buffers are written by a
+ *  background thread while the simulation goes on, so the memory used
+ *  does not depend on the length of the simulation.
+ *
+ *  The file contains the rows one after the other, as doubles in the
+ *  native byte order, without header: with numpy it can be read by
+ *  numpy.fromfile(filename).reshape(-1, ncolumns), the columns being
+ *  described by ControlSimulation::dataLegend().
+ */
+class BinaryFileRecorder : public ControlRecorder
+{
+private:
+
+  ACCEPT_SERIALIZATION(BinaryFileRecorder);
+
+  /** the file and the writing thread */
+  struct _Writer;
+
+  /** the writing thread, while the recording is open */
+  std::shared_ptr<_Writer> _writer;
+
+protected:
+
+  /** name of the file */
+  std::string _filename;
+
+  /** number of rows in a buffer */
+  unsigned _bufferRows;
+
+  /** the rows not handed to the writing thread yet */
+  std::vector<double> _filling;
+
+  /** default constructor */
+  BinaryFileRecorder(): _bufferRows(0) {};
+
+  void prepare(unsigned estimatedRows) override;
+
+  void write(const SiconosVector& row) override;
+
+  void flush() override;
+
+public:
+
+  /** Constructor
+   * \param filename the name of the file, replaced if it exists
+   * \param bufferRows the number of rows written at once
+   */
+  BinaryFileRecorder(const std::string& filename, unsigned bufferRows = 1024);
+
+  /** destructor, close the file if the recording was not closed */
+  ~BinaryFileRecorder();
+
+  /** \return the name of the file */
+  inline const std::string& filename() const
+  {
+    return _filename;
+  };
+};
+
+#endif
@@ -0,0 +1,179 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "SimpleMatrix.hpp"
+#include "SiconosVector.hpp"
+#include "SiconosException.hpp"
+
+#include "ControlSimulation.hpp"
+#include "RingBufferRecorder.hpp"
+#include "ControlEnsemble.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+ControlEnsemble::ControlEnsemble(const Builder& builder, unsigned size):
+  _builder(builder), _size(size), _threads(0), _keep(size, false), _elapsedTime(0.0)
+{
+}
+
+void ControlEnsemble::keepTrajectory(unsigned i)
+{
+  if(i >= _size)
+  {
+    THROW_EXCEPTION("ControlEnsemble::keepTrajectory - no instance with this index");
+  }
+  _keep[i] = true;
+}
+
+void ControlEnsemble::run()
+{
+  std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
+
+  std::vector<SP::SiconosVector> last(_size);
+  _trajectories.assign(_size, SP::SimpleMatrix());
+  _dataLegend.clear();
+
+  std::atomic<unsigned> next(0);
+  std::mutex mutex;
+  std::exception_ptr error;
+
+  auto worker = [&]()
+  {
+    for(unsigned i = next++; i < _size; i = next++)
+    {
+      try
+      {
+        SP::ControlSimulation sim;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if(error)
+            return;
+          sim = _builder(i);
+        }
+        if(!sim->recorder() && !_keep[i])
+          sim->setRecorder(SP::ControlRecorder(new RingBufferRecorder(1)));
+        sim->silent();
+        sim->initialize();
+        sim->run();
+
+        SP::SimpleMatrix data = sim->data();
+        if(!data || data->size(0) == 0)
+        {
+          THROW_EXCEPTION("ControlEnsemble::run - the recorder of an instance does not keep its data");
+        }
+        last[i].reset(new SiconosVector(data->size(1)));
+        data->getRow(data->size(0) - 1, *last[i]);
+        if(_keep[i])
+          _trajectories[i] = data;
+
+        bool sameSignals = true;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if(_dataLegend.empty())
+            _dataLegend = sim->dataLegend();
+          else
+            sameSignals = _dataLegend == sim->dataLegend();
+        }
+        if(!sameSignals)
+        {
+          THROW_EXCEPTION("ControlEnsemble::run - the instances do not record the same signals");
+        }
+      }
+      catch(...)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!error)
+          error = std::current_exception();
+        return;
+      }
+    }
+  };
+
+  unsigned nThreads = _threads > 0 ? _threads : std::thread::hardware_concurrency();
+  if(nThreads == 0)
+    nThreads = 1;
+  if(nThreads > _size)
+    nThreads = _size;
+  std::vector<std::thread> pool;
+  for(unsigned t = 1; t < nThreads; ++t)
+    pool.push_back(std::thread(worker));
+  // the calling thread works too
+  worker();
+  for(std::thread& thread : pool)
+    thread.join();
+
+  if(error)
+    std::rethrow_exception(error);
+
+  _final.reset();
+  if(_size > 0)
+  {
+    _final.reset(new SimpleMatrix(_size, last[0]->size()));
+    for(unsigned i = 0; i < _size; ++i)
+      _final->setRow(i, *last[i]);
+  }
+
+  std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
+  std::chrono::duration<double, std::milli> fp_s = end - start;
+  _elapsedTime = fp_s.count();
+}
+
+SP::SimpleMatrix ControlEnsemble::trajectory(unsigned i) const
+{
+  if(i >= _trajectories.size())
+    return SP::SimpleMatrix();
+  return _trajectories[i];
+}
+
+SP::SiconosVector ControlEnsemble::mean() const
+{
+  if(!_final)
+    return SP::SiconosVector();
+  unsigned n = _final->size(0);
+  unsigned m = _final->size(1);
+  SP::SiconosVector mean(new SiconosVector(m, 0));
+  for(unsigned i = 0; i < n; ++i)
+    for(unsigned j = 0; j < m; ++j)
+      (*mean)(j) += (*_final)(i, j);
+  *mean *= 1.0 / n;
+  return mean;
+}
+
+SP::SiconosVector ControlEnsemble::standardDeviation() const
+{
+  SP::SiconosVector mean = this->mean();
+  if(!mean)
+    return mean;
+  unsigned n = _final->size(0);
+  unsigned m = _final->size(1);
+  SP::SiconosVector sd(new SiconosVector(m, 0));
+  for(unsigned i = 0; i < n; ++i)
+    for(unsigned j = 0; j < m; ++j)
+    {
+      double d = (*_final)(i, j) - (*mean)(j);
+      (*sd)(j) += d * d;
+    }
+  for(unsigned j = 0; j < m; ++j)
+    (*sd)(j) = std::sqrt((*sd)(j) / n);
+  return sd;
+}
@@ -0,0 +1,170 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file ControlEnsemble.hpp
+  \brief Run many instances of a control simulation on several threads
+*/
+
+#ifndef ControlEnsemble_H
+#define ControlEnsemble_H
+
+#include "SiconosPointers.hpp"
+#include "SiconosAlgebraTypeDef.hpp"
+#include "SiconosControlFwd.hpp"
+#include "SiconosFwd.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/** Run N instances of a control simulation, for instance with perturbed
+ *  gains or initial states, on a pool of threads.
+ *
+ *  The instances are created by a user function which builds a new
+ *  ControlSimulation, with its own dynamical systems, sensors and
+ *  actuators, for a given instance index. The calls to this function
+ *  are serialized, the initializations and the runs are concurrent.
+ *
+ *  For each instance, the last recorded row (time and signals) is kept,
+ *  and the whole recording for the instances selected with
+ *  keepTrajectory(). The instances which are not kept are recorded with
+ *  a RingBufferRecorder of one row unless they have a recorder.
+ *
+ *  The integrations with LsodarOSI are serialized, since ODEPACK works
+ *  in global memory: the ControlZOHSimulation instances with
+ *  ZeroOrderHoldOSI::setClosedForm scale better.
+ */
+class ControlEnsemble
+{
+private:
+
+  ACCEPT_SERIALIZATION(ControlEnsemble);
+
+public:
+
+  /** function building the instance of the given index */
+  typedef std::function<SP::ControlSimulation(unsigned)> Builder;
+
+protected:
+
+  /** builds the instances */
+  Builder _builder;
+
+  /** number of instances */
+  unsigned _size;
+
+  /** number of threads, 0 to use one thread per core */
+  unsigned _threads;
+
+  /** indicates the instances for which all the rows are kept */
+  std::vector<bool> _keep;
+
+  /** last recorded row of each instance */
+  SP::SimpleMatrix _final;
+
+  /** recorded rows of the kept instances */
+  std::vector<SP::SimpleMatrix> _trajectories;
+
+  /** legend of the columns */
+  std::string _dataLegend;
+
+  /** Time spent computing */
+  double _elapsedTime;
+
+  /** default constructor */
+  ControlEnsemble(): _size(0), _threads(0), _elapsedTime(0.0) {};
+
+public:
+
+  /** Constructor
+   * \param builder the function building the instance of an index
+   * \param size the number of instances
+   */
+  ControlEnsemble(const Builder& builder, unsigned size);
+
+  /** destructor */
+  virtual ~ControlEnsemble() {};
+
+  /** Set the number of threads
+   * \param threads the number of threads, 0 to use one thread per core
+   */
+  inline void setThreads(unsigned threads)
+  {
+    _threads = threads;
+  };
+
+  /** \return the number of threads, 0 for one thread per core */
+  inline unsigned threads() const
+  {
+    return _threads;
+  };
+
+  /** keep all the recorded rows of an instance
+   * \param i the index of the instance
+   */
+  void keepTrajectory(unsigned i);
+
+  /** create and run all the instances */
+  void run();
+
+  /** \return the number of instances */
+  inline unsigned size() const
+  {
+    return _size;
+  };
+
+  /** Return the last recorded rows
+   * \return a matrix with the last row of the instance i in row i
+   */
+  inline SP::SimpleMatrix finalStates() const
+  {
+    return _final;
+  };
+
+  /** Return the recorded rows of an instance
+   * \param i the index of the instance
+   * \return the data matrix of the instance, or a null pointer if it
+   * was not kept
+   */
+  SP::SimpleMatrix trajectory(unsigned i) const;
+
+  /** \return the mean over the instances of the last recorded rows */
+  SP::SiconosVector mean() const;
+
+  /** \return the standard deviation over the instances of the last
+   *  recorded rows */
+  SP::SiconosVector standardDeviation() const;
+
+  /** get the legend of the columns
+   * \return legend as string of space seperated values
+   */
+  inline const std::string& dataLegend() const
+  {
+    return _dataLegend;
+  };
+
+  /**
+     \return the elapsed time computing in milliseconds
+  */
+  inline double elapsedTime() const
+  {
+    return _elapsedTime;
+  };
+};
+
+#endif
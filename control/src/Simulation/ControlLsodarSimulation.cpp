@@ -53,7 +53,6 @@ ControlLsodarSimulation::ControlLsodarSimulation(double t0, double T, double h):
 void ControlLsodarSimulation::run()
 {
   EventsManager& eventsManager = *_processSimulation->eventsManager();
-  unsigned k = 0;
   std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
   EventDriven& sim = static_cast<EventDriven&>(*_processSimulation);
 
@@ -72,19 +71,15 @@ void ControlLsodarSimulation::run()
     }
     if(sim.hasNextEvent() && eventsManager.nextEvent()->getType() == TD_EVENT)  // We store only on TD_EVENT, this should be settable
     {
-      (*_dataM)(k, 0) = sim.startingTime();
-      storeData(k);
-      ++k;
+      storeData(sim.startingTime());
     }
   }
 
   /* saves last status */
-  (*_dataM)(k, 0) = sim.startingTime();
-  storeData(k);
-  ++k;
+  storeData(sim.startingTime(), true);
 
   std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
   std::chrono::duration<double, std::milli> fp_s = end - start;
   _elapsedTime = fp_s.count();
-  _dataM->resize(k, _nDim + 1);
+  _recorder->close();
 }
@@ -0,0 +1,43 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "SiconosException.hpp"
+#include "ControlRecorder.hpp"
+
+void ControlRecorder::setDecimation(unsigned d)
+{
+  if(d == 0)
+  {
+    THROW_EXCEPTION("ControlRecorder::setDecimation - the decimation factor must be at least 1");
+  }
+  _decimation = d;
+}
+
+void ControlRecorder::open(unsigned nColumns, const std::string& legend, unsigned estimatedRows)
+{
+  _nColumns = nColumns;
+  _legend = legend;
+  _count = 0;
+  _rows = 0;
+  prepare(_decimation > 1 ? estimatedRows / _decimation + 1 : estimatedRows);
+}
+
+void ControlRecorder::close()
+{
+  flush();
+}
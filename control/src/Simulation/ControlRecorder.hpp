@@ -0,0 +1,172 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file ControlRecorder.hpp
+  \brief Base class for the recording of the data of a ControlSimulation
+*/
+
+#ifndef ControlRecorder_H
+#define ControlRecorder_H
+
+#include "SiconosPointers.hpp"
+#include "SiconosAlgebraTypeDef.hpp"
+#include "SiconosControlFwd.hpp"
+#include "SiconosFwd.hpp"
+
+#include <string>
+
+/** Base class for the objects receiving the data of a ControlSimulation.
+ *
+ *  The simulation sends one row per recorded time instant: the time
+ *  followed by the selected signals, in the order given by the legend.
+ *  Only one row out of decimation() is kept, the last row of a run
+ *  is always kept.
+ */
+class ControlRecorder
+{
+private:
+
+  ACCEPT_SERIALIZATION(ControlRecorder);
+
+protected:
+
+  /** keep one row out of _decimation */
+  unsigned _decimation;
+
+  /** signals to record, see Signal */
+  unsigned _signals;
+
+  /** number of columns of a row */
+  unsigned _nColumns;
+
+  /** legend of the columns */
+  std::string _legend;
+
+  /** number of rows received since open() */
+  unsigned long _count;
+
+  /** number of rows kept since open() */
+  unsigned long _rows;
+
+  /** default constructor */
+  ControlRecorder(): _decimation(1), _signals(DEFAULT), _nColumns(0), _count(0), _rows(0) {};
+
+  /** prepare the storage of the rows
+   * \param estimatedRows a rough estimation of the number of rows
+   */
+  virtual void prepare(unsigned estimatedRows) {};
+
+  /** store a row
+   * \param row the time and the signals
+   */
+  virtual void write(const SiconosVector& row) = 0;
+
+  /** store the rows not written yet */
+  virtual void flush() {};
+
+public:
+
+  /** signals which can be recorded */
+  enum Signal
+  {
+    /** the state x of the dynamical systems */
+    STATE = 1,
+    /** the control input u and the perturbation e of the dynamical systems */
+    INPUT = 2,
+    /** the output y and the multiplier lambda of the interactions */
+    INTERACTION = 4,
+    /** the output of the control sensors */
+    SENSOR = 8,
+    /** the signals recorded by default */
+    DEFAULT = STATE | INPUT | INTERACTION,
+    ALL = STATE | INPUT | INTERACTION | SENSOR
+  };
+
+  /** destructor */
+  virtual ~ControlRecorder() {};
+
+  /** keep only one row out of d
+   * \param d the decimation factor, at least 1
+   */
+  void setDecimation(unsigned d);
+
+  /** \return the decimation factor */
+  inline unsigned decimation() const
+  {
+    return _decimation;
+  };
+
+  /** select the signals to record
+   * \param signals a combination of Signal values
+   */
+  inline void setSignals(unsigned signals)
+  {
+    _signals = signals;
+  };
+
+  /** \return the recorded signals */
+  inline unsigned signals() const
+  {
+    return _signals;
+  };
+
+  /** start a new recording
+   * \param nColumns the size of a row
+   * \param legend the legend of the columns
+   * \param estimatedRows a rough estimation of the number of rows
+   */
+  void open(unsigned nColumns, const std::string& legend, unsigned estimatedRows);
+
+  /** record a row, if it is not removed by the decimation
+   * \param row the time and the signals
+   * \param keep true to keep the row whatever the decimation
+   */
+  inline void record(const SiconosVector& row, bool keep = false)
+  {
+    if(keep || _count % _decimation == 0)
+    {
+      write(row);
+      ++_rows;
+    }
+    ++_count;
+  };
+
+  /** end the recording */
+  void close();
+
+  /** \return the number of rows kept since the start of the recording */
+  inline unsigned long rows() const
+  {
+    return _rows;
+  };
+
+  /** \return the legend of the columns */
+  inline const std::string& legend() const
+  {
+    return _legend;
+  };
+
+  /** \return the recorded rows as a matrix, or a null pointer if
+   *  the recorder does not keep them in memory */
+  virtual SP::SimpleMatrix data() const
+  {
+    return SP::SimpleMatrix();
+  };
+};
+
+#endif
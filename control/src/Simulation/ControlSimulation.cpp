@@ -26,6 +26,8 @@
 #include "Observer.hpp"
 #include "ControlSimulation.hpp"
 #include "ControlSimulation_impl.hpp"
+#include "ControlSensor.hpp"
+#include "MatrixRecorder.hpp"
 
 ControlSimulation::ControlSimulation(double t0, double T, double h):
   _t0(t0), _T(T), _h(h), _theta(0.5), _elapsedTime(0.0), _N(0), _saveOnlyMainSimulation(false), _silent(false)
@@ -48,10 +50,13 @@ void ControlSimulation::initialize()
   _CM->initialize(*_nsds);
 
   // Output
+  if(!_recorder)
+    _recorder.reset(new MatrixRecorder());
+  unsigned signals = _recorder->signals();
   _N = (unsigned)ceil((_T - _t0) / _h) + 10; // Number of time steps
   DynamicalSystemsGraph& DSG0 = *_nsds->topology()->dSG(0);
   InteractionsGraph& IG0 = *_nsds->topology()->indexSet0();
-  res = getNumberOfStates(DSG0, IG0);
+  res = getNumberOfStates(DSG0, IG0, signals);
   _nDim = res.first;
   _dataLegend += res.second;
   if(!_saveOnlyMainSimulation)
@@ -63,7 +68,7 @@ void ControlSimulation::initialize()
       if((*it)->getInternalNSDS())
       {
         Topology& topo = *(*it)->getInternalNSDS()->topology();
-        res = getNumberOfStates(*topo.dSG(0), *topo.indexSet0());
+        res = getNumberOfStates(*topo.dSG(0), *topo.indexSet0(), signals);
         _nDim += res.first;
         _dataLegend += res.second;
       }
@@ -74,13 +79,36 @@ void ControlSimulation::initialize()
       if((*it)->getInternalNSDS())
       {
         Topology& topo = *(*it)->getInternalNSDS()->topology();
-        res = getNumberOfStates(*topo.dSG(0), *topo.indexSet0());
+        res = getNumberOfStates(*topo.dSG(0), *topo.indexSet0(), signals);
         _nDim += res.first;
         _dataLegend += res.second;
       }
     }
   }
-  _dataM.reset(new SimpleMatrix(_N, _nDim + 1)); // we save the system state
+  if(signals & ControlRecorder::SENSOR)
+  {
+    const Sensors& allSensors = _CM->getSensors();
+    unsigned counter = 0;
+    for(SensorsIterator it = allSensors.begin(); it != allSensors.end(); ++it)
+    {
+      SP::ControlSensor sensor = std::dynamic_pointer_cast<ControlSensor>(*it);
+      if(sensor)
+      {
+        std::string name = sensor->getId();
+        if(name.empty())
+        {
+          name = "unknownSensor" + std::to_string(counter);
+          ++counter;
+        }
+        unsigned sizeY = sensor->getYDim();
+        for(unsigned i = 0; i < sizeY; ++i)
+          _dataLegend += " " + name + "_y_" + std::to_string(i);
+        _nDim += sizeY;
+      }
+    }
+  }
+  _row.reset(new SiconosVector(_nDim + 1));
+  _recorder->open(_nDim + 1, _dataLegend, _N); // we save the system state
 }
 
 void ControlSimulation::setTheta(unsigned int newTheta)
@@ -132,10 +160,12 @@ void ControlSimulation::addObserver(SP::Observer observer, const double h)
   _CM->addObserverPtr(observer, td);
 }
 
-void ControlSimulation::storeData(unsigned indx)
+void ControlSimulation::storeData(double time, bool keep)
 {
+  unsigned signals = _recorder->signals();
   unsigned startingColumn = 1;
-  startingColumn = storeAllStates(indx, startingColumn, *_DSG0, *_IG0, *_dataM);
+  (*_row)(0) = time;
+  startingColumn = storeAllStates(startingColumn, *_DSG0, *_IG0, signals, *_row);
 
   if(!_saveOnlyMainSimulation)
   {
@@ -146,7 +176,7 @@ void ControlSimulation::storeData(unsigned indx)
       if((*it)->getInternalNSDS())
       {
         Topology& topo = *(*it)->getInternalNSDS()->topology();
-        startingColumn = storeAllStates(indx, startingColumn, *topo.dSG(0), *topo.indexSet0(), *_dataM);
+        startingColumn = storeAllStates(startingColumn, *topo.dSG(0), *topo.indexSet0(), signals, *_row);
       }
     }
     const Observers& allObservers = _CM->getObservers();
@@ -155,10 +185,19 @@ void ControlSimulation::storeData(unsigned indx)
       if((*it)->getInternalNSDS())
       {
         Topology& topo = *(*it)->getInternalNSDS()->topology();
-        startingColumn = storeAllStates(indx, startingColumn, *topo.dSG(0), *topo.indexSet0(), *_dataM);
+        startingColumn = storeAllStates(startingColumn, *topo.dSG(0), *topo.indexSet0(), signals, *_row);
       }
     }
   }
+  if(signals & ControlRecorder::SENSOR)
+  {
+    const Sensors& allSensors = _CM->getSensors();
+    for(SensorsIterator it = allSensors.begin(); it != allSensors.end(); ++it)
+    {
+      SP::ControlSensor sensor = std::dynamic_pointer_cast<ControlSensor>(*it);
+      if(sensor)
+        storeVector(sensor->y(), startingColumn, *_row);
+    }
+  }
+  _recorder->record(*_row, keep);
 }
-
-
@@ -28,6 +28,7 @@
 #include "ControlTypeDef.hpp"
 #include "SiconosControlFwd.hpp"
 #include "SiconosFwd.hpp"
+#include "ControlRecorder.hpp"
 
 #include <string>
 
@@ -75,10 +76,13 @@ protected:
   /** If true, do not show progress of the simulation */
   bool _silent;
 
-  /** Matrix for saving result */
-  SP::SimpleMatrix _dataM;
+  /** The recorder of the data */
+  SP::ControlRecorder _recorder;
 
-  /** Legend for the columns in the matrix _dataM*/
+  /** The row sent to the recorder */
+  SP::SiconosVector _row;
+
+  /** Legend for the columns of the recorded data */
   std::string _dataLegend;
 
   /** NonSmoothDynamicalSystem */
@@ -139,10 +143,28 @@ public:
    */
   void addObserver(SP::Observer observer, const double h);
 
-  /** store the simulation data in a row of the matrix
-   * \param indx the current row index
+  /** send the simulation data to the recorder
+   * \param time the current time
+   * \param keep true to keep this data whatever the decimation of the recorder
+   */
+  void storeData(double time, bool keep = false);
+
+  /** Set the recorder of the data, a MatrixRecorder is used by default.
+   *  Must be called before the initialization.
+   * \param recorder the recorder
    */
-  void storeData(unsigned indx);
+  inline void setRecorder(SP::ControlRecorder recorder)
+  {
+    _recorder = recorder;
+  };
+
+  /** Return the recorder of the data
+   * \return the recorder
+   */
+  inline SP::ControlRecorder recorder() const
+  {
+    return _recorder;
+  };
 
   /** Return the Simulation
    * \return the simulation for the main simulation
@@ -169,11 +191,12 @@ public:
   }
 
   /** Return the data matrix
-   * \return the data matrix
+   * \return the data matrix, or a null pointer if the recorder does
+   * not keep the data in memory
    */
   inline SP::SimpleMatrix data() const
   {
-    return _dataM;
+    return _recorder ? _recorder->data() : SP::SimpleMatrix();
   }
 
   /** get the legend for the matrix
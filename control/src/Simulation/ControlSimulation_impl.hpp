@@ -26,11 +26,18 @@
 #include <utility>
 
 #include "SimulationTypeDef.hpp"
+#include "ControlRecorder.hpp"
 
 #include <SiconosConfig.h>
 #define TO_STR(x) std::to_string(x)
 
-static inline std::pair<unsigned, std::string> getNumberOfStates(DynamicalSystemsGraph& DSG0, InteractionsGraph& IG0)
+/** count the signals of the graphs selected by a mask
+ * \param DSG0 the graph of DynamicalSystem
+ * \param IG0 the graph of Interaction
+ * \param signals a combination of ControlRecorder::Signal values
+ * \return the number of values and their legend
+ */
+static inline std::pair<unsigned, std::string> getNumberOfStates(DynamicalSystemsGraph& DSG0, InteractionsGraph& IG0, unsigned signals)
 {
   std::string legend;
   DynamicalSystemsGraph::VIterator dsvi, dsvdend;
@@ -38,9 +45,6 @@ static inline std::pair<unsigned, std::string> getNumberOfStates(DynamicalSystem
   unsigned counter = 0;
   for (std::tie(dsvi, dsvdend) = DSG0.vertices(); dsvi != dsvdend; ++dsvi)
   {
-    SiconosVector& x = *DSG0.bundle(*dsvi)->x();
-    nb += x.size();
-
     std::string nameDS;
     if (DSG0.name.hasKey(*dsvi)) {
       nameDS = DSG0.name[*dsvi];
@@ -49,10 +53,17 @@ static inline std::pair<unsigned, std::string> getNumberOfStates(DynamicalSystem
       ++counter;
     }
 
-    for (unsigned i = 0; i < x.size(); ++i) {
-      legend.append(" " + nameDS + "_" + TO_STR(i));
+    if (signals & ControlRecorder::STATE) {
+      SiconosVector& x = *DSG0.bundle(*dsvi)->x();
+      nb += x.size();
+      for (unsigned i = 0; i < x.size(); ++i) {
+        legend.append(" " + nameDS + "_" + TO_STR(i));
+      }
     }
 
+    if (!(signals & ControlRecorder::INPUT))
+      continue;
+
     if (DSG0.u.hasKey(*dsvi)) {
       unsigned sizeU = DSG0.u[*dsvi]->size();
       nb += sizeU;
@@ -70,6 +81,9 @@ static inline std::pair<unsigned, std::string> getNumberOfStates(DynamicalSystem
     }
   }
 
+  if (!(signals & ControlRecorder::INTERACTION))
+    return std::make_pair(nb, legend);
+
   InteractionsGraph::VIterator ivi, ivdend;
   counter = 0;
   for (std::tie(ivi, ivdend) = IG0.vertices(); ivi != ivdend; ++ivi)
@@ -102,67 +116,54 @@ static inline std::pair<unsigned, std::string> getNumberOfStates(DynamicalSystem
   return std::make_pair(nb, legend);
 }
 
-/** store all the states of the graph in a matrix
- * \param indx row index in the matrix
+/** copy a vector in a row
+ * \param v the vector
+ * \param column the first column, moved after the copied values
+ * \param row the row
+ */
+static inline void storeVector(const SiconosVector& v, unsigned& column, SiconosVector& row)
+{
+  for (unsigned j = 0; j < v.size(); ++j, ++column)
+  {
+    row(column) = v(j);
+  }
+}
+
+/** store the signals of the graphs selected by a mask in a row
  * \param startColumn the starting column
  * \param DSG0 the graph of DynamicalSystem
  * \param IG0 the graph of Interaction
- * \param data the matrix where to save the data
+ * \param signals a combination of ControlRecorder::Signal values
+ * \param row the row where to save the data
  * \return the last written column
  */
-static inline unsigned storeAllStates(unsigned indx, unsigned startColumn, DynamicalSystemsGraph& DSG0, InteractionsGraph& IG0, SimpleMatrix& data)
+static inline unsigned storeAllStates(unsigned startColumn, DynamicalSystemsGraph& DSG0, InteractionsGraph& IG0, unsigned signals, SiconosVector& row)
 {
   DynamicalSystemsGraph::VIterator dsvi, dsvdend;
   unsigned column = startColumn;
   for (std::tie(dsvi, dsvdend) = DSG0.vertices(); dsvi != dsvdend; ++dsvi)
   {
-    unsigned i = column;
-    SiconosVector& x = *DSG0.bundle(*dsvi)->x();
-    for (unsigned j = 0; j < x.size(); ++i, ++j)
-    {
-      data(indx, i) = x(j);
-    }
-    column += x.size();
+    if (signals & ControlRecorder::STATE)
+      storeVector(*DSG0.bundle(*dsvi)->x(), column, row);
+
+    if (!(signals & ControlRecorder::INPUT))
+      continue;
 
     if (DSG0.u.hasKey(*dsvi))
-    {
-      SiconosVector& u = *DSG0.u[*dsvi];
-      for (unsigned j = 0; j < u.size(); ++i, ++j)
-      {
-        data(indx, i) = u(j);
-      }
-      column += u.size();
-    }
+      storeVector(*DSG0.u[*dsvi], column, row);
 
     if (DSG0.e.hasKey(*dsvi))
-    {
-      SiconosVector& e = *DSG0.e[*dsvi];
-      for (unsigned j = 0; j < e.size(); ++i, ++j)
-      {
-        data(indx, i) = e(j);
-      }
-      column += e.size();
-    }
-
+      storeVector(*DSG0.e[*dsvi], column, row);
   }
 
+  if (!(signals & ControlRecorder::INTERACTION))
+    return column;
+
   InteractionsGraph::VIterator ivi, ivdend;
   for (std::tie(ivi, ivdend) = IG0.vertices(); ivi != ivdend; ++ivi)
   {
-    unsigned i = column;
-    SiconosVector& y = *IG0.bundle(*ivi)->y(0);
-    for (unsigned j = 0; j < y.size(); ++i, ++j)
-    {
-      data(indx, i) = y(j);
-    }
-    column += y.size();
-
-    SiconosVector& lambda = *IG0.bundle(*ivi)->lambda(0);
-    for (unsigned j = 0; j < lambda.size(); ++i, ++j)
-    {
-      data(indx, i) = lambda(j);
-    }
-    column += lambda.size();
+    storeVector(*IG0.bundle(*ivi)->y(0), column, row);
+    storeVector(*IG0.bundle(*ivi)->lambda(0), column, row);
   }
 
   return column;
@@ -57,7 +57,6 @@ void ControlZOHSimulation::run()
 {
   DEBUG_BEGIN("void ControlZOHSimulation::run()\n");
   EventsManager& eventsManager = *_processSimulation->eventsManager();
-  unsigned k = 0;
   std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
 
   TimeStepping& sim = static_cast<TimeStepping&>(*_processSimulation);
@@ -74,21 +73,17 @@ void ControlZOHSimulation::run()
 
     if(sim.hasNextEvent() && eventsManager.nextEvent()->getType() == TD_EVENT)   // We store only on TD_EVENT
     {
-      (*_dataM)(k, 0) = sim.startingTime();
-      storeData(k);
-      ++k;
+      storeData(sim.startingTime());
     }
   }
 
   /* saves last status */
-  (*_dataM)(k, 0) = sim.startingTime();
-  storeData(k);
-  ++k;
+  storeData(sim.startingTime(), true);
 
   std::chrono::system_clock::time_point end = std::chrono::system_clock::now();
   std::chrono::duration<double, std::milli> fp_s = end - start;
   _elapsedTime = fp_s.count();
 
-  _dataM->resize(k, _nDim + 1);
+  _recorder->close();
   DEBUG_END("void ControlZOHSimulation::run()\n");
 }
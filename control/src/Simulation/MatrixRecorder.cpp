@@ -0,0 +1,38 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "SimpleMatrix.hpp"
+#include "SiconosVector.hpp"
+#include "MatrixRecorder.hpp"
+
+void MatrixRecorder::prepare(unsigned estimatedRows)
+{
+  _data.reset(new SimpleMatrix(estimatedRows > 0 ? estimatedRows : 1, _nColumns));
+}
+
+void MatrixRecorder::write(const SiconosVector& row)
+{
+  if(_rows == _data->size(0))
+    _data->resize(2 * _rows, _nColumns);
+  _data->setRow(_rows, row);
+}
+
+void MatrixRecorder::flush()
+{
+  _data->resize(_rows, _nColumns);
+}
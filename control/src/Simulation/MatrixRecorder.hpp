@@ -0,0 +1,61 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file MatrixRecorder.hpp
+  \brief Recording of all the rows of a ControlSimulation in a matrix
+*/
+
+#ifndef MatrixRecorder_H
+#define MatrixRecorder_H
+
+#include "ControlRecorder.hpp"
+
+/** Keep all the recorded rows in a SimpleMatrix, this is the default
+ *  recorder of a ControlSimulation. The matrix is allocated with the
+ *  estimated number of rows, it grows if needed and it is resized to
+ *  the number of recorded rows at the end of the recording.
+ */
+class MatrixRecorder : public ControlRecorder
+{
+private:
+
+  ACCEPT_SERIALIZATION(MatrixRecorder);
+
+protected:
+
+  /** the recorded rows */
+  SP::SimpleMatrix _data;
+
+  void prepare(unsigned estimatedRows) override;
+
+  void write(const SiconosVector& row) override;
+
+  void flush() override;
+
+public:
+
+  /** default constructor */
+  MatrixRecorder() {};
+
+  SP::SimpleMatrix data() const override
+  {
+    return _data;
+  };
+};
+
+#endif
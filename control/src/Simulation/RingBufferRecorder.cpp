@@ -0,0 +1,53 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "SimpleMatrix.hpp"
+#include "SiconosVector.hpp"
+#include "SiconosException.hpp"
+#include "RingBufferRecorder.hpp"
+
+RingBufferRecorder::RingBufferRecorder(unsigned capacity): _capacity(capacity)
+{
+  if(capacity == 0)
+  {
+    THROW_EXCEPTION("RingBufferRecorder - the capacity must be at least 1");
+  }
+}
+
+void RingBufferRecorder::prepare(unsigned estimatedRows)
+{
+  _buffer.reset(new SimpleMatrix(_capacity, _nColumns));
+}
+
+void RingBufferRecorder::write(const SiconosVector& row)
+{
+  _buffer->setRow(_rows % _capacity, row);
+}
+
+SP::SimpleMatrix RingBufferRecorder::data() const
+{
+  if(!_buffer)
+    return SP::SimpleMatrix();
+  unsigned n = _rows < _capacity ? _rows : _capacity;
+  unsigned first = _rows < _capacity ? 0 : _rows % _capacity;
+  SP::SimpleMatrix last(new SimpleMatrix(n, _nColumns));
+  for(unsigned i = 0; i < n; ++i)
+    for(unsigned j = 0; j < _nColumns; ++j)
+      (*last)(i, j) = (*_buffer)((first + i) % _capacity, j);
+  return last;
+}
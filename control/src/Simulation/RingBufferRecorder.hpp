@@ -0,0 +1,70 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file RingBufferRecorder.hpp
+  \brief Recording of the last rows of a ControlSimulation
+*/
+
+#ifndef RingBufferRecorder_H
+#define RingBufferRecorder_H
+
+#include "ControlRecorder.hpp"
+
+/** Keep only the last recorded rows, in a matrix with a fixed number
+ *  of rows used as a circular buffer. The memory used does not depend
+ *  on the length of the simulation.
+ */
+class RingBufferRecorder : public ControlRecorder
+{
+private:
+
+  ACCEPT_SERIALIZATION(RingBufferRecorder);
+
+protected:
+
+  /** maximum number of rows kept */
+  unsigned _capacity;
+
+  /** the circular buffer */
+  SP::SimpleMatrix _buffer;
+
+  /** default constructor */
+  RingBufferRecorder(): _capacity(0) {};
+
+  void prepare(unsigned estimatedRows) override;
+
+  void write(const SiconosVector& row) override;
+
+public:
+
+  /** Constructor
+   * \param capacity the number of rows to keep
+   */
+  RingBufferRecorder(unsigned capacity);
+
+  /** \return the number of rows to keep */
+  inline unsigned capacity() const
+  {
+    return _capacity;
+  };
+
+  /** \return the last recorded rows, the oldest one first */
+  SP::SimpleMatrix data() const override;
+};
+
+#endif
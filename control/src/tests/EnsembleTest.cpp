@@ -0,0 +1,117 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "EnsembleTest.hpp"
+#include "ControlZOHSimulation.hpp"
+#include "ControlLsodarSimulation.hpp"
+#include "ControlEnsemble.hpp"
+#include "ZeroOrderHoldOSI.hpp"
+#include "FirstOrderLinearTIDS.hpp"
+#include "LinearSensor.hpp"
+#include "PID.hpp"
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(EnsembleTest);
+
+
+void EnsembleTest::setUp()
+{}
+
+void EnsembleTest::tearDown()
+{}
+
+SP::ControlSimulation EnsembleTest::build(unsigned i, bool lsodar)
+{
+  // a PID controller with a proportional gain depending on i
+  SP::SimpleMatrix A(new SimpleMatrix(_n, _n, 0));
+  (*A)(0, 1) = 1.0;
+  SP::SiconosVector x0(new SiconosVector(_n, 0));
+  (*x0)(0) = 10.0;
+  SP::FirstOrderLinearTIDS ds(new FirstOrderLinearTIDS(x0, A));
+  SP::SimpleMatrix C(new SimpleMatrix(1, 2, 0));
+  (*C)(0, 0) = 1;
+  SP::LinearSensor sensor(new LinearSensor(ds, C));
+  SP::SimpleMatrix B(new SimpleMatrix(2, 1));
+  (*B)(1, 0) = 1;
+  SP::PID controller(new PID(sensor, B));
+  controller->setRef(0.);
+  SP::SiconosVector K(new SiconosVector(3, 0));
+  (*K)(0) = .25 + .05 * i;
+  (*K)(1) = .125;
+  (*K)(2) = 2.0;
+  controller->setK(K);
+  controller->setDeltaT(_h);
+
+  SP::ControlSimulation sim;
+  if(lsodar)
+    sim.reset(new ControlLsodarSimulation(_t0, _T, _h));
+  else
+  {
+    sim.reset(new ControlZOHSimulation(_t0, _T, _h));
+    std::static_pointer_cast<ZeroOrderHoldOSI>(sim->integrator())->setClosedForm(true);
+  }
+  sim->addDynamicalSystem(ds);
+  sim->addSensor(sensor, _h);
+  sim->addActuator(controller, _h);
+  return sim;
+}
+
+void EnsembleTest::check(bool lsodar)
+{
+  unsigned size = 6;
+  ControlEnsemble ensemble([this, lsodar](unsigned i) { return build(i, lsodar); }, size);
+  ensemble.setThreads(3);
+  ensemble.keepTrajectory(2);
+  ensemble.run();
+
+  SimpleMatrix& final = *ensemble.finalStates();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("check rows : ", final.size(0), size);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("check trajectory : ", !ensemble.trajectory(1), true);
+  SiconosVector mean(final.size(1), 0);
+  for(unsigned i = 0; i < size; ++i)
+  {
+    // same results as a run alone
+    SP::ControlSimulation sim = build(i, lsodar);
+    sim->silent();
+    sim->initialize();
+    sim->run();
+    SimpleMatrix& data = *sim->data();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("check legend : ", ensemble.dataLegend(), sim->dataLegend());
+    for(unsigned j = 0; j < data.size(1); ++j)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("check final state : ", final(i, j), data(data.size(0) - 1, j));
+      mean(j) += data(data.size(0) - 1, j) / size;
+    }
+    if(i == 2)
+    {
+      SimpleMatrix& trajectory = *ensemble.trajectory(2);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("check trajectory : ", (trajectory - data).normInf(), 0.);
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("check mean : ", (*ensemble.mean() - mean).normInf() < 1e-12, true);
+  std::cout << "ensemble of " << size << " runs in " << ensemble.elapsedTime() << " ms" << std::endl;
+}
+
+void EnsembleTest::testZOH()
+{
+  check(false);
+}
+
+void EnsembleTest::testLsodar()
+{
+  check(true);
+}
@@ -0,0 +1,61 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __EnsembleTest__
+#define __EnsembleTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <SiconosFwd.hpp>
+#include "SiconosControlFwd.hpp"
+
+class EnsembleTest : public CppUnit::TestFixture
+{
+
+private:
+  ACCEPT_SERIALIZATION(EnsembleTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(EnsembleTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testZOH);
+  CPPUNIT_TEST(testLsodar);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  SP::ControlSimulation build(unsigned i, bool lsodar);
+  void check(bool lsodar);
+  void testZOH();
+  void testLsodar();
+  // Members
+
+  unsigned int _n;
+  double _h;
+  double _t0;
+  double _T;
+
+public:
+
+  EnsembleTest(): _n(2), _h(0.05), _t0(0.0), _T(5.0) {}
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
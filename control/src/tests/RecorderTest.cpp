@@ -0,0 +1,141 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "RecorderTest.hpp"
+#include "ControlZOHSimulation.hpp"
+#include "MatrixRecorder.hpp"
+#include "RingBufferRecorder.hpp"
+#include "BinaryFileRecorder.hpp"
+#include "LinearSensor.hpp"
+#include "PID.hpp"
+
+#include <fstream>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(RecorderTest);
+
+
+void RecorderTest::setUp()
+{
+  // all the rows, with the default recorder
+  _ref = run(SP::ControlRecorder())->data();
+}
+
+void RecorderTest::tearDown()
+{}
+
+SP::ControlZOHSimulation RecorderTest::run(SP::ControlRecorder recorder)
+{
+  SP::SimpleMatrix A(new SimpleMatrix(_n, _n, 0));
+  (*A)(0, 1) = 1.0;
+  SP::SiconosVector x0(new SiconosVector(_n, 0));
+  (*x0)(0) = 10.0;
+  SP::FirstOrderLinearTIDS ds(new FirstOrderLinearTIDS(x0, A));
+  SP::SimpleMatrix C(new SimpleMatrix(1, 2, 0));
+  (*C)(0, 0) = 1;
+  SP::LinearSensor sensor(new LinearSensor(ds, C));
+  sensor->setId("position");
+  SP::SimpleMatrix B(new SimpleMatrix(2, 1));
+  (*B)(1, 0) = 1;
+  SP::PID controller(new PID(sensor, B));
+  controller->setRef(0.);
+  SP::SiconosVector K(new SiconosVector(3, 0));
+  (*K)(0) = .25;
+  (*K)(1) = .125;
+  (*K)(2) = 2.0;
+  controller->setK(K);
+  controller->setDeltaT(_h);
+
+  SP::ControlZOHSimulation sim(new ControlZOHSimulation(_t0, _T, _h));
+  sim->silent();
+  sim->addDynamicalSystem(ds);
+  sim->addSensor(sensor, _h);
+  sim->addActuator(controller, _h);
+  if(recorder)
+    sim->setRecorder(recorder);
+  sim->initialize();
+  sim->run();
+  return sim;
+}
+
+void RecorderTest::testDecimation()
+{
+  SP::MatrixRecorder recorder(new MatrixRecorder());
+  recorder->setDecimation(10);
+  SimpleMatrix& data = *run(recorder)->data();
+  unsigned last = _ref->size(0) - 1;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testDecimation rows : ", data.size(0), (last + 9) / 10 + 1);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testDecimation columns : ", data.size(1), _ref->size(1));
+  for(unsigned i = 0; i < data.size(0); ++i)
+  {
+    // the last row is always kept
+    unsigned k = i + 1 < data.size(0) ? 10 * i : last;
+    for(unsigned j = 0; j < data.size(1); ++j)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testDecimation : ", data(i, j), (*_ref)(k, j));
+  }
+}
+
+void RecorderTest::testRingBuffer()
+{
+  SP::RingBufferRecorder recorder(new RingBufferRecorder(7));
+  // a copy of the rows, in the chronological order
+  SP::SimpleMatrix rows = run(recorder)->data();
+  SimpleMatrix& data = *rows;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testRingBuffer rows : ", data.size(0), 7u);
+  unsigned first = _ref->size(0) - 7;
+  for(unsigned i = 0; i < data.size(0); ++i)
+    for(unsigned j = 0; j < data.size(1); ++j)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testRingBuffer : ", data(i, j), (*_ref)(first + i, j));
+}
+
+void RecorderTest::testBinaryFile()
+{
+  // a small buffer, so that the thread writes several times
+  SP::BinaryFileRecorder recorder(new BinaryFileRecorder("RecorderTest.bin", 16));
+  SP::ControlZOHSimulation sim = run(recorder);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBinaryFile data : ", !sim->data(), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBinaryFile rows : ", recorder->rows(), (unsigned long)_ref->size(0));
+
+  std::ifstream file("RecorderTest.bin", std::ios::binary);
+  std::vector<double> values(_ref->size(0) * _ref->size(1) + 1);
+  file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(double));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBinaryFile size : ", (std::size_t)file.gcount(), (values.size() - 1) * sizeof(double));
+  for(unsigned i = 0; i < _ref->size(0); ++i)
+    for(unsigned j = 0; j < _ref->size(1); ++j)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testBinaryFile : ", values[i * _ref->size(1) + j], (*_ref)(i, j));
+}
+
+void RecorderTest::testSignals()
+{
+  SP::MatrixRecorder recorder(new MatrixRecorder());
+  recorder->setSignals(ControlRecorder::STATE | ControlRecorder::SENSOR);
+  SP::ControlZOHSimulation sim = run(recorder);
+  SimpleMatrix& data = *sim->data();
+  std::cout << "legend: " << sim->dataLegend() << std::endl;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSignals legend : ", sim->dataLegend(), std::string("time unknownDS0_0 unknownDS0_1 position_y_0"));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSignals rows : ", data.size(0), _ref->size(0));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSignals columns : ", data.size(1), 4u);
+  for(unsigned i = 0; i < data.size(0); ++i)
+  {
+    // time and state are the first columns of the default recording
+    for(unsigned j = 0; j < 3; ++j)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testSignals : ", data(i, j), (*_ref)(i, j));
+  }
+  // the sensor measures the position at each time step
+  for(unsigned i = 0; i < data.size(0); ++i)
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testSignals sensor : ", data(i, 3), data(i, 1));
+}
@@ -0,0 +1,66 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __RecorderTest__
+#define __RecorderTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <SiconosFwd.hpp>
+#include "SiconosControlFwd.hpp"
+#include <FirstOrderLinearTIDS.hpp>
+
+class RecorderTest : public CppUnit::TestFixture
+{
+
+private:
+  ACCEPT_SERIALIZATION(RecorderTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(RecorderTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testDecimation);
+  CPPUNIT_TEST(testRingBuffer);
+  CPPUNIT_TEST(testBinaryFile);
+  CPPUNIT_TEST(testSignals);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  SP::ControlZOHSimulation run(SP::ControlRecorder recorder);
+  void testDecimation();
+  void testRingBuffer();
+  void testBinaryFile();
+  void testSignals();
+  // Members
+
+  unsigned int _n;
+  double _h;
+  double _t0;
+  double _T;
+  SP::SimpleMatrix _ref;
+
+public:
+
+  RecorderTest(): _n(2), _h(0.05), _t0(0.0), _T(5.0) {}
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
@@ -3,6 +3,10 @@
 
 %include ControlBase.i
 
+PY_FULL_REGISTER(ControlRecorder, Control);
+PY_FULL_REGISTER(MatrixRecorder, Control);
+PY_FULL_REGISTER(RingBufferRecorder, Control);
+PY_FULL_REGISTER(BinaryFileRecorder, Control);
 PY_FULL_REGISTER(ControlSimulation, Control);
 PY_FULL_REGISTER(ControlLsodarSimulation, Control);
 PY_FULL_REGISTER(ControlZOHSimulation, Control);
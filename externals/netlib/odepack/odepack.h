@@ -35,6 +35,8 @@ extern "C" {
 
   void CNAME(dlsodar)(fpointer, integer * neq, doublereal * y, doublereal *t, doublereal *tout, integer * itol, doublereal * rtol, doublereal *atol, integer * itask, integer *istate, integer * iopt, doublereal * rwork, integer * lrw, integer * iwork, integer * liw, jacopointer, integer * jt, gpointer, integer* ng, integer * jroot);
 
+  void CNAME(dsrcar)(doublereal * rsav, integer * isav, integer * job);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,10 +2,11 @@ include(tools4tests)
 
 if(WITH_TESTING)
   
+  begin_tests(src/test DEPS "CPPUNIT::CPPUNIT")
+  new_test(SOURCES StateTest.cpp ${SIMPLE_TEST_MAIN})
   
   if(WITH_SERIALIZATION)
     configure_file(${CMAKE_CURRENT_SOURCE_DIR}/src/test/result.ref src/test/result.ref COPYONLY)
-    begin_tests(src/test DEPS "CPPUNIT::CPPUNIT")
     new_test(SOURCES BasicTest.cpp ${SIMPLE_TEST_MAIN})
     new_test(SOURCES KernelTest.cpp ${SIMPLE_TEST_MAIN})
   endif()
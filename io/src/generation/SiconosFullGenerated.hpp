@@ -72,7 +72,10 @@ SICONOS_IO_REGISTER(MatrixIntegrator,
   (_E)
   (_OSI)
   (_TD)
+  (_closedForm)
+  (_closedFormCache)
   (_isConst)
+  (_k)
   (_mat)
   (_nsds)
   (_plugin)
@@ -523,6 +526,7 @@ SICONOS_IO_REGISTER_WITH_BASES(LinearOSNS,(OneStepNSProblem),
   (_w)
   (_z))
 SICONOS_IO_REGISTER_WITH_BASES(ZeroOrderHoldOSI,(OneStepIntegrator),
+  (_closedForm)
   (_useGammaForRelation))
 SICONOS_IO_REGISTER_WITH_BASES(Equality,(LinearOSNS),
 )
@@ -552,6 +556,7 @@ SICONOS_IO_REGISTER_WITH_BASES(TimeStepping,(Simulation),
   (_resetAllLambda)
   (_warnOnNonConvergence))
 SICONOS_IO_REGISTER(OneStepIntegrator,
+  (_deterministicInput)
   (_dynamicalSystemsGraph)
   (_explicitJacobiansOfRelation)
   (_extraAdditionalTerms)
@@ -561,6 +566,7 @@ SICONOS_IO_REGISTER(OneStepIntegrator,
   (_levelMaxForOutput)
   (_levelMinForInput)
   (_levelMinForOutput)
+  (_parallelInteractions)
   (_simulation)
   (_sizeMem)
   (_steps))
@@ -1000,7 +1006,6 @@ SICONOS_IO_REGISTER(ControlSimulation,
   (_N)
   (_T)
   (_dataLegend)
-  (_dataM)
   (_elapsedTime)
   (_h)
   (_nDim)
@@ -1008,10 +1013,24 @@ SICONOS_IO_REGISTER(ControlSimulation,
   (_processIntegrator)
   (_processSimulation)
   (_processTD)
+  (_recorder)
+  (_row)
   (_saveOnlyMainSimulation)
   (_silent)
   (_t0)
   (_theta))
+SICONOS_IO_REGISTER(ControlRecorder,
+  (_count)
+  (_decimation)
+  (_legend)
+  (_nColumns)
+  (_rows)
+  (_signals))
+SICONOS_IO_REGISTER_WITH_BASES(MatrixRecorder,(ControlRecorder),
+  (_data))
+SICONOS_IO_REGISTER_WITH_BASES(RingBufferRecorder,(ControlRecorder),
+  (_buffer)
+  (_capacity))
 SICONOS_IO_REGISTER_WITH_BASES(ActuatorEvent,(Event),
   (_actuator))
 SICONOS_IO_REGISTER_WITH_BASES(SensorEvent,(Event),
@@ -1072,6 +1091,8 @@ void siconos_io_register_generated_Control(Archive& ar)
   ar.register_type(static_cast<SensorEvent*>(nullptr));
   ar.register_type(static_cast<LinearSensor*>(nullptr));
   ar.register_type(static_cast<ControlManager*>(nullptr));
+  ar.register_type(static_cast<MatrixRecorder*>(nullptr));
+  ar.register_type(static_cast<RingBufferRecorder*>(nullptr));
 }
 
 template <class Archive>
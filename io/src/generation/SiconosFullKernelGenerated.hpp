@@ -49,7 +49,10 @@ SICONOS_IO_REGISTER(MatrixIntegrator,
   (_E)
   (_OSI)
   (_TD)
+  (_closedForm)
+  (_closedFormCache)
   (_isConst)
+  (_k)
   (_mat)
   (_nsds)
   (_plugin)
@@ -500,6 +503,7 @@ SICONOS_IO_REGISTER_WITH_BASES(LinearOSNS,(OneStepNSProblem),
   (_w)
   (_z))
 SICONOS_IO_REGISTER_WITH_BASES(ZeroOrderHoldOSI,(OneStepIntegrator),
+  (_closedForm)
   (_useGammaForRelation))
 SICONOS_IO_REGISTER_WITH_BASES(Equality,(LinearOSNS),
 )
@@ -529,6 +533,7 @@ SICONOS_IO_REGISTER_WITH_BASES(TimeStepping,(Simulation),
   (_resetAllLambda)
   (_warnOnNonConvergence))
 SICONOS_IO_REGISTER(OneStepIntegrator,
+  (_deterministicInput)
   (_dynamicalSystemsGraph)
   (_explicitJacobiansOfRelation)
   (_extraAdditionalTerms)
@@ -538,6 +543,7 @@ SICONOS_IO_REGISTER(OneStepIntegrator,
   (_levelMaxForOutput)
   (_levelMinForInput)
   (_levelMinForOutput)
+  (_parallelInteractions)
   (_simulation)
   (_sizeMem)
   (_steps))
@@ -0,0 +1,384 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "SiconosState.hpp"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+
+#include "Simulation.hpp"
+#include "EventsManager.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "Topology.hpp"
+#include "SecondOrderDS.hpp"
+#include "FirstOrderNonLinearDS.hpp"
+#include "Interaction.hpp"
+#include "SiconosVector.hpp"
+#include "SiconosMemory.hpp"
+#include "SiconosException.hpp"
+
+namespace Siconos
+{
+
+namespace
+{
+
+const char STATE_MAGIC[8] = {'S', 'I', 'C', 'S', 'T', 'A', 'T', 'E'};
+const uint32_t STATE_VERSION = 1;
+
+enum StateRecordKind { DS_RECORD = 0, INTERACTION_RECORD = 1 };
+
+/* (kind, number) -> payload */
+typedef std::map<std::pair<uint8_t, uint64_t>, std::string> StateRecords;
+
+struct StateHeader
+{
+  uint64_t k;
+  double tk;
+  std::string reference;
+};
+
+template<typename T>
+void write_pod(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T read_pod(std::istream& is)
+{
+  T value;
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  if(!is)
+    THROW_EXCEPTION("Siconos::loadState - truncated state file.");
+  return value;
+}
+
+void write_string(std::ostream& os, const std::string& str)
+{
+  write_pod<uint64_t>(os, str.size());
+  os.write(str.data(), str.size());
+}
+
+std::string read_string(std::istream& is)
+{
+  std::string str(read_pod<uint64_t>(is), '\0');
+  is.read(&str[0], str.size());
+  if(!is)
+    THROW_EXCEPTION("Siconos::loadState - truncated state file.");
+  return str;
+}
+
+/* a null vector is written with a zero size */
+void write_vector(std::ostream& os, const SiconosVector* v)
+{
+  uint32_t n = v ? v->size() : 0;
+  write_pod(os, n);
+  for(uint32_t i = 0; i < n; ++i)
+    write_pod(os, v->getValue(i));
+}
+
+void read_vector(std::istream& is, SiconosVector* v)
+{
+  uint32_t n = read_pod<uint32_t>(is);
+  if(n == 0)
+    return;
+  if(!v || v->size() != n)
+    THROW_EXCEPTION("Siconos::loadState - the model does not match the state file.");
+  for(uint32_t i = 0; i < n; ++i)
+    v->setValue(i, read_pod<double>(is));
+}
+
+/* the vectors swapped in memory by DynamicalSystem::swapInMemory */
+void state_vectors(DynamicalSystem& ds, std::vector<SiconosVector*>& v,
+                   std::vector<const SiconosMemory*>& mem)
+{
+  if(SecondOrderDS* sods = dynamic_cast<SecondOrderDS*>(&ds))
+  {
+    v = { sods->q().get(), sods->velocity().get(), sods->forces().get() };
+    mem = { &sods->qMemory(), &sods->velocityMemory(), &sods->forcesMemory() };
+  }
+  else
+  {
+    FirstOrderNonLinearDS* fods = dynamic_cast<FirstOrderNonLinearDS*>(&ds);
+    v = { ds.x().get(), ds.r().get() };
+    mem = { &ds.xMemory(), fods ? &fods->rMemory() : nullptr };
+  }
+}
+
+/* the vectors swapped in memory by Interaction::swapInMemory */
+void state_vectors(Interaction& inter, std::vector<SiconosVector*>& v,
+                   std::vector<const SiconosMemory*>& mem)
+{
+  v.clear();
+  mem.clear();
+  for(unsigned int i = inter.lowerLevelForOutput(); i <= inter.upperLevelForOutput(); ++i)
+  {
+    v.push_back(inter.y(i).get());
+    mem.push_back(&inter.yMemory(i));
+  }
+  for(unsigned int i = inter.lowerLevelForInput(); i <= inter.upperLevelForInput(); ++i)
+  {
+    v.push_back(inter.lambda(i).get());
+    mem.push_back(&inter.lambdaMemory(i));
+  }
+}
+
+/* payload: the number of vectors in memory, the memories from the
+ * oldest vector, then the current vectors */
+template<typename T>
+std::string write_record(T& object)
+{
+  std::vector<SiconosVector*> v;
+  std::vector<const SiconosMemory*> mem;
+  state_vectors(object, v, mem);
+
+  uint32_t steps = 0;
+  for(const SiconosMemory* m : mem)
+    if(m && m->nbVectorsInMemory() > steps)
+      steps = m->nbVectorsInMemory();
+
+  std::ostringstream os;
+  write_pod(os, steps);
+  for(uint32_t s = steps; s-- > 0;)
+  {
+    for(const SiconosMemory* m : mem)
+      write_vector(os, (m && s < m->nbVectorsInMemory()) ? &m->getSiconosVector(s) : nullptr);
+  }
+  for(SiconosVector* vi : v)
+    write_vector(os, vi);
+  return os.str();
+}
+
+/* the memories are restored by swapping the saved vectors, from the
+ * oldest one */
+template<typename T>
+void read_record(T& object, const std::string& payload)
+{
+  std::vector<SiconosVector*> v;
+  std::vector<const SiconosMemory*> mem;
+  state_vectors(object, v, mem);
+
+  std::istringstream is(payload);
+  uint32_t steps = read_pod<uint32_t>(is);
+  for(uint32_t s = 0; s < steps; ++s)
+  {
+    for(SiconosVector* vi : v)
+      read_vector(is, vi);
+    object.swapInMemory();
+  }
+  for(SiconosVector* vi : v)
+    read_vector(is, vi);
+}
+
+/* the current vectors of a record, without the memories */
+std::vector<SiconosVector> read_current(const std::string& payload,
+                                        unsigned int nvectors)
+{
+  std::istringstream is(payload);
+  uint32_t steps = read_pod<uint32_t>(is);
+  for(uint32_t s = 0; s < steps * nvectors; ++s)
+    is.ignore(read_pod<uint32_t>(is) * sizeof(double));
+
+  std::vector<SiconosVector> v;
+  for(unsigned int i = 0; i < nvectors; ++i)
+  {
+    v.emplace_back(read_pod<uint32_t>(is));
+    for(unsigned int j = 0; j < v.back().size(); ++j)
+      v.back().setValue(j, read_pod<double>(is));
+  }
+  return v;
+}
+
+/* the saved state of a dynamical system as its initial state,
+ * before the initialization of the simulation */
+void read_initial_state(DynamicalSystem& ds, const std::string& payload)
+{
+  if(SecondOrderDS* sods = dynamic_cast<SecondOrderDS*>(&ds))
+  {
+    std::vector<SiconosVector> v = read_current(payload, 3);
+    if(v[0].size() > 0)
+      sods->setQ0(v[0]);
+    if(v[1].size() > 0)
+      sods->setVelocity0(v[1]);
+  }
+  else
+  {
+    std::vector<SiconosVector> v = read_current(payload, 2);
+    if(v[0].size() > 0)
+      ds.setX0(v[0]);
+  }
+}
+
+StateRecords read_records(const std::string& filename, StateHeader& header)
+{
+  std::ifstream ifs(filename.c_str(), std::ios::binary);
+  if(!ifs)
+    THROW_EXCEPTION("Siconos::loadState - cannot open " + filename);
+
+  char magic[8];
+  ifs.read(magic, 8);
+  if(!ifs || std::memcmp(magic, STATE_MAGIC, 8) != 0)
+    THROW_EXCEPTION("Siconos::loadState - " + filename + " is not a state file.");
+  if(read_pod<uint32_t>(ifs) != STATE_VERSION)
+    THROW_EXCEPTION("Siconos::loadState - unsupported version of state file " + filename);
+
+  header.k = read_pod<uint64_t>(ifs);
+  header.tk = read_pod<double>(ifs);
+  header.reference = read_string(ifs);
+
+  // a delta is applied on its reference
+  StateRecords records;
+  if(!header.reference.empty())
+  {
+    StateHeader refHeader;
+    records = read_records(header.reference, refHeader);
+  }
+
+  uint64_t n = read_pod<uint64_t>(ifs);
+  for(uint64_t i = 0; i < n; ++i)
+  {
+    uint8_t kind = read_pod<uint8_t>(ifs);
+    uint64_t number = read_pod<uint64_t>(ifs);
+    records[std::make_pair(kind, number)] = read_string(ifs);
+  }
+  return records;
+}
+
+}
+
+void saveState(SP::Simulation s, const std::string& filename,
+               const std::string& reference)
+{
+  SP::Topology topo = s->nonSmoothDynamicalSystem()->topology();
+
+  StateRecords records;
+  DynamicalSystemsGraph& DSG0 = *topo->dSG(0);
+  DynamicalSystemsGraph::VIterator dsi, dsiend;
+  for(std::tie(dsi, dsiend) = DSG0.vertices(); dsi != dsiend; ++dsi)
+  {
+    DynamicalSystem& ds = *DSG0.bundle(*dsi);
+    records[std::make_pair((uint8_t)DS_RECORD, (uint64_t)ds.number())] = write_record(ds);
+  }
+  InteractionsGraph& indexSet0 = *topo->indexSet0();
+  InteractionsGraph::VIterator ui, uiend;
+  for(std::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
+  {
+    Interaction& inter = *indexSet0.bundle(*ui);
+    records[std::make_pair((uint8_t)INTERACTION_RECORD, (uint64_t)inter.number())] = write_record(inter);
+  }
+
+  // only the records which differ from the reference
+  if(!reference.empty())
+  {
+    StateHeader refHeader;
+    StateRecords refRecords = read_records(reference, refHeader);
+    for(StateRecords::iterator it = records.begin(); it != records.end();)
+    {
+      StateRecords::const_iterator ref = refRecords.find(it->first);
+      if(ref != refRecords.end() && ref->second == it->second)
+        it = records.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  std::string tempf = filename + ".tmp";
+  {
+    std::ofstream ofs(tempf.c_str(), std::ios::binary);
+    ofs.write(STATE_MAGIC, 8);
+    write_pod(ofs, STATE_VERSION);
+    write_pod<uint64_t>(ofs, s->eventsManager()->currentTimeIndex());
+    write_pod(ofs, s->getTk());
+    write_string(ofs, reference);
+    write_pod<uint64_t>(ofs, records.size());
+    for(const StateRecords::value_type& record : records)
+    {
+      write_pod(ofs, record.first.first);
+      write_pod(ofs, record.first.second);
+      write_string(ofs, record.second);
+    }
+    if(!ofs)
+      THROW_EXCEPTION("Siconos::saveState - cannot write " + tempf);
+  }
+
+  // atomic
+  if(std::rename(tempf.c_str(), filename.c_str()) != 0)
+    THROW_EXCEPTION("Siconos::saveState - cannot write " + filename);
+}
+
+void loadState(SP::Simulation s, const std::string& filename)
+{
+  StateHeader header;
+  StateRecords records = read_records(filename, header);
+
+  SP::Topology topo = s->nonSmoothDynamicalSystem()->topology();
+  DynamicalSystemsGraph::VIterator dsi, dsiend;
+
+  // the initialization resets the dynamical systems to their initial
+  // state and calls the interaction manager: the saved state is set
+  // as initial state before
+  if(!s->isInitialized())
+  {
+    DynamicalSystemsGraph& DSG0 = *topo->dSG(0);
+    for(std::tie(dsi, dsiend) = DSG0.vertices(); dsi != dsiend; ++dsi)
+    {
+      DynamicalSystem& ds = *DSG0.bundle(*dsi);
+      StateRecords::const_iterator record =
+        records.find(std::make_pair((uint8_t)DS_RECORD, (uint64_t)ds.number()));
+      if(record == records.end())
+        THROW_EXCEPTION("Siconos::loadState - the model does not match the state file.");
+      read_initial_state(ds, record->second);
+    }
+    s->initialize();
+  }
+  s->eventsManager()->advanceTo(header.k);
+
+  // the memories and the current vectors
+  DynamicalSystemsGraph& DSG0 = *topo->dSG(0);
+  for(std::tie(dsi, dsiend) = DSG0.vertices(); dsi != dsiend; ++dsi)
+  {
+    DynamicalSystem& ds = *DSG0.bundle(*dsi);
+    StateRecords::const_iterator record =
+      records.find(std::make_pair((uint8_t)DS_RECORD, (uint64_t)ds.number()));
+    if(record == records.end())
+      THROW_EXCEPTION("Siconos::loadState - the model does not match the state file.");
+    read_record(ds, record->second);
+  }
+
+  InteractionsGraph& indexSet0 = *topo->indexSet0();
+  InteractionsGraph::VIterator ui, uiend;
+  for(std::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
+  {
+    Interaction& inter = *indexSet0.bundle(*ui);
+    StateRecords::const_iterator record =
+      records.find(std::make_pair((uint8_t)INTERACTION_RECORD, (uint64_t)inter.number()));
+    if(record != records.end())
+      read_record(inter, record->second);
+  }
+
+  // the active sets from the restored outputs
+  s->updateIndexSets();
+  topo->setHasChanged(true);
+}
+
+}
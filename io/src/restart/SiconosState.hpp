@@ -0,0 +1,67 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file SiconosState.hpp
+  \brief state-only checkpoints of a Simulation, available without
+  serialization support */
+
+#ifndef SICONOSSTATE_HPP
+#define SICONOSSTATE_HPP
+
+#include <SiconosFwd.hpp>
+#include <string>
+
+/** SICONOS
+ */
+namespace Siconos
+{
+
+/** save only the time-varying state of a Simulation into a compact
+ *  binary file: the current time index, and for each dynamical
+ *  system and interaction (identified by its number) its state
+ *  vectors and memories.
+ *
+ *  With a reference file (a previous state checkpoint), only the
+ *  records that differ from the reference are written and the file
+ *  is a delta against the reference.
+ *
+ * \param s a Simulation
+ * \param filename the state file
+ * \param reference a previous state file, or an empty string
+ */
+void saveState(SP::Simulation s, const std::string& filename,
+               const std::string& reference = "");
+
+/** restore a state saved with saveState onto a Simulation rebuilt
+ *  from the same script and moved to the saved time instant.
+ *
+ *  If the simulation is not initialized yet, the saved states of the
+ *  dynamical systems are set as initial states before the
+ *  initialization, so that the first call to the interaction manager
+ *  sees the saved positions. Dynamical systems and interactions are
+ *  matched by number; the interactions which do not exist in the
+ *  simulation are rebuilt at the next step, without memories.
+ *
+ * \param s a Simulation, with only time discretisation events
+ * \param filename the state file
+ */
+void loadState(SP::Simulation s, const std::string& filename);
+
+}
+
+#endif
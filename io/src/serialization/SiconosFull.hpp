@@ -58,6 +58,7 @@ void siconos_io(Archive& ar, _DynamicalSystemsGraph& v, unsigned int version)
     {
       v.vertex_descriptor[v.bundle(*vi)] = *vi;
     }
+    v.structure_changed();
   }
 
 }
@@ -76,6 +77,7 @@ void siconos_io(Archive& ar, _InteractionsGraph& v, unsigned int version)
     {
       v.vertex_descriptor[v.bundle(*vi)] = *vi;
     }
+    v.structure_changed();
   }
 
 }
@@ -242,6 +244,8 @@ template<typename Archive>
 void siconos_io(Archive& ar, LsodarOSI& osi, unsigned int version)
 {
   ar & boost::serialization::make_nvp("_intData", osi._intData);
+  ar & boost::serialization::make_nvp("_rsav", osi._rsav);
+  ar & boost::serialization::make_nvp("_isav", osi._isav);
 
   if (Archive::is_loading::value)
   {
@@ -0,0 +1,149 @@
+#include "StateTest.hpp"
+#include "SiconosKernel.hpp"
+#include "SiconosState.hpp"
+
+#include <cmath>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StateTest);
+
+void StateTest::setUp() {}
+
+void StateTest::tearDown() {}
+
+/* a bouncing ball, built from scratch with the same numbers for the
+ * dynamical system and the interaction */
+static SP::TimeStepping bouncingBallSimulation()
+{
+  DynamicalSystem::resetCount();
+  Interaction::resetCount();
+
+  unsigned int nDof = 3;
+  double h = 0.005;
+  double m = 1;
+  double R = 0.1;
+
+  SP::SiconosMatrix Mass(new SimpleMatrix(nDof, nDof));
+  (*Mass)(0, 0) = m;
+  (*Mass)(1, 1) = m;
+  (*Mass)(2, 2) = 3. / 5 * m * R * R;
+
+  SP::SiconosVector q0(new SiconosVector(nDof));
+  SP::SiconosVector v0(new SiconosVector(nDof));
+  (*q0)(0) = 1.0;
+
+  SP::LagrangianLinearTIDS ball(new LagrangianLinearTIDS(q0, v0, Mass));
+  SP::SiconosVector weight(new SiconosVector(nDof));
+  (*weight)(0) = -m * 9.81;
+  ball->setFExtPtr(weight);
+
+  SP::SimpleMatrix H(new SimpleMatrix(1, nDof));
+  (*H)(0, 0) = 1.0;
+  SP::Interaction inter(new Interaction(SP::NonSmoothLaw(new NewtonImpactNSL(0.9)),
+                                        SP::Relation(new LagrangianLinearTIR(H))));
+
+  SP::NonSmoothDynamicalSystem bouncingBall(new NonSmoothDynamicalSystem(0, 10));
+  bouncingBall->insertDynamicalSystem(ball);
+  bouncingBall->link(inter, ball);
+
+  SP::MoreauJeanOSI OSI(new MoreauJeanOSI(0.5));
+  SP::TimeDiscretisation t(new TimeDiscretisation(0, h));
+  SP::TimeStepping s(new TimeStepping(bouncingBall, t, OSI, SP::OneStepNSProblem(new LCP())));
+  s->associate(OSI, ball);
+  return s;
+}
+
+static SP::LagrangianDS ballOf(SP::TimeStepping s)
+{
+  return std::static_pointer_cast<LagrangianDS>
+    (s->nonSmoothDynamicalSystem()->dynamicalSystem(0));
+}
+
+/* a checkpoint and a delta after 150 and 200 steps, and the 100
+ * next steps of the ball */
+static void reference(std::vector<double>& q, std::vector<double>& v)
+{
+  SP::TimeStepping s = bouncingBallSimulation();
+  SP::LagrangianDS ball = ballOf(s);
+
+  // the ball hits the ground before the checkpoints
+  for(unsigned int k = 0; k < 150; ++k)
+  {
+    s->computeOneStep();
+    s->nextStep();
+  }
+  Siconos::saveState(s, "BouncingBallState.bin");
+
+  for(unsigned int k = 0; k < 50; ++k)
+  {
+    s->computeOneStep();
+    s->nextStep();
+  }
+  Siconos::saveState(s, "BouncingBallStateDelta.bin", "BouncingBallState.bin");
+
+  for(unsigned int k = 0; k < 100; ++k)
+  {
+    s->computeOneStep();
+    s->nextStep();
+    q.push_back(ball->q()->getValue(0));
+    v.push_back(ball->velocity()->getValue(0));
+  }
+}
+
+static void checkRestart(SP::TimeStepping s,
+                         const std::vector<double>& q,
+                         const std::vector<double>& v)
+{
+  SP::LagrangianDS ball = ballOf(s);
+  CPPUNIT_ASSERT(fabs(s->getTk() - 200 * 0.005) < 1e-12);
+  for(unsigned int k = 0; k < 100; ++k)
+  {
+    s->computeOneStep();
+    s->nextStep();
+    CPPUNIT_ASSERT(fabs(ball->q()->getValue(0) - q[k]) < 1e-12);
+    CPPUNIT_ASSERT(fabs(ball->velocity()->getValue(0) - v[k]) < 1e-12);
+  }
+}
+
+/* restart from the delta, on a simulation not initialized */
+void StateTest::t1()
+{
+  try
+  {
+    std::vector<double> q, v;
+    reference(q, v);
+
+    SP::TimeStepping s = bouncingBallSimulation();
+    Siconos::loadState(s, "BouncingBallStateDelta.bin");
+    CPPUNIT_ASSERT(s->isInitialized());
+    // the saved position is the initial one
+    CPPUNIT_ASSERT(ballOf(s)->q0()->getValue(0) == ballOf(s)->q()->getValue(0));
+    checkRestart(s, q, v);
+  }
+  catch(...)
+  {
+    Siconos::exception::process();
+    CPPUNIT_ASSERT(false);
+  }
+}
+
+/* restart from the delta, on a simulation already initialized */
+void StateTest::t2()
+{
+  try
+  {
+    std::vector<double> q, v;
+    reference(q, v);
+
+    SP::TimeStepping s = bouncingBallSimulation();
+    s->initialize();
+    Siconos::loadState(s, "BouncingBallStateDelta.bin");
+    // the initial state is not modified
+    CPPUNIT_ASSERT(ballOf(s)->q0()->getValue(0) == 1.0);
+    checkRestart(s, q, v);
+  }
+  catch(...)
+  {
+    Siconos::exception::process();
+    CPPUNIT_ASSERT(false);
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef STATE_TEST_HPP
+#define STATE_TEST_HPP
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class StateTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(StateTest);
+
+  CPPUNIT_TEST(t1);
+  CPPUNIT_TEST(t2);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void t1();
+  void t2();
+
+public:
+  void setUp();
+  void tearDown();
+};
+
+#endif
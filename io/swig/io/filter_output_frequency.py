@@ -1,201 +1,137 @@
 #!/usr/bin/env python
+"""
+Keep one time step every output_frequency steps of a Siconos
+mechanics-IO HDF5 file. The datasets are read by blocks of time steps
+of bounded size, in parallel.
+"""
 import sys
-import os
-import vtk
+import getopt
+
 import numpy
+import h5py
 
-from siconos.io.mechanics_hdf5 import MechanicsHdf5
+from siconos.io.mechanics_hdf5 import MechanicsHdf5, data
+from siconos.io import hdf5_stream
 
-## the best way to dump all data
-#  $ h5dump toto.hdf5 > toto.txt
 
-import h5py
+def usage():
+    print('{0}: Usage'.format(sys.argv[0]))
+    print("""
+    {0} [--help] [--output_frequency=n] [--output_filename=]
+        [--processes=n] [--chunk-size=MB] <hdf5 file>
+    """.format(sys.argv[0]))
 
-import getopt
 
-def usage():
+def filter_steps(io_filename, out, name, steps, processes, chunk_bytes):
     """
-    {0} <hdf5 file>
-    """.format(sys.argv[0])
-    print '{0}: Usage'.format(sys.argv[0])
-    print """
-    {0} [--help] [--output_frequency=n] [--output_filename=]  <hdf5 file>
+    Copy the rows of the time steps steps of the dataset name, returns
+    the time index of the copy.
     """
-
-try:
-    opts, args = getopt.gnu_getopt(sys.argv[1:], '',
-                                   ['output_frequency=',
-                                    'output_filename=',
-                                    'cf-scale='])
-except getopt.GetoptError, err:
+    with h5py.File(io_filename, mode='r') as f:
+        dataset = hdf5_stream.dataset_rows(f, name)
+        times, first, last = hdf5_stream.time_index(f, name, chunk_bytes)
+        max_rows = hdf5_stream.chunk_rows(dataset, chunk_bytes)
+    keep = numpy.isin(times, steps)
+    times, first, last = times[keep], first[keep], last[keep]
+
+    ds = out._data[name]
+    ranges = hdf5_stream.time_ranges(first, last, max_rows)
+    tasks = [(io_filename, name, hdf5_stream.segments(first[i:j], last[i:j]),
+              None, ds.dtype) for i, j in ranges]
+    progress = hdf5_stream.Progress(name, int(numpy.sum(last - first)))
+    index = []
+    for (i, j), rows in zip(ranges, hdf5_stream.parallel_map(
+            hdf5_stream.read_segments, tasks, processes)):
+        n = ds.shape[0]
+        hdf5_stream.append_rows(ds, rows)
+        counts = last[i:j] - first[i:j]
+        offsets = n + numpy.concatenate(([0], numpy.cumsum(counts)))
+        index.extend(zip(times[i:j], offsets[:-1], offsets[1:]))
+        progress.update(rows.shape[0], rows.nbytes)
+    progress.done()
+    return numpy.array(index, dtype=float).reshape(-1, 3)
+
+
+if __name__ == '__main__':
+    try:
+        opts, args = getopt.gnu_getopt(sys.argv[1:], '',
+                                       ['help', 'output_frequency=',
+                                        'output_filename=', 'processes=',
+                                        'chunk-size=', 'cf-scale='])
+    except getopt.GetoptError as err:
         sys.stderr.write('{0}\n'.format(str(err)))
         usage()
         exit(2)
 
-min_time = None
-max_time = None
-scale_factor = 1
-output_frequency=10
-output_filename=None
-for o, a in opts:
-
-    if o == '--help':
+    output_frequency = 10
+    out_filename = None
+    processes = None
+    chunk_bytes = hdf5_stream.default_chunk_bytes
+    for o, a in opts:
+        if o == '--help':
+            usage()
+            exit(0)
+        elif o == '--output_frequency':
+            output_frequency = int(a)
+        elif o == '--output_filename':
+            out_filename = a
+        elif o == '--processes':
+            processes = int(a)
+        elif o == '--chunk-size':
+            chunk_bytes = int(float(a) * 2**20)
+
+    if len(args) == 0:
         usage()
-        exit(0)
-
-    elif o == '--output_frequency':
-        output_frequency = float(a)
-
-    elif o == '--output_filename':
-        out_filename=a
-
-    elif o == '--cf-scale':
-        scale_factor = float(a)
-
-
-if len(args) > 0:
+        exit(1)
     io_filename = args[0]
-    if output_filename == None:
-        out_filename=''.join(io_filename.rsplit('.')[:-1])+'-filtered.hdf5'
-else:
-    usage()
-    exit(1)
-
-
-
-with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
-    with MechanicsHdf5(io_filename=out_filename, mode='w') as out:
-
-
-
-        hdf1 = io._out
-        hdf2 = out._out
-
-        # copy /data/input
-        hdf2.__delitem__('data/input')
-        h5py.h5o.copy(hdf1.id, "data/input", hdf2.id, "data/input")
-        # copy /data/nslaws
-        hdf2.__delitem__('data/nslaws')
-        h5py.h5o.copy(hdf1.id, "data/nslaws", hdf2.id, "data/nslaws")
-        # copy /data/ref
-        hdf2.__delitem__('data/ref')
-        h5py.h5o.copy(hdf1.id, "data/ref", hdf2.id, "data/ref")
-
-        print('***************************************************** ')
-        print('************ Parsing simulation data ****************')
-        print('***************************************************** ')
-
-        def load():
-
-            ispos_data = io.static_data()
-            idpos_data = io.dynamic_data()
-
-            icf_data = io.contact_forces_data()[:]
-
-            isolv_data = io.solver_data()
-
-            return ispos_data, idpos_data, icf_data, isolv_data
-
-        spos_data, dpos_data, cf_data, solv_data = load()
-
-        #print('io._data',io._data)
-        #print('static position data : spos_data',spos_data)
-        #print('spos_data.value',spos_data.value)
-        #print('dynamic position data : dpos_data',dpos_data)
-        print('dpos_data.value',dpos_data.value)
-        print('cf_data',cf_data)
-        #print('solv_data',solv_data)
-
-        times = list(set(dpos_data[:, 0]))
-        times.sort()
-        print('len(times)',len(times))
-
-        if (len(times) ==0 ):
-            print('no results in the hdf5 file')
-        else:
-
-
-            print('Results for ',len(times),' steps in the hdf5 file')
-            #ndyna = len(numpy.where(dpos_data[:, 0] == times[0])) does not work
-            ndyna = len(dpos_data[:, 0])/len(times)
-            print('ndyna =', ndyna)
-            if len(spos_data) > 0:
-                nstatic = len(numpy.where(spos_data[:, 0] == times[0]))
-                nstatic = spos_data.shape[0]
-            else:
-                nstatic = 0
-            print('nstatic =', nstatic)
-            #    instances = set(dpos_data[:, 1])
-
-
-
-        # filtering
-
-
-        p=0
-        current_line=0
-        for k in range(len(times)):
-            #print(times[k])
-            if (k+1  < len(times) ):
-                time_step=times[k+1]-times[k]
-                #print('time_step',time_step)
-
-            if (k%output_frequency==0):
-                if k==0 :
-                    print('filter for k',k,'at times', times[k], 'p', p)
-                    out._dynamic_data.resize((p+1)*ndyna,0)
-                    out._dynamic_data[p*ndyna:(p+1)*ndyna,:] = numpy.array(dpos_data[k*ndyna:(k+1)*ndyna,:])
-                    #print('times',dpos_data[k*ndyna:(k+1)*ndyna,0])
-
-                    out._static_data.resize((p+1)*nstatic,0)
-                    out._static_data[p*nstatic:(p+1)*nstatic,:] = numpy.array(spos_data[0:nstatic,:])
-
-                    out._solv_data.resize((p+1),0)
-                    out._solv_data[p:(p+1),:] = numpy.array(solv_data[0:1,:])
-
-
-                    id_f = numpy.where(abs(cf_data[:, 0] - times[k]) < time_step*1e-5)[0]
-                    if len(id_f) == 0:
-                        print('no contact data at time',times[k])
-                    else:
-                        #print('index of contact :', min(id_f), max(id_f))
-                        out._cf_data.resize(max(id_f)+1,0)
-                        out._cf_data[min(id_f):max(id_f),:] = numpy.array(cf_data[min(id_f):max(id_f),:])
-                        current_line = max(id_f)
-                else:
-                    print('filter for k',k,'at times', times[k], 'p', p)
-                    out._dynamic_data.resize((p+1)*ndyna,0)
-                    #print( dpos_data[k*ndyna:(k+1)*ndyna,:])
-                    #print('times',dpos_data[(k+1)*ndyna:(k+2)*ndyna,0])
-                    out._dynamic_data[p*ndyna:(p+1)*ndyna,:] = dpos_data[(k+1)*ndyna:(k+2)*ndyna,:]
-
-                    # out._static_data.resize((p+1)*nstatic,0)
-                    # #print( dpos_data[k*nstatic:(k+1)*nstatic,:])
-                    # out._static_data[p*nstatic:(p+1)*nstatic,:] = spos_data[k*nstatic:(k+1)*nstatic,:]
-
-                    out._solv_data.resize((p+1),0)
-                    out._solv_data[p:(p+1),:] = numpy.array(solv_data[k:k+1,:])
-
-                    id_f = numpy.where(abs(cf_data[:, 0] - times[k]) < time_step*1e-5)[0]
-                    if len(id_f) == 0:
-                        print('no contact data at time',times[k])
-                    else:
-                        #print('index of contact :', min(id_f), max(id_f))
-                        new_line = current_line+max(id_f)-min(id_f)+1
-                        #print('new_line',new_line)
-                        #print('current_line',current_line)
-                        #print('size of contact data', max(id_f)-min(id_f)+1)
-                        out._cf_data.resize(new_line,0)
-                        #print('fill out._cf_data indices', current_line, new_line-1)
-                        out._cf_data[current_line:new_line,:] = numpy.array(cf_data[min(id_f):max(id_f)+1,:])
-                        current_line=new_line
-                        #print('current_line',current_line)
-
-                p = p+1
-        #print(dpos_data)
-
-        print(out._dynamic_data.shape)
-        print(out._static_data.shape)
-        print(out.static_data().value)
-        print(out._cf_data.shape)
-        print(out._solv_data.shape)
+    if out_filename is None:
+        out_filename = ''.join(io_filename.rsplit('.')[:-1]) + '-filtered.hdf5'
+
+    with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
+        with MechanicsHdf5(io_filename=out_filename, mode='w') as out:
+            hdf1 = io._out
+            hdf2 = out._out
+
+            # copy /data/input, /data/nslaws and /data/ref
+            for path in ['data/input', 'data/nslaws', 'data/ref']:
+                hdf2.__delitem__(path)
+                h5py.h5o.copy(hdf1.id, path.encode(), hdf2.id, path.encode())
+
+            times = io.time_index('dynamic')[0]
+            if len(times) == 0:
+                print('no results in the hdf5 file')
+                exit(0)
+            print('Results for', len(times), 'steps in the hdf5 file')
+            steps = times[::output_frequency]
+
+            index = {}
+            for name in ['dynamic', 'velocities', 'cf']:
+                index[name] = filter_steps(io_filename, out, name, steps,
+                                           processes, chunk_bytes)
+
+            # static objects at the first time step
+            static_times = io.time_index('static')
+            if len(static_times[0]) > 0:
+                index['static'] = filter_steps(io_filename, out, 'static',
+                                               static_times[0][:1],
+                                               processes, chunk_bytes)
+
+            # solver output: one row per step
+            solv = io.solver_data()
+            for a, b in hdf5_stream.row_ranges(
+                    0, solv.shape[0], hdf5_stream.chunk_rows(solv)):
+                rows = solv[a:b]
+                keep = numpy.arange(a, b) % output_frequency == 0
+                hdf5_stream.append_rows(out.solver_data(), rows[keep])
+
+            if out._index is not None:
+                for name, rows in index.items():
+                    ds = data(out._index, name, 3)
+                    ds.resize(rows.shape[0], 0)
+                    ds[:, :] = rows
+                out._index['cf'].attrs['mu'] = io.contact_forces_mu()
+
+            print(out.dynamic_data().shape)
+            print(out.static_data().shape)
+            print(out.contact_forces_data().shape)
+            print(out.solver_data().shape)
@@ -0,0 +1,355 @@
+"""
+Streaming access to the datasets of Siconos mechanics-IO HDF5 files,
+for the post-processing tools (siconos_filter, siconos_compare,
+siconos_export_raw_data, siconos_vexport).
+
+The datasets are read by hyperslabs of rows of bounded size, time
+ranges are processed in parallel by worker processes which open the
+files on their own in read-only mode, and the results are written by
+the calling process only, in order.
+"""
+
+import os
+import sys
+import time
+import collections
+import multiprocessing
+
+import numpy as np
+import h5py
+
+# size of the hyperslabs read at once
+default_chunk_bytes = 64 * 2**20
+
+
+def chunk_rows(dataset, chunk_bytes=default_chunk_bytes):
+    """
+    Number of rows of the hyperslabs of dataset of at most
+    chunk_bytes bytes, a multiple of the HDF5 chunks when possible.
+    """
+    dtype = np.dtype(getattr(dataset, 'dtype', np.float64))
+    row_bytes = max(1, int(np.prod(dataset.shape[1:]))) * dtype.itemsize
+    n = max(1, int(chunk_bytes // row_bytes))
+    chunks = getattr(dataset, 'chunks', None)
+    if chunks is not None and n > chunks[0]:
+        n -= n % chunks[0]
+    return n
+
+
+def row_ranges(start, stop, max_rows):
+    """
+    Consecutive ranges (a, b) of at most max_rows rows covering
+    start:stop.
+    """
+    for a in range(start, stop, max_rows):
+        yield a, min(a + max_rows, stop)
+
+
+def time_index(h5file, name, chunk_bytes=default_chunk_bytes):
+    """
+    Time index of the dataset data/<name>: returns times, first, last
+    such that the rows written at times[i] are first[i]:last[i]. The
+    index written by the runner is used when present, otherwise the
+    time column is read by hyperslabs.
+    """
+    index = h5file.get('data/index/{0}'.format(name))
+    if index is not None:
+        index = index[:]
+        return (index[:, 0], index[:, 1].astype(int),
+                index[:, 2].astype(int))
+
+    if name == 'cf' and 'data/cf_compressed' in h5file:
+        steps = h5file['data/cf_compressed/steps'][:]
+        return (steps[:, 0], steps[:, 1].astype(int),
+                steps[:, 2].astype(int))
+
+    dataset = h5file['data/{0}'.format(name)]
+    nrows = dataset.shape[0]
+    times, first = [], []
+    previous = None
+    for a, b in row_ranges(0, nrows, chunk_rows(dataset, chunk_bytes)):
+        t = dataset[a:b, 0]
+        change = np.flatnonzero(t[1:] != t[:-1]) + 1
+        if previous is None or t[0] != previous:
+            change = np.concatenate(([0], change))
+        times.append(t[change])
+        first.append(a + change)
+        previous = t[-1]
+    if nrows == 0:
+        return np.empty(0), np.empty(0, dtype=int), np.empty(0, dtype=int)
+    times = np.concatenate(times)
+    first = np.concatenate(first)
+    return times, first, np.append(first[1:], nrows)
+
+
+def time_ranges(first, last, max_rows):
+    """
+    Split the time steps whose rows are first[i]:last[i] into
+    consecutive ranges i:j of at most max_rows rows. A range holds at
+    least one step.
+    """
+    ranges = []
+    i = 0
+    n = len(first)
+    while i < n:
+        j = i + 1
+        rows = last[i] - first[i]
+        while j < n and rows + last[j] - first[j] <= max_rows:
+            rows += last[j] - first[j]
+            j += 1
+        ranges.append((i, j))
+        i = j
+    return ranges
+
+
+def segments(first, last):
+    """
+    Merge the row ranges first[i]:last[i] of consecutive time steps
+    into contiguous hyperslabs.
+    """
+    result = []
+    for a, b in zip(first, last):
+        if result and result[-1][1] == a:
+            result[-1][1] = b
+        elif b > a:
+            result.append([a, b])
+    return [tuple(s) for s in result]
+
+
+def searchsorted(dataset, value, column=0, side='left'):
+    """
+    numpy.searchsorted on a column of a dataset sorted on that
+    column, with point reads only.
+    """
+    lo, hi = 0, dataset.shape[0]
+    while lo < hi:
+        mid = (lo + hi) // 2
+        v = dataset[mid, column]
+        if v < value or (side == 'right' and v == value):
+            lo = mid + 1
+        else:
+            hi = mid
+    return lo
+
+
+def searchsorted_time(h5file, name, value):
+    """
+    First row of the dataset data/<name> written at a time greater
+    or equal to value, from the time index when present, otherwise by
+    a binary search on the time column.
+    """
+    if 'data/index/{0}'.format(name) in h5file or \
+       (name == 'cf' and 'data/cf_compressed' in h5file):
+        times, first, last = time_index(h5file, name)
+        i = np.searchsorted(times, value)
+        return first[i] if i < len(first) else (last[-1] if len(last) else 0)
+    return searchsorted(h5file['data/{0}'.format(name)], value)
+
+
+# files opened by the worker processes
+_files = {}
+
+
+def open_file(filename):
+    """
+    The file opened read-only, once per process.
+    """
+    f = _files.get(filename)
+    if f is None:
+        f = _files[filename] = h5py.File(filename, mode='r')
+    return f
+
+
+def dataset_rows(h5file, name):
+    """
+    The dataset data/<name>, or the compressed contact forces read as
+    the 'cf' dataset.
+    """
+    if name == 'cf' and 'cf' not in h5file['data'] \
+       and 'cf_compressed' in h5file['data']:
+        # imported on demand: it brings the mechanics modules
+        from siconos.io.mechanics_hdf5 import CompressedContactForces
+        return CompressedContactForces(h5file['data/cf_compressed'])
+    return h5file['data/{0}'.format(name)]
+
+
+def read_segments(task):
+    """
+    Worker: read the hyperslabs of a dataset and filter them. task is
+    (filename, name, segments, exclude, dtype): the rows whose
+    column 1 (object id) is in exclude are removed and the result is
+    converted to dtype if it is not None.
+    """
+    filename, name, segs, exclude, dtype = task
+    dataset = dataset_rows(open_file(filename), name)
+    if len(segs) == 0:
+        return np.empty((0,) + tuple(dataset.shape[1:]),
+                        dtype=dtype or np.float64)
+    rows = np.concatenate([dataset[a:b] for a, b in segs])
+    if exclude is not None and len(exclude) > 0:
+        rows = rows[np.isin(rows[:, 1], exclude, invert=True)]
+    if dtype is None:
+        return rows
+    return rows.astype(dtype, copy=False)
+
+
+def read_tables(task):
+    """
+    Worker: read the hyperslabs of several datasets of a file. task is
+    (filename, [(name, segments), ...]).
+    """
+    filename, tables = task
+    return [read_segments((filename, name, segs, None, None))
+            for name, segs in tables]
+
+
+def max_difference(task):
+    """
+    Worker: maximum of the absolute differences of the columns of
+    two datasets. task is (filename1, filename2, name, start1,
+    start2, nrows, columns).
+    """
+    filename1, filename2, name, s1, s2, n, columns = task
+    t1 = dataset_rows(open_file(filename1), name)
+    t2 = dataset_rows(open_file(filename2), name)
+    if n == 0:
+        return 0.0
+    a = t1[s1:s1 + n]
+    b = t2[s2:s2 + n]
+    if columns is not None:
+        a = a[:, columns]
+        b = b[:, columns]
+    return float(np.abs(a - b).max())
+
+
+def parallel_map(func, tasks, processes=None):
+    """
+    Generator of func(task) for the tasks, in order. With more than
+    one process, the tasks are run by a pool of worker processes and
+    at most two tasks per process are pending, so that the memory
+    used by the results is bounded. func must be a module-level
+    function.
+    """
+    if processes is None:
+        processes = os.cpu_count() or 1
+    tasks = iter(tasks)
+    if processes <= 1:
+        for task in tasks:
+            yield func(task)
+        return
+
+    # spawned workers do not inherit the HDF5 files opened by the
+    # caller
+    with multiprocessing.get_context('spawn').Pool(processes) as pool:
+        pending = collections.deque()
+        for task in tasks:
+            pending.append(pool.apply_async(func, (task,)))
+            if len(pending) >= 2 * processes:
+                yield pending.popleft().get()
+        while pending:
+            yield pending.popleft().get()
+
+
+def append_rows(dataset, rows):
+    """
+    Append rows at the end of a resizable dataset.
+    """
+    n = dataset.shape[0]
+    if rows.shape[0] > 0:
+        dataset.resize(n + rows.shape[0], 0)
+        dataset[n:, ...] = rows
+
+
+class Progress(object):
+    """
+    Progress and throughput report on stderr, at most once per
+    interval seconds.
+
+    Parameters
+    ----------
+    label: string
+    total: int
+        number of rows to process
+    stream: file, optional
+        default=sys.stderr, None to disable the report
+    interval: float, optional
+        seconds between two reports, default=1
+    """
+
+    def __init__(self, label, total, stream=sys.stderr, interval=1.0):
+        self._label = label
+        self._total = total
+        self._stream = stream
+        self._interval = interval
+        self._start = self._last = time.time()
+        self.rows = 0
+        self.nbytes = 0
+
+    def update(self, rows, nbytes=0):
+        self.rows += rows
+        self.nbytes += nbytes
+        if time.time() - self._last >= self._interval:
+            self._report('\r')
+
+    def done(self):
+        self._report('\n')
+
+    def _report(self, end):
+        if self._stream is None:
+            return
+        self._last = time.time()
+        elapsed = max(self._last - self._start, 1e-9)
+        percent = 100.0 * self.rows / self._total if self._total else 100.0
+        self._stream.write(
+            '{0}: {1:5.1f}% {2}/{3} rows, {4:.3g} rows/s, {5:.3g} MB/s, '
+            '{6:.1f}s{7}'.format(self._label, percent, self.rows,
+                                 self._total, self.rows / elapsed,
+                                 self.nbytes / elapsed / 2**20, elapsed,
+                                 end))
+        self._stream.flush()
+
+
+class TextTables(object):
+    """
+    Text tables written incrementally: the rows appended to each file
+    are buffered and written when the buffers exceed buffer_bytes.
+    The files are truncated on their first write.
+    """
+
+    def __init__(self, buffer_bytes=default_chunk_bytes, fmt='%.18e'):
+        self._buffers = collections.OrderedDict()
+        self._buffer_bytes = buffer_bytes
+        self._fmt = fmt
+        self._size = 0
+        self._written = set()
+
+    def append(self, filename, rows):
+        self._buffers.setdefault(filename, []).append(rows)
+        self._size += rows.nbytes
+        if self._size > self._buffer_bytes:
+            self.flush()
+
+    def flush(self):
+        for filename, blocks in self._buffers.items():
+            mode = ['w', 'a'][filename in self._written]
+            with open(filename, mode) as f:
+                np.savetxt(f, np.concatenate(blocks), fmt=self._fmt)
+            self._written.add(filename)
+        self._buffers.clear()
+        self._size = 0
+
+
+def group_by(rows, column):
+    """
+    Generator of (key, rows with this key in column), in the order of
+    the keys, preserving the order of the rows.
+    """
+    if rows.shape[0] == 0:
+        return
+    keys = rows[:, column]
+    order = np.argsort(keys, kind='stable')
+    keys = keys[order]
+    bounds = np.flatnonzero(keys[1:] != keys[:-1]) + 1
+    for a, b in zip(np.concatenate(([0], bounds)),
+                    np.append(bounds, len(keys))):
+        yield keys[a], rows[order[a:b]]
@@ -7,6 +7,7 @@
  //%include io-docstrings.i
 %{
 #include <SiconosKernel.hpp>
+#include <SiconosState.hpp>
 %}
 #ifdef WITH_SERIALIZATION
 %{
@@ -22,6 +23,7 @@
 
 %import kernel.i
 
+%include "SiconosState.hpp"
 #ifdef WITH_SERIALIZATION
 %include "SiconosRestart.hpp"
 #endif
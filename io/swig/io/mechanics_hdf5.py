@@ -11,12 +11,19 @@ elif hasattr(h5py, 'new_vlen'):
     h5py_vlen_dtype = h5py.new_vlen
 
 
+# fast compression filters (Blosc, LZ4, Zstd), optional
+try:
+    import hdf5plugin
+except ImportError:
+    hdf5plugin = None
+
 import pickle
 import tempfile
 from contextlib import contextmanager
 
 # Siconos Mechanics imports
 from siconos.mechanics.collision.tools import Volume
+from siconos.io import hdf5_stream
 
 # Constants
 joint_points_axes = {
@@ -142,6 +149,212 @@ def add_line(dataset, line):
     dataset[dataset.shape[0] - 1, :] = line
 
 
+def fast_compression():
+    """
+    Options of create_dataset for a fast compression: Blosc/LZ4 with
+    byte shuffle if hdf5plugin is available, gzip with shuffle
+    otherwise.
+    """
+    if hdf5plugin is not None:
+        return dict(hdf5plugin.Blosc(cname='lz4', clevel=5,
+                                     shuffle=hdf5plugin.Blosc.SHUFFLE))
+    return dict(compression='gzip', compression_opts=1, shuffle=True)
+
+
+contact_forces_info = 'time [0],  mu [1],  contact point A [2:4] ,' \
+    'contact point B [5:7],  contact normal [8:10], ' \
+    'reaction impulse (global frame) [11:13],' \
+    'relative gap [14:16], reaction velocity [17:19],' \
+    'reaction impulse (local frame) [20:22],  interaction id [23],' \
+    'ds 1 number [24],  ds 2 number [25]'
+
+
+class CompressedContactForces(object):
+    """
+    Contact forces stored in the group data/cf_compressed and read as
+    the 26 columns of the 'cf' dataset.
+
+    The interaction id, the ds numbers and mu are stored once per
+    contact lifetime (consecutive steps of an interaction) in
+    'lifetimes': [interaction id, ds 1, ds 2, mu, first row]. Each
+    row stores its lifetime in 'lifetime' and the columns 2 to 22 of
+    'cf' in 'values', as float32 if requested. The contact points and
+    the normal are stored as the difference with the previous step of
+    the lifetime, except on the first row of a lifetime and on the key
+    steps, every keyframe_interval steps, so that a time step is
+    decoded from the previous key step only. 'steps' stores
+    [time, first row, last row, key step].
+
+    Parameters
+    ----------
+    group: h5py group
+    float32: boolean, optional
+        store the values in single precision, default=False
+    keyframe_interval: int, optional
+        number of steps between two key steps, default=100
+    """
+
+    columns = 26
+
+    def __init__(self, group, float32=False, keyframe_interval=100):
+        self._group = group
+        if 'steps' not in group:
+            comp = fast_compression()
+            group.create_dataset('steps', (0, 4), maxshape=(None, 4),
+                                 dtype=np.float64, chunks=(4000, 4))
+            group.create_dataset('lifetimes', (0, 5), maxshape=(None, 5),
+                                 dtype=np.float64, chunks=(4000, 5), **comp)
+            group.create_dataset('lifetime', (0,), maxshape=(None,),
+                                 dtype=np.int64, chunks=(65536,), **comp)
+            group.create_dataset('values', (0, 21), maxshape=(None, 21),
+                                 dtype=[np.float64, np.float32][float32],
+                                 chunks=(4000, 21), **comp)
+            group.attrs['keyframe_interval'] = keyframe_interval
+            group.attrs['info'] = contact_forces_info
+        self._keyframe_interval = int(group.attrs['keyframe_interval'])
+        self._steps = None
+        # last step written: sorted interaction ids, their lifetimes,
+        # decoded points and normal, [ds 1, ds 2, mu]
+        self._previous = None
+
+    @property
+    def shape(self):
+        steps = self.steps()
+        return (int(steps[-1, 2]) if len(steps) > 0 else 0, self.columns)
+
+    @property
+    def attrs(self):
+        return self._group.attrs
+
+    def __len__(self):
+        return self.shape[0]
+
+    def steps(self):
+        if self._steps is None:
+            self._steps = self._group['steps'][:]
+        return self._steps
+
+    def time_index(self):
+        steps = self.steps()
+        return (steps[:, 0], steps[:, 1].astype(int),
+                steps[:, 2].astype(int))
+
+    def mu(self):
+        return np.unique(self._group['lifetimes'][:, 3])
+
+    def append(self, time, rows):
+        """
+        Append the rows (26 columns, as in 'cf') written at time.
+        """
+        n = rows.shape[0]
+        first = self.shape[0]
+        nsteps = self.steps().shape[0]
+        key = self._previous is None or nsteps % self._keyframe_interval == 0
+        ids = rows[:, 23]
+        info = rows[:, [24, 25, 1]]
+
+        found = np.zeros(n, dtype=bool)
+        pos = np.zeros(n, dtype=int)
+        if self._previous is not None and len(self._previous[0]) > 0:
+            pids, plifetimes, pdecoded, pinfo = self._previous
+            pos = np.minimum(np.searchsorted(pids, ids), len(pids) - 1)
+            found = (pids[pos] == ids) & np.all(pinfo[pos] == info, axis=1)
+            # an interaction met twice in a step starts a new lifetime
+            once = np.zeros(n, dtype=bool)
+            once[np.unique(ids, return_index=True)[1]] = True
+            found &= once
+
+        lifetime = np.empty(n, dtype=np.int64)
+        if self._previous is not None:
+            lifetime[found] = self._previous[1][pos[found]]
+        new = np.flatnonzero(~found)
+        lifetimes = self._group['lifetimes']
+        nlifetimes = lifetimes.shape[0]
+        lifetime[new] = nlifetimes + np.arange(len(new))
+        lifetimes.resize(nlifetimes + len(new), 0)
+        lifetimes[nlifetimes:, :] = np.column_stack(
+            (ids[new], info[new], first + new))
+
+        values = self._group['values']
+        encoded = rows[:, 2:23].astype(values.dtype)
+        decoded = encoded[:, :9].astype(np.float64)
+        if not key:
+            # the differences are taken with the decoded values, the
+            # rounding errors do not accumulate
+            delta = rows[found, 2:11] - self._previous[2][pos[found]]
+            encoded[found, :9] = delta
+            decoded[found] = self._previous[2][pos[found]] + \
+                encoded[found, :9].astype(np.float64)
+
+        values.resize(first + n, 0)
+        values[first:, :] = encoded
+        dataset = self._group['lifetime']
+        dataset.resize(first + n, 0)
+        dataset[first:] = lifetime
+        add_line(self._group['steps'], [time, first, first + n, key])
+        self._steps = None
+
+        order = np.argsort(ids, kind='stable')
+        self._previous = (ids[order], lifetime[order], decoded[order],
+                          info[order])
+
+    def rows(self, start, stop):
+        """
+        The rows start:stop, with the 26 columns of 'cf'.
+        """
+        steps = self.steps()
+        if stop <= start:
+            return np.empty((0, self.columns))
+        s0 = np.searchsorted(steps[:, 2], start, side='right')
+        s1 = np.searchsorted(steps[:, 1], stop, side='left')
+        k = np.flatnonzero(steps[:s0 + 1, 3])[-1]
+        r0, r1 = int(steps[k, 1]), int(steps[s1 - 1, 2])
+
+        lifetime = self._group['lifetime'][r0:r1]
+        values = self._group['values'][r0:r1].astype(np.float64)
+        lmin, lmax = lifetime.min(), lifetime.max()
+        lifetimes = self._group['lifetimes'][lmin:lmax + 1]
+        lifetime -= lmin
+
+        state = np.zeros((lmax - lmin + 1, 9))
+        decoded = values[:, :9]
+        times = np.empty(r1 - r0)
+        for s in range(k, s1):
+            a, b = int(steps[s, 1]) - r0, int(steps[s, 2]) - r0
+            times[a:b] = steps[s, 0]
+            lt = lifetime[a:b]
+            if not steps[s, 3]:
+                delta = lifetimes[lt, 4] != np.arange(a, b) + r0
+                decoded[a:b][delta] += state[lt[delta]]
+            state[lt] = decoded[a:b]
+
+        out = np.empty((r1 - r0, self.columns))
+        out[:, 0] = times
+        out[:, 1] = lifetimes[lifetime, 3]
+        out[:, 2:23] = values
+        out[:, 23:26] = lifetimes[lifetime, 0:3]
+        return out[start - r0:stop - r0]
+
+    def __getitem__(self, key):
+        if not isinstance(key, tuple):
+            key = (key,)
+        rows, columns = key[0], key[1:]
+        nrows = self.shape[0]
+        if rows is Ellipsis:
+            rows = slice(None)
+        if isinstance(rows, slice):
+            start, stop, stride = rows.indices(nrows)
+            result = self.rows(start, max(start, stop))[::stride]
+            return result[(slice(None),) + columns] if columns else result
+        row = int(rows)
+        if row < 0:
+            row += nrows
+        if not 0 <= row < nrows:
+            raise IndexError('row {0} out of range'.format(rows))
+        result = self.rows(row, row + 1)[0]
+        return result[columns] if columns else result
+
+
 #
 # misc fixes
 #
@@ -471,10 +684,17 @@ class MechanicsHdf5(object):
         default=False
     verbose: boolean, optional
        default=True
+    compress_contact_forces: boolean, optional
+        store the contact forces in the compressed, delta-encoded
+        format of CompressedContactForces, default=False
+    contact_forces_float32: boolean, optional
+        store the compressed contact forces in single precision,
+        default=False
     """
 
     def __init__(self, io_filename=None, mode='w', io_filename_backup=None,
-                 use_compression=False, output_domains=False, verbose=True):
+                 use_compression=False, output_domains=False, verbose=True,
+                 compress_contact_forces=False, contact_forces_float32=False):
         if io_filename is None:
             self._io_filename = '{0}.hdf5'.format(
                 os.path.splitext(os.path.basename(sys.argv[0]))[0])
@@ -496,6 +716,7 @@ class MechanicsHdf5(object):
         self._cf_info = None
         self._domain_data = None
         self._solv_data = None
+        self._index = None
         self._run_options = None
         self._log_data = None
         self._input = None
@@ -516,6 +737,8 @@ class MechanicsHdf5(object):
         self._use_compression = use_compression
         self._should_output_domains = output_domains
         self._verbose = verbose
+        self._compress_contact_forces = compress_contact_forces
+        self._contact_forces_float32 = contact_forces_float32
 
     def __enter__(self):
         """Reminder: this function will be called when a 'with'
@@ -563,15 +786,24 @@ class MechanicsHdf5(object):
             self._dynamic_data.attrs['info'] = 'time,  ds id  ,  translation ,'
             self._dynamic_data.attrs['info'] += 'orientation'
 
-        self._cf_data = data(self._data, 'cf', 26,
-                             use_compression=self._use_compression)
-        if self._mode == 'w':
-            self._cf_data.attrs['info'] = 'time [0],  mu [1],  contact point A [2:4] ,'
-            self._cf_data.attrs['info'] += 'contact point B [5:7],  contact normal [8:10], '
-            self._cf_data.attrs['info'] += 'reaction impulse (global frame) [11:13],'
-            self._cf_data.attrs['info'] += 'relative gap [14:16], reaction velocity [17:19],'
-            self._cf_data.attrs['info'] += 'reaction impulse (local frame) [20:22],  interaction id [23],'
-            self._cf_data.attrs['info'] += 'ds 1 number [24],  ds 2 number [25]'
+        # time -> rows of the datasets written at that time
+        self._index = group(self._data, 'index', must_exist=False)
+
+        # the compressed format is not used to continue a file
+        # written with the full one
+        if 'cf_compressed' in self._data or \
+           (self._compress_contact_forces and self._mode != 'r'
+            and ('cf' not in self._data or self._data['cf'].shape[0] == 0)):
+            self._cf_data = CompressedContactForces(
+                group(self._data, 'cf_compressed'),
+                float32=self._contact_forces_float32)
+            if self._index is not None:
+                data(self._index, 'cf', 3)
+        else:
+            self._cf_data = data(self._data, 'cf', 26,
+                                 use_compression=self._use_compression)
+            if self._mode == 'w':
+                self._cf_data.attrs['info'] = contact_forces_info
 
         self._cf_info = data(self._data, 'cf_info', 5,
                              use_compression=self._use_compression)
@@ -586,6 +818,7 @@ class MechanicsHdf5(object):
                                      use_compression=self._use_compression)
         self._solv_data = data(self._data, 'solv', 4,
                                use_compression=self._use_compression)
+
         self._run_options_data = data(self._data, 'siconos_mechanics_run_options', 1,
                                       use_compression=self._use_compression)
 
@@ -681,6 +914,66 @@ class MechanicsHdf5(object):
         """
         return self._log_data
 
+    def time_index(self, name):
+        """
+        Time index of the dataset name ('static', 'dynamic',
+        'velocities' or 'cf'): returns times, first, last such that the
+        rows written at times[i] are first[i]:last[i]. For files
+        written without index, it is computed from the time column.
+        """
+        if self._index is not None and name in self._index:
+            index = self._index[name][:]
+            return (index[:, 0], index[:, 1].astype(int),
+                    index[:, 2].astype(int))
+
+        if name == 'cf' and isinstance(self._cf_data, CompressedContactForces):
+            return self._cf_data.time_index()
+
+        # the time column is read by blocks of rows
+        return hdf5_stream.time_index(self._out, name)
+
+    def contact_forces_mu(self):
+        """
+        Friction coefficients of the contact forces dataset, from the
+        time index. For files written without index, they are
+        computed from the mu column.
+        """
+        if self._index is not None and 'cf' in self._index \
+           and 'mu' in self._index['cf'].attrs:
+            return np.array(self._index['cf'].attrs['mu'])
+
+        if isinstance(self._cf_data, CompressedContactForces):
+            return self._cf_data.mu()
+        if self._cf_data.shape[0] == 0:
+            return np.empty(0)
+        return np.unique(self._cf_data[:, 1])
+
+    def add_time_index(self, name, time, first, last, mu=None):
+        """
+        Record that the rows first:last of the dataset name have been
+        written at the given time, and for the contact forces the
+        friction coefficients mu of these rows.
+        """
+        if name not in self._index:
+            # rows written without index (file opened in append mode)
+            times, ifirst, ilast = self.time_index(name)
+            index = data(self._index, name, 3)
+            index.resize(len(times), 0)
+            if len(times) > 0:
+                index[:, :] = np.stack((times, ifirst, ilast), axis=1)
+            if mu is not None:
+                index.attrs['mu'] = np.unique(self._data[name][:, 1])
+            return
+
+        index = self._index[name]
+        if mu is not None:
+            index.attrs['mu'] = np.union1d(index.attrs.get('mu', []), mu)
+        n = index.shape[0]
+        if n > 0 and index[n - 1, 0] == time and index[n - 1, 2] == first:
+            index[n - 1, 2] = last
+        else:
+            add_line(index, [time, first, last])
+
     def instances(self):
         """
         Scene objects.
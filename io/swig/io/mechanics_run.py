@@ -44,7 +44,7 @@ from siconos.io.io_base import MechanicsIO
 from siconos.io.FrictionContactTrace import GlobalFrictionContactTrace as GFCTrace
 from siconos.io.FrictionContactTrace import FrictionContactTrace as FCTrace
 from siconos.io.FrictionContactTrace import GlobalRollingFrictionContactTrace as GRFCTrace
-from siconos.io.mechanics_hdf5 import MechanicsHdf5
+from siconos.io.mechanics_hdf5 import MechanicsHdf5, CompressedContactForces
 
 
 # Imports for mechanics 'collision' submodule
@@ -884,6 +884,12 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
             default=False
         verbose: boolean, optional
            default=True
+        compress_contact_forces: boolean, optional
+            store the contact forces in the compressed, delta-encoded
+            format of CompressedContactForces, default=False
+        contact_forces_float32: boolean, optional
+            store the compressed contact forces in single precision,
+            default=False
 
     """
 
@@ -892,12 +898,15 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                  osi=None, shape_filename=None,
                  set_external_forces=None, gravity_scale=None,
                  collision_margin=None,
-                 use_compression=False, output_domains=False, verbose=True):
+                 use_compression=False, output_domains=False, verbose=True,
+                 compress_contact_forces=False, contact_forces_float32=False):
 
         super(MechanicsHdf5Runner, self).__init__(io_filename, mode,
                                                   io_filename_backup,
                                                   use_compression,
-                                                  output_domains, verbose)
+                                                  output_domains, verbose,
+                                                  compress_contact_forces,
+                                                  contact_forces_float32)
         self._interman = interaction_manager
         self._nsds = nsds
         self._simulation = simulation
@@ -1994,6 +2003,9 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
 
             p += 1
 
+        self.add_time_index('static', time, current_line,
+                            self._static_data.shape[0])
+
         #print('current_line , self._static_data', current_line, self._static_data)
         #input()
 
@@ -2031,6 +2043,9 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                 self._dynamic_data[current_line:, :] = np.concatenate(
                     (times, new_positions), axis=1)
 
+            self.add_time_index('dynamic', time, current_line,
+                                self._dynamic_data.shape[0])
+
     def output_velocities(self):
         """
         Output velocities of dynamic objects
@@ -2062,6 +2077,9 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                 self._velocities_data[current_line:, :] = np.concatenate(
                     (times, new_velocities), axis=1)
 
+            self.add_time_index('velocities', time, current_line,
+                                self._velocities_data.shape[0])
+
     def output_contact_forces(self):
         """
         Outputs contact forces
@@ -2074,17 +2092,11 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                                                     self._output_contact_index_set)
             if contact_points is not None:
                 current_line = self._cf_data.shape[0]
-                # Increase the number of lines in cf_data
-                # (h5 dataset with chunks)
-                self._cf_data.resize(current_line + contact_points.shape[0], 0)
                 times = np.empty((contact_points.shape[0], 1))
                 times.fill(time)
 
                 if self._dimension == 3:
-                    self._cf_data[current_line:, :] = \
-                        np.concatenate((times,
-                                        contact_points),
-                                       axis=1)
+                    rows = np.concatenate((times, contact_points), axis=1)
 
                 elif self._dimension == 2:
 
@@ -2121,8 +2133,19 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                     new_contact_points[:, 22] = contact_points[:, 15]
                     new_contact_points[:, 23] = contact_points[:, 16]  # ds 1
                     new_contact_points[:, 24] = contact_points[:, 17]  # ds 2
-                    self._cf_data[current_line:, :] = np.concatenate(
-                        (times, new_contact_points), axis=1)
+                    rows = np.concatenate((times, new_contact_points), axis=1)
+
+                if isinstance(self._cf_data, CompressedContactForces):
+                    self._cf_data.append(time, rows)
+                else:
+                    # Increase the number of lines in cf_data
+                    # (h5 dataset with chunks)
+                    self._cf_data.resize(current_line + rows.shape[0], 0)
+                    self._cf_data[current_line:, :] = rows
+
+                self.add_time_index('cf', time, current_line,
+                                    self._cf_data.shape[0],
+                                    mu=contact_points[:, 0])
 
                 # return the number of contacts
                 return len(contact_points)
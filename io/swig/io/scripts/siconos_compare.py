@@ -33,6 +33,14 @@ parser.add_argument('--interval', metavar='<time>', type=float,
                     help = 'amount of time after start to compare')
 parser.add_argument('--threshold', metavar='<float>', type=float, default=1e-14,
                     help = 'threshold for comparison')
+parser.add_argument('--processes', metavar='<n>', type=int,
+                    help = 'number of processes reading the files '
+                    '(default: number of CPUs)')
+parser.add_argument('--chunk-size', metavar='<MB>', type=float, default=64,
+                    help = 'size of the blocks of rows compared at once '
+                    '(default: 64)')
+parser.add_argument('--quiet', action = 'store_true',
+                    help = 'do not report progress on standard error')
 parser.add_argument('-V','--version', action='version',
                     version='@SICONOS_VERSION@')
 
@@ -60,80 +68,97 @@ if __name__ == '__main__':
 # Heavier imports after command line parsing
 import numpy as np
 import h5py
+from siconos.io import hdf5_stream
+
+def table(io, name):
+    """The table name of a file, None if it does not exist."""
+    try:
+        return hdf5_stream.dataset_rows(io, name)
+    except KeyError:
+        return None
 
 def verify_tables(tablenames, columns, io1, io2):
     """Verify files contain tables and tables have same columns."""
-    for table in tablenames:
-        if not table in io1['data']:
+    for name in tablenames:
+        t1, t2 = table(io1, name), table(io2, name)
+        if t1 is None:
             print('File "{}" does not have table "{}".'.format(
-                args.fns_in[0], table), file=sys.stderr)
+                args.fns_in[0], name), file=sys.stderr)
             sys.exit(2)
-        if not table in io2['data']:
+        if t2 is None:
             print('File "{}" does not have table "{}".'.format(
-                args.fns_in[1], table), file=sys.stderr)
+                args.fns_in[1], name), file=sys.stderr)
             sys.exit(2)
         for c in columns:
             if c[1] is None:
                 continue
-            if c[0] == table and c[1] >= io1['data'][table].shape[1]:
+            if c[0] == name and c[1] >= t1.shape[1]:
                 print('Table "{}" in file "{}" does not have specified column {}.'
-                      .format(table, args.fns_in[0], c[1]), file=sys.stderr)
+                      .format(name, args.fns_in[0], c[1]), file=sys.stderr)
                 sys.exit(2)
-            if c[0] == table and c[1] >= io2['data'][table].shape[1]:
+            if c[0] == name and c[1] >= t2.shape[1]:
                 print('Table "{}" in file "{}" does not have specified column {}.'
-                      .format(table, args.fns_in[1], c[1]), file=sys.stderr)
+                      .format(name, args.fns_in[1], c[1]), file=sys.stderr)
                 sys.exit(2)
-        if io1['data'][table].shape[1] != io2['data'][table].shape[1]:
+        if t1.shape[1] != t2.shape[1]:
             print('Tables "{}" do not have same number of columns in each file.'
-                  .format(table), file=sys.stderr)
+                  .format(name), file=sys.stderr)
             sys.exit(2)
 
 def compare_tables(tablenames, columns, io1, io2):
-    """Compare tables and columns given."""
+    """Compare tables and columns given, by blocks of rows compared in
+    parallel."""
     maxdiff = 0.0
-    for table in tablenames:
-        for c in columns:
-            if c[0]!=table:
-                continue
-            t1 = io1['data'][table]
-            t2 = io2['data'][table]
-
-            # start/end/interval times
-            S1, S2 = 0, 0
-            E1, E2 = t1.shape[0]-1, t2.shape[0]-1
-            if args.start is not None:
-                S1 = np.searchsorted(t1[:,0], args.start)
-                S2 = np.searchsorted(t2[:,0], args.start)
-            if args.end is not None:
-                E1 = np.searchsorted(t1[:,0], args.end)
-                E2 = np.searchsorted(t2[:,0], args.end)
-            elif args.interval is not None:
-                E1 = np.searchsorted(t1[:,0], args.start + args.interval)
-                E2 = np.searchsorted(t2[:,0], args.start + args.interval)
-            for t,n,s,T,fn in [(S1,args.start,'Start',t1,args.fns_in[0]),
-                               (S2,args.start,'Start',t2,args.fns_in[1]),
-                               (E1,args.end,'End',t1,args.fns_in[0]),
-                               (E2,args.end,'End',t2,args.fns_in[1])]:
-                if t >= T.shape[0]:
-                    print('{} time {} beyond the end of table "{}" for file "{}".'
-                          .format(s, n, table, fn), file=sys.stderr)
-                    sys.exit(2)
+    for name in tablenames:
+        t1, t2 = table(io1, name), table(io2, name)
 
-            # TODO: we assume same sampling rate for now, later,
-            # support linear interpolation?
-            if (E1-S1) != (E2-S2):
-                print(('Tables "{}" do not have same number of rows in each file '
-                       +'for requested range.').format(table), file=sys.stderr)
+        # start/end/interval times, the rows are found with the time
+        # index or a binary search on the time column
+        def row(io, t):
+            return hdf5_stream.searchsorted_time(io, name, t)
+        S1, S2 = 0, 0
+        E1, E2 = t1.shape[0]-1, t2.shape[0]-1
+        if args.start is not None:
+            S1 = row(io1, args.start)
+            S2 = row(io2, args.start)
+        if args.end is not None:
+            E1 = row(io1, args.end)
+            E2 = row(io2, args.end)
+        elif args.interval is not None:
+            E1 = row(io1, args.start + args.interval)
+            E2 = row(io2, args.start + args.interval)
+        for t,n,s,T,fn in [(S1,args.start,'Start',t1,args.fns_in[0]),
+                           (S2,args.start,'Start',t2,args.fns_in[1]),
+                           (E1,args.end,'End',t1,args.fns_in[0]),
+                           (E2,args.end,'End',t2,args.fns_in[1])]:
+            if t >= T.shape[0]:
+                print('{} time {} beyond the end of table "{}" for file "{}".'
+                      .format(s, n, name, fn), file=sys.stderr)
                 sys.exit(2)
 
-            # Compare one column at a time
-            cols = [c[1]]
-            if c[1] is None:
-                cols = range(t1.shape[1])
-            for j in cols:
-                d = np.abs(t1[S1:E1,j] - t2[S2:E2,j]).max()
-                if d > maxdiff:
-                    maxdiff = d
+        # TODO: we assume same sampling rate for now, later,
+        # support linear interpolation?
+        if (E1-S1) != (E2-S2):
+            print(('Tables "{}" do not have same number of rows in each file '
+                   +'for requested range.').format(name), file=sys.stderr)
+            sys.exit(2)
+
+        # Columns compared in this table
+        cols = [c[1] for c in columns if c[0] == name]
+        if None in cols:
+            cols = None
+
+        nrows = hdf5_stream.chunk_rows(t1, int(args.chunk_size * 2**20))
+        tasks = [(args.fns_in[0], args.fns_in[1], name, S1 + a, S2 + a, b - a, cols)
+                 for a, b in hdf5_stream.row_ranges(0, E1 - S1, nrows)]
+        progress = hdf5_stream.Progress(name, E1 - S1,
+                                        stream=[sys.stderr, None][args.quiet])
+        for task, d in zip(tasks, hdf5_stream.parallel_map(
+                hdf5_stream.max_difference, tasks, args.processes)):
+            progress.update(task[5], 2 * task[5] * t1.shape[1] * 8)
+            if d > maxdiff:
+                maxdiff = d
+        progress.done()
     print(maxdiff)
     return int(maxdiff >= args.threshold)
 
@@ -27,6 +27,14 @@ parser.add_argument('--exclude', type=str,
                     help = 'specify objects to exclude from copy (comma-separated)')
 parser.add_argument('--attr', type=str, action='append',
                     help = 'specify attributes to change during copy (obj.name=value)')
+parser.add_argument('--processes', metavar='n', type=int,
+                    help = 'number of processes reading the input '
+                    '(default: number of CPUs)')
+parser.add_argument('--chunk-size', metavar='MB', type=float, default=64,
+                    help = 'size of the blocks of rows read at once '
+                    '(default: 64)')
+parser.add_argument('--quiet', action = 'store_true',
+                    help = 'do not report progress')
 parser.add_argument('-V','--version', action='version',
                     version='@SICONOS_VERSION@')
 
@@ -36,18 +44,29 @@ if __name__ == '__main__':
 # Heavier imports after command line parsing
 import numpy as np
 import h5py
+from siconos.io import hdf5_stream
+
+# datasets filtered by time step and object, the other ones are copied
+filtered_datasets = ['data/cf', 'data/dynamic', 'data/velocities',
+                     'data/static']
 
 class CopyVisitor(object):
     """The CopyVisitor is called for each group and dataset in the HDF5
        file, and is responsible for copying the structure to the new
-       HDF5 file."""
-    def __init__(self, time_filter = None, object_filter = None, attr_filter = None):
-        self.time_filter = None
-        if time_filter is not None:
-            self.time_filter = np.vectorize(time_filter)
+       HDF5 file.  Datasets are copied by blocks of rows of bounded
+       size, the filtered ones being read by worker processes."""
+    def __init__(self, time_filter = None, object_filter = None, attr_filter = None,
+                 processes = None, chunk_bytes = hdf5_stream.default_chunk_bytes,
+                 progress = sys.stderr):
+        self.time_filter = time_filter
         self.object_filter = object_filter
-        self.time_idx = None
+        self.processes = processes
+        self.chunk_bytes = chunk_bytes
+        self.progress = progress
+        self.times = None
         self.excluded_objects = None
+        # time index of the filtered datasets, rewritten at the end
+        self.index = {}
         def copy_attrs(obj_to, obj_from):
             for a in obj_from.attrs:
                 value = None
@@ -58,6 +77,100 @@ class CopyVisitor(object):
                 obj_to.attrs[a] = value
         self.copy_attrs = copy_attrs
 
+    def selected_times(self, io):
+        """Times of data/dynamic kept by the time filter."""
+        if self.times is None and self.time_filter is not None:
+            times = hdf5_stream.time_index(io, 'dynamic', self.chunk_bytes)[0]
+            self.times = np.array([t for t in times if self.time_filter(t)])
+        return self.times
+
+    def create_dataset(self, gr, obj, name, shape, maxshape, dtype):
+        # Determine chunks argument
+        chunks = None
+        if (getattr(obj, 'chunks', None) is not None
+            and np.all(np.array(obj.chunks) <= np.array(shape))):
+            chunks = obj.chunks
+        if chunks is None and tuple(maxshape) != tuple(shape):
+            chunks = True
+
+        # Create the dataset, supply compression and dtype
+        # arguments, possibly overridden by command line arguments
+        compression = getattr(obj, 'compression', None)
+        comp = ((compression is True or args.gzip)
+                and chunks is not None)
+        if comp:
+            chunks = (4000,) + tuple(shape[1:])
+        single = args.single and np.dtype(dtype).kind == 'f'
+        return gr.create_dataset(name,
+                                 dtype = [dtype,'f4'][single],
+                                 shape = shape,
+                                 maxshape = maxshape,
+                                 chunks = chunks,
+                                 compression = [compression, True][comp],
+                                 compression_opts = [getattr(obj, 'compression_opts', None),9][comp],
+                                 shuffle = comp,
+                                 fletcher32 = getattr(obj, 'fletcher32', False))
+
+    def copy_filtered(self, gr, io, path, obj):
+        """Copy the time steps kept by the time filter of a dataset, without
+        the rows referencing excluded objects, and record its new time
+        index.  The compressed contact forces are written as data/cf."""
+        name = path.split('/')[-1]
+        if name == 'cf_compressed':
+            name = 'cf'
+        dataset = hdf5_stream.dataset_rows(io, name)
+        times, first, last = hdf5_stream.time_index(io, name, self.chunk_bytes)
+
+        # Time-filter all but static objects
+        if self.selected_times(io) is not None and name != 'static':
+            keep = np.isin(times, self.times)
+            first, last = first[keep], last[keep]
+
+        columns = tuple(dataset.shape[1:])
+        ds = self.create_dataset(gr, obj, 'cf' if name == 'cf' else obj.name,
+                                 (0,) + columns, (None,) + columns,
+                                 getattr(obj, 'dtype', np.float64))
+        for a in obj.attrs:
+            if a != 'keyframe_interval':
+                ds.attrs[a] = obj.attrs[a]
+
+        dtype = ds.dtype
+        exclude = self.excluded_objects
+        ranges = hdf5_stream.time_ranges(
+            first, last, hdf5_stream.chunk_rows(dataset, self.chunk_bytes))
+        tasks = [(io.filename, name, hdf5_stream.segments(first[i:j], last[i:j]),
+                  exclude, dtype) for i, j in ranges]
+
+        progress = hdf5_stream.Progress(path, int(np.sum(last - first)),
+                                        stream=self.progress)
+        index = []
+        for (i, j), rows in zip(ranges, hdf5_stream.parallel_map(
+                hdf5_stream.read_segments, tasks, self.processes)):
+            n = ds.shape[0]
+            hdf5_stream.append_rows(ds, rows)
+            # new rows ranges of the steps
+            if rows.shape[0] > 0:
+                t = rows[:, 0]
+                change = np.concatenate(
+                    ([0], np.flatnonzero(t[1:] != t[:-1]) + 1))
+                bounds = np.append(change, len(t))
+                index.extend(zip(t[change], n + bounds[:-1], n + bounds[1:]))
+            progress.update(int(np.sum(last[i:j] - first[i:j])), rows.nbytes)
+        progress.done()
+        self.index[name] = np.array(index, dtype=float).reshape(-1, 3)
+
+    def copy(self, gr, obj):
+        """Copy a dataset by blocks of rows."""
+        if obj.shape is None or len(obj.shape) == 0:
+            ds = gr.create_dataset(obj.name, data = obj[()])
+        else:
+            ds = self.create_dataset(gr, obj, obj.name, obj.shape,
+                                     obj.maxshape, obj.dtype)
+            for a, b in hdf5_stream.row_ranges(
+                    0, obj.shape[0], hdf5_stream.chunk_rows(obj, self.chunk_bytes)):
+                ds[a:b] = obj[a:b]
+        self.copy_attrs(ds, obj)
+
     def visitor(self, path, obj):
         gr = io_out
         names = path.split('/')
@@ -79,12 +192,13 @@ class CopyVisitor(object):
             if id in self.excluded_objects:
                 return
 
-        # Get indexes of filtered times in data/dynamic
-        if (self.time_filter is not None
-              and (self.time_idx is None or self.times is None)):
-            dyn = obj.file['data/dynamic']
-            self.time_idx = self.time_filter(dyn[:,0]).nonzero()[0]
-            self.times = dyn[self.time_idx, 0]
+        # The compressed contact forces are copied as a whole, the
+        # time index of the filtered datasets is rewritten at the end
+        if path.startswith('data/cf_compressed/'):
+            return
+        if (len(names) == 3 and names[:2] == ['data', 'index']
+            and 'data/' + names[2] in filtered_datasets):
+            return
 
         # Create parent groups
         if len(names) > 1:
@@ -96,66 +210,11 @@ class CopyVisitor(object):
                     gr_in = io_in['/'.join(names[:i+1])]
                     self.copy_attrs(gr, gr_in)
 
-        # Determine chunks argument
-        if obj.__class__ == h5py.Dataset:
-            chunks = None
-            if (hasattr(obj, 'chunks')
-                and obj.chunks is not None
-                and np.all(np.array(obj.chunks) <= np.array(obj.shape))):
-                chunks = obj.chunks
-
-            shape = obj.shape
-            time_idx = None
-
-            # Filter current indexes
-            if path in ['data/cf', 'data/dynamic', 'data/velocities', 'data/static']:
-                if self.time_idx is not None:
-                    # Get indexes of corresponding times in current dataset
-                    if path == 'data/dynamic':
-                        time_idx = self.time_idx
-                    # Time-filter all but static objects
-                    elif path != 'data/static':
-                        time_idx = np.in1d(obj[:,0], self.times).nonzero()[0]
-
-                # Additionally remove any lines referencing excluded objects
-                if self.excluded_objects is not None:
-                    exclude = np.vectorize(lambda i: i in self.excluded_objects)
-                    ex_idx = exclude(obj[:,1]).nonzero()[0]
-                    if time_idx is None:
-                        time_idx = np.arange(obj.shape[0])
-                    time_idx = np.setdiff1d(time_idx, ex_idx)
-
-            # Shape of filtered dataset
-            if time_idx is not None:
-                shape = (len(time_idx),) + tuple(shape[1:])
-
-            # Create the dataset, supply compression and dtype
-            # arguments, possibly overridden by command line arguments
-            comp = ((obj.compression is True or args.gzip)
-                    and chunks is not None)
-            if comp:
-                chunks = (4000,) + tuple(obj.shape[1:])
-            ds = gr.create_dataset(obj.name,
-                                   dtype = [obj.dtype,'f4'][args.single],
-                                   shape = shape,
-                                   maxshape = obj.maxshape,
-                                   chunks = chunks,
-                                   compression = [obj.compression, True][comp],
-                                   compression_opts = [obj.compression_opts,9][comp],
-                                   shuffle = comp,
-                                   fletcher32 = obj.fletcher32)
-            self.copy_attrs(ds, obj)
-
-            # Copy the filtered or unfiltered dataset
-            if time_idx is not None:
-                if len(time_idx)==0:
-                    pass
-                elif len(time_idx)==1:
-                    ds[0,:] = obj[time_idx[0],:]
-                else:
-                    ds[:len(time_idx),:] = obj[time_idx,:]
-            else:
-                ds[:] = obj
+        if path in filtered_datasets or path == 'data/cf_compressed':
+            self.copy_filtered(gr, obj.file, path, obj)
+
+        elif obj.__class__ == h5py.Dataset:
+            self.copy(gr, obj)
 
         # Some groups might be empty but we copy them anyway for their attributes
         elif obj.__class__ == h5py.Group:
@@ -167,6 +226,17 @@ class CopyVisitor(object):
         else:
             print('Unknown type "{0}": {1}'.format(path, str(obj.__class__)))
 
+    def write_index(self, io_in, io_out):
+        """Write the time index of the filtered datasets."""
+        if 'data/index' not in io_in:
+            return
+        gr = io_out.require_group('data/index')
+        for name, index in self.index.items():
+            ds = gr.create_dataset(name, data = index, maxshape = (None, 3))
+            if name in io_in['data/index']:
+                for a in io_in['data/index'][name].attrs:
+                    ds.attrs[a] = io_in['data/index'][name].attrs[a]
+
 if __name__ == '__main__':
     if os.path.exists(args.fn_out[0]):
         print('Output file "{0}" already exists!'.format(args.fn_out[0]))
@@ -181,7 +251,6 @@ if __name__ == '__main__':
     class TimeFilter(object):
         def __init__(self):
             self.marker = None
-            self.last = None
         def __call__(self, t):
             res = True
             if args.end is not None:
@@ -189,20 +258,15 @@ if __name__ == '__main__':
             if args.start is not None:
                 res = res and t >= args.start
 
-            # Interval filter is true only for every arg.interval time index
+            # Interval filter is true only for every arg.interval time,
+            # it is called once per time step
             if res is True and self.marker is None:
                 self.marker = t
-            if args.interval is not None and self.marker is not None:
-                if self.last is None:
-                    if t >= self.marker:
-                        self.last = t
-                        self.marker += args.interval
-                    else:
-                        res = False
+            if args.interval is not None and res is True:
+                if t >= self.marker:
+                    self.marker += args.interval
                 else:
-                    if t > self.last:
-                        res = False
-                        self.last = None
+                    res = False
             return res
 
     class AttrFilter(object):
@@ -231,8 +295,12 @@ if __name__ == '__main__':
 
     with h5py.File(args.fns_in[0], mode='r') as io_in:
         with h5py.File(args.fn_out[0], mode='w') as io_out:
-            io_in.visititems(CopyVisitor(
+            visitor = CopyVisitor(
                 time_filter = TimeFilter(),
                 object_filter = lambda name,obj: not re_exclude(name),
                 attr_filter = args.attr and AttrFilter(args.attr),
-            ).visitor)
+                processes = args.processes,
+                chunk_bytes = int(args.chunk_size * 2**20),
+                progress = [sys.stderr, None][args.quiet])
+            io_in.visititems(visitor.visitor)
+            visitor.write_index(io_in, io_out)
@@ -3,7 +3,7 @@
 Description: Export a Siconos mechanics-IO HDF5 file in VTK format.
 """
 
-from siconos.io.vview import VView, VExportOptions
+from siconos.io.vview import VView, VExportOptions, export_parallel
 from siconos.io.mechanics_hdf5 import MechanicsHdf5
 
 if __name__=='__main__':
@@ -11,6 +11,11 @@ if __name__=='__main__':
     opts = VExportOptions()
     opts.parse()
 
+    if opts.processes > 1 and not opts.gen_para_script:
+        # time steps exported in parallel
+        export_parallel(opts)
+        exit(0)
+
     ## Options and config already loaded above
     with MechanicsHdf5(io_filename=opts.io_filename, mode='r') as io:
         vview = VView(io, opts)
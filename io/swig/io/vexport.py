@@ -290,7 +290,7 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
         ispos_data = io.static_data()
         idpos_data = io.dynamic_data()
         ivelo_data = io.velocities_data()
-        icf_data = io.contact_forces_data()[:]
+        icf_data = io.contact_forces_data()
 
         isolv_data = io.solver_data()
 
@@ -583,18 +583,26 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
                  contactor_instance_name].attrs['translation'],
                     io.instances()[instance_name][contactor_instance_name].attrs['orientation']))
 
-    pos_data = dpos_data[:].copy()
     spos_data = spos_data[:].copy()
-    velo_data = velo_data[:].copy()
 
     set_velocityv = build_set_velocity(data_connectors_v)
     set_translationv = build_set_translation(data_connectors_t)
     set_displacementv = build_set_displacement(data_connectors_d)
 
-    times = list(set(dpos_data[:, 0]))
-    times.sort()
+    # the rows of each time step are read lazily with the time index
+    times, pos_first, pos_last = io.time_index('dynamic')
+    times = list(times)
+    velo_index = io.time_index('velocities')
+    cf_index = io.time_index('cf')
 
-    contact_info_source = ContactInfoSource(cf_data)
+    def rows(dataset, index, time):
+        itimes, first, last = index
+        i = numpy.searchsorted(itimes, time)
+        if i < len(itimes) and itimes[i] == time:
+            return dataset[first[i]:last[i], :]
+        return numpy.empty((0, dataset.shape[1]))
+
+    contact_info_source = ContactInfoSource(None)
 
     pveloa = DataConnector(0)
     pvelob = DataConnector(0)
@@ -622,11 +630,12 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
         index = min(index, len(times) - 1)
 
         contact_info_source._time = times[index]
+        contact_info_source._data = rows(cf_data, cf_index, times[index])
 
         # fix: should be called by contact_source?
         contact_info_source.method()
 
-        id_t = numpy.where(pos_data[:, 0] == times[index])
+        pos_data = dpos_data[pos_first[index]:pos_last[index], :]
 
         if numpy.shape(spos_data)[0] > 0:
             set_positionv(spos_data[:, 1], spos_data[:, 2],
@@ -636,33 +645,34 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
                           spos_data[:, 7], spos_data[:, 8])
 
         set_positionv(
-            pos_data[id_t, 1], pos_data[id_t, 2], pos_data[id_t, 3],
-            pos_data[id_t, 4], pos_data[id_t, 5], pos_data[id_t, 6],
-            pos_data[id_t, 7], pos_data[id_t, 8])
-
-        id_tv = numpy.where(velo_data[:, 0] == times[index])
-
-        set_velocityv(
-            velo_data[id_tv, 1],
-            velo_data[id_tv, 2],
-            velo_data[id_tv, 3],
-            velo_data[id_tv, 4],
-            velo_data[id_tv, 5],
-            velo_data[id_tv, 6],
-            velo_data[id_tv, 7])
+            pos_data[:, 1], pos_data[:, 2], pos_data[:, 3],
+            pos_data[:, 4], pos_data[:, 5], pos_data[:, 6],
+            pos_data[:, 7], pos_data[:, 8])
+
+        velo_t = rows(velo_data, velo_index, times[index])
+
+        if velo_t.shape[0] > 0:
+            set_velocityv(
+                velo_t[:, 1],
+                velo_t[:, 2],
+                velo_t[:, 3],
+                velo_t[:, 4],
+                velo_t[:, 5],
+                velo_t[:, 6],
+                velo_t[:, 7])
 
         set_translationv(
-            pos_data[id_t, 1],
-            pos_data[id_t, 2],
-            pos_data[id_t, 3],
-            pos_data[id_t, 4],
+            pos_data[:, 1],
+            pos_data[:, 2],
+            pos_data[:, 3],
+            pos_data[:, 4],
         )
 
         # set_displacementv(
-        #     pos_data[id_t, 1],
-        #     pos_data[id_t, 2]- pos_data[0, 2],
-        #     pos_data[id_t, 3]- pos_data[0, 3],
-        #     pos_data[id_t, 4]- pos_data[0, 4]
+        #     pos_data[:, 1],
+        #     pos_data[:, 2]- pos_data[0, 2],
+        #     pos_data[:, 3]- pos_data[0, 3],
+        #     pos_data[:, 4]- pos_data[0, 4]
         # ) # should be w.r.t initial position
 
         big_data_writer.SetFileName('{0}-{1}.{2}'.format(os.path.splitext(
@@ -9,6 +9,7 @@ import sys
 import os
 import json
 import getopt
+import copy
 import math
 import traceback
 import vtk
@@ -388,6 +389,7 @@ class VExportOptions(VViewOptions):
         self.stride = 1
         self.nprocs = 1
         self.gen_para_script = False
+        self.processes = 1
 
     def usage(self, long=False):
         print(__doc__); print()
@@ -407,6 +409,7 @@ class VExportOptions(VViewOptions):
                                  (default: 1)
             --ascii              export file in ascii format
             --gen-para-script=n generation of a gnu parallel command for n processus
+            --processes=n        export the time steps with n processes
             """)
 
     def parse(self):
@@ -416,7 +419,7 @@ class VExportOptions(VViewOptions):
                                            ['help', 'version', 'ascii',
                                             'start-step=', 'end-step=',
                                             'stride=', 'global-filter',
-                                            'gen-para-script=',
+                                            'gen-para-script=', 'processes=',
                                             'depth-2d=', 'verbose='])
             self.configure(opts, args)
         except getopt.GetoptError as err:
@@ -444,6 +447,8 @@ class VExportOptions(VViewOptions):
             if o == '--gen-para-script':
                 self.gen_para_script = True
                 self.nprocs = int(a)
+            if o == '--processes':
+                self.processes = int(a)
             if o in ('--ascii'):
                 self.ascii_mode = True
             if o in ('--depth-2d'):
@@ -472,6 +477,7 @@ class VRawDataExportOptions(VViewOptions):
         self.start_step = 0
         self.end_step = None
         self.stride = 1
+        self.processes = 1
 
         self.io_filename = io_filename
     def usage(self, long=False):
@@ -493,6 +499,7 @@ class VRawDataExportOptions(VViewOptions):
             --no-export-velocity do not export position
             --export-cf          do export of contact friction data
             --export-velocity-in-absolute-frame          do export of contact friction data
+            --processes=n        read the file with n processes
 
             """)
 
@@ -506,7 +513,8 @@ class VRawDataExportOptions(VViewOptions):
                                             'no-export-position',
                                             'no-export-velocity',
                                             'export-cf',
-                                            'export-velocity-in-absolute-frame'])
+                                            'export-velocity-in-absolute-frame',
+                                            'processes='])
             self.configure(opts, args)
         except getopt.GetoptError as err:
                 sys.stderr.write('{0}\n'.format(str(err)))
@@ -536,6 +544,8 @@ class VRawDataExportOptions(VViewOptions):
                 self._export_cf = True
             if o == '--export-velocity-in-absolute-frame':
                 self._export_velocity_in_absolute_frame = True
+            if o == '--processes':
+                self.processes = int(a)
 
         if self.io_filename is  None:
             if len(args) > 0 :
@@ -961,24 +971,21 @@ class IOReader(VTKPythonAlgorithmBase):
         # The time step requested
         t = info.Get(vtk.vtkStreamingDemandDrivenPipeline.UPDATE_TIME_STEP())
 
+        # only the rows of the current frame are read
         id_t = max(0, numpy.searchsorted(self._times, t, side='right') - 1)
-        if id_t < len(self._indices)-1:
-            self._id_t_m = list(range(self._indices[id_t],
-                                      self._indices[id_t+1]))
-        else:
-            self._id_t_m = [self._indices[id_t]]
+        self._id_t_m = slice(self._indices[id_t], self._ends[id_t])
 
         self._time = self._times[id_t]
         self._index = id_t
         self.pos_data = self._idpos_data[self._id_t_m, :]
-        self.velo_data = self._ivelo_data[self._id_t_m, :]
+
+        velo_id_t = max(0, numpy.searchsorted(self._velo_times, t, side='right') - 1)
+        self.velo_data = self._ivelo_data[self._velo_indices[velo_id_t]:
+                                          self._velo_ends[velo_id_t], :]
 
         static_id_t = max(0, numpy.searchsorted(self._static_times, t, side='right') - 1)
-        if static_id_t < len(self._static_indices)-1:
-            self._static_id_t_m = list(range(self._static_indices[static_id_t],
-                                             self._static_indices[static_id_t+1]))
-        else:
-            self._static_id_t_m = [self._static_indices[static_id_t]]
+        self._static_id_t_m = slice(self._static_indices[static_id_t],
+                                    self._static_ends[static_id_t])
 
         self.pos_static_data = self._ispos_data[self._static_id_t_m, :]
 
@@ -1008,13 +1015,13 @@ class IOReader(VTKPythonAlgorithmBase):
                 if (id_t_cf > 0 and abs(t-self._cf_times[id_t_cf-1])
                     <= ctimestep):
                     if id_t_cf < ncfindices-1:
-                        self._id_t_m_cf = list(range(self._cf_indices[id_t_cf-1],
-                                                     self._cf_indices[id_t_cf]))
+                        self._id_t_m_cf = slice(self._cf_indices[id_t_cf-1],
+                                                self._cf_ends[id_t_cf-1])
                         self.cf_data = self._icf_data[self._id_t_m_cf, :]
 
                     else:
                         self.cf_data = self._icf_data[self._cf_indices[
-                            id_t_cf]:, :]
+                            id_t_cf]:self._cf_ends[id_t_cf], :]
 
                     self._cf_time = self._cf_times[id_t_cf]
 
@@ -1154,20 +1161,23 @@ class IOReader(VTKPythonAlgorithmBase):
         self._isolv_data = self._io.solver_data()
         self._ivelo_data = self._io.velocities_data()
 
-        self._spos_data = self._ispos_data[:, :]
-
-        # all times as hdf5 slice
-        self._raw_times = self._idpos_data[:, 0]
-
-        # build times steps
-        self._times, self._indices = numpy.unique(self._raw_times,
-                                                  return_index=True)
-        # all times as hdf5 slice for static objects
-        self._static_raw_times = self._ispos_data[:, 0]
-
-        # build times steps for static objects
-        self._static_times, self._static_indices = numpy.unique(self._static_raw_times,
-                                                                return_index=True)
+        # times steps and rows ranges, from the time index written by
+        # the runner, the datasets are read lazily in RequestData
+        self._times, self._indices, self._ends = \
+            self._io.time_index('dynamic')
+        self._velo_times, self._velo_indices, self._velo_ends = \
+            self._io.time_index('velocities')
+
+        # times steps for static objects
+        self._static_times, self._static_indices, self._static_ends = \
+            self._io.time_index('static')
+
+        # initial positions of static objects: the first time step only
+        if len(self._static_times) > 0:
+            self._spos_data = self._ispos_data[self._static_indices[0]:
+                                               self._static_ends[0], :]
+        else:
+            self._spos_data = numpy.empty((0, self._ispos_data.shape[1]))
         dcf = self._times[1:]-self._times[:-1]
         self._avg_timestep = numpy.mean(dcf)
         self._min_timestep = numpy.min(dcf)
@@ -1200,11 +1210,9 @@ class IOReader(VTKPythonAlgorithmBase):
         # contact forces provider
     def ContactForcesOn(self):
 
-        self._cf_raw_times = self._icf_data[:, 0]
-        self._cf_times, self._cf_indices = numpy.unique(self._cf_raw_times,
-                                                        return_index=True)
-        self._mu_coefs = numpy.unique(self._icf_data[:, 1],
-                                      return_index=False)
+        self._cf_times, self._cf_indices, self._cf_ends = \
+            self._io.time_index('cf')
+        self._mu_coefs = self._io.contact_forces_mu()
 
         self.cpa_at_time = dict()
         self.cpa = dict()
@@ -2733,150 +2741,112 @@ class VView(object):
             big_data_writer.Write()
 
     def export_raw_data(self):
-
-        times = self.io_reader._times[
-                self.opts.start_step:self.opts.end_step:self.opts.stride]
-        ntime = len(times)
+        """
+        Export positions, velocities and contact forces in text files,
+        one per body or contact. The datasets are read by blocks of
+        time steps, in parallel with opts.processes, and the files
+        are written incrementally.
+        """
+        basename = os.path.splitext(os.path.basename(self.opts.io_filename))[0]
         export_2d = False
         if self.io.dimension() ==2 :
             export_2d=True
             print('We export raw data for 2D object')
-        # export
-        k = self.opts.start_step
-        packet = int(ntime/100)+1
-
-        # ######## position output ########
-
-        # nvalue = ndyna*7+1
-
-        # position_output = numpy.empty((ntime,nvalue))
-        # #print('position_output shape', numpy.shape(position_output))
-        # position_output[:,0] = times[:]
-        position_output = {}
-        velocity_output = {}
-        velocity_absolute_output = {}
-
-        for time in times:
-            k = k + self.opts.stride
-            if (k % packet == 0):
-                sys.stdout.write('.')
-            self.io_reader.SetTime(time)
-
-            pos_data = self.io_reader.pos_data
-            velo_data = self.io_reader.velo_data
-
-            ndyna=pos_data.shape[0]
-
-
-            for i in range(ndyna):
-                bdy_id = int(pos_data[i,1])
-
-                ######## position output ########
-                if self.opts._export_position :
-                    nvalue=pos_data.shape[1]
-                    position_output_bdy = position_output.get(bdy_id)
-                    if position_output_bdy is None:
-                        position_output[bdy_id] = []
-                    position_output_body =  position_output[bdy_id]
-                    position_output_body.append([])
-                    position_output_body[-1].append(time)
-                    if export_2d:
-                        data_2d =  [pos_data[i,2],pos_data[i,3],numpy.acos(pos_data[i,5]/2.0)]
-                        position_output_body[-1].extend(data_2d)
-                        #position_output_body[-1].extend(pos_data[i,2:nvalue])
-                    else:
-                        position_output_body[-1].extend(pos_data[i,2:nvalue])
-                    position_output_body[-1].append(bdy_id)
-
-
-                ######## velocity output ########
-                if self.opts._export_velocity :
-                    nvalue=velo_data.shape[1]
-                    velocity_output_bdy = velocity_output.get(bdy_id)
-                    if velocity_output_bdy is None:
-                        velocity_output[bdy_id] = []
-                    velocity_output_body =  velocity_output[bdy_id]
-                    velocity_output_body.append([])
-                    velocity_output_body[-1].append(time)
-                    velocity_output_body[-1].extend(velo_data[i,2:nvalue])
-                    velocity_output_body[-1].append(bdy_id)
-
-                ######## velocity in absolute frame output ########
-                if self.opts._export_velocity_in_absolute_frame :
-                    nvalue=velo_data.shape[1]
-                    [q1,q2,q3,q4] = pos_data[i,5:9]
-                    q = Quaternion((q1, q2, q3, q4))
-                    velo = q.rotate(velo_data[i,5:8])
-                    velocity_absolute_output_bdy = velocity_absolute_output.get(bdy_id)
-                    if velocity_absolute_output_bdy is None:
-                        velocity_absolute_output[bdy_id] = []
-                    velocity_absolute_output_body =  velocity_absolute_output[bdy_id]
-                    velocity_absolute_output_body.append([])
-                    velocity_absolute_output_body[-1].append(time)
-                    velocity_absolute_output_body[-1].extend(velo_data[i,2:5])
-                    velocity_absolute_output_body[-1].extend(velo[:])
-                    velocity_absolute_output_body[-1].append(bdy_id)
-
-        for bdy_id in position_output.keys():
-            output = numpy.array(position_output[bdy_id])
-            filename_output = '{0}-position-body_{1}.dat'.format(
-                os.path.splitext(os.path.basename(self.opts.io_filename))[0],
-            bdy_id)
-            numpy.savetxt(filename_output, output)
-
-        for bdy_id in velocity_output.keys():
-            output = numpy.array(velocity_output[bdy_id])
-            filename_output = '{0}-velocity-body_{1}.dat'.format(
-                os.path.splitext(os.path.basename(self.opts.io_filename))[0],
-            bdy_id)
-            numpy.savetxt(filename_output, output)
-
-        for bdy_id in velocity_absolute_output.keys():
-            output = numpy.array(velocity_absolute_output[bdy_id])
-            filename_output = '{0}-velocity-absolute-body_{1}.dat'.format(
-                os.path.splitext(os.path.basename(self.opts.io_filename))[0],
-            bdy_id)
-            numpy.savetxt(filename_output, output)
-
-        cf_output = {}
-        for time in times:
-            #print('time', time)
-            k = k + self.opts.stride
-            if (k % packet == 0):
-                sys.stdout.write('.')
-
-            self.io_reader.SetTime(time)
-
-            cf_data = self.io_reader.cf_data
-            #print('cf_data', cf_data)
-
-            if cf_data is not None and self.opts._export_cf :
-                ncontact=cf_data.shape[0]
-
-                for i in range(ncontact):
-                    contact_id = int(cf_data[i,23])
-                    #print('contact_id', contact_id)
-                    ######## contact output ########
-                    nvalue=cf_data.shape[1]
-                    cf_output_contact = cf_output.get(contact_id)
-                    if cf_output_contact is None:
-                        cf_output[contact_id] = []
-                    cf_output_contact =  cf_output[contact_id]
-                    cf_output_contact.append([])
-                    cf_output_contact[-1].append(time)
-                    cf_output_contact[-1].extend(cf_data[i,2:nvalue])
-                    cf_output_contact[-1].append(contact_id)
-
-        for contact_id in cf_output.keys():
-            output = numpy.array(cf_output[contact_id])
-            filename_output = '{0}-cf-contact_{1}.dat'.format(
-                os.path.splitext(os.path.basename(self.opts.io_filename))[0],
-            contact_id)
-            numpy.savetxt(filename_output, output)
-
-
-        sys.stdout.write('\n')
 
+        # rows of the exported time steps in each table
+        names = ['dynamic']
+        if self.opts._export_velocity or \
+           self.opts._export_velocity_in_absolute_frame:
+            names.append('velocities')
+        if self.opts._export_cf:
+            names.append('cf')
+        index = {}
+        times = None
+        for name in names:
+            t, first, last = self.io.time_index(name)
+            if times is None:
+                steps = slice(self.opts.start_step, self.opts.end_step,
+                              self.opts.stride)
+                t, first, last = t[steps], first[steps], last[steps]
+                times = t
+            else:
+                keep = numpy.isin(t, times)
+                t, first, last = t[keep], first[keep], last[keep]
+            index[name] = t, first, last
+
+        # blocks of time steps, as the blocks of rows of positions
+        t, first, last = index['dynamic']
+        ranges = hdf5_stream.time_ranges(
+            first, last, hdf5_stream.chunk_rows(self.io.dynamic_data()))
+        tasks = []
+        for i, j in ranges:
+            task = []
+            for name in names:
+                nt, nfirst, nlast = index[name]
+                a = numpy.searchsorted(nt, t[i], side='left')
+                b = numpy.searchsorted(nt, t[j-1], side='right')
+                task.append((name, hdf5_stream.segments(nfirst[a:b],
+                                                        nlast[a:b])))
+            tasks.append((self.opts.io_filename, task))
+
+        tables = hdf5_stream.TextTables()
+        def write(kind, rows, column):
+            for key, block in hdf5_stream.group_by(rows, column):
+                tables.append('{0}-{1}_{2}.dat'.format(
+                    basename, kind, int(key)), block)
+
+        progress = hdf5_stream.Progress('export', int(numpy.sum(last - first)))
+        for data in hdf5_stream.parallel_map(hdf5_stream.read_tables, tasks,
+                                             self.opts.processes):
+            data = dict(zip(names, data))
+            pos_data = data['dynamic']
+
+            ######## position output ########
+            if self.opts._export_position:
+                if export_2d:
+                    output = numpy.column_stack(
+                        (pos_data[:, 0], pos_data[:, 2], pos_data[:, 3],
+                         numpy.arccos(pos_data[:, 5]/2.0), pos_data[:, 1]))
+                else:
+                    output = numpy.column_stack(
+                        (pos_data[:, 0], pos_data[:, 2:], pos_data[:, 1]))
+                write('position-body', output, -1)
+
+            ######## velocity output ########
+            if self.opts._export_velocity:
+                velo_data = data['velocities']
+                write('velocity-body', numpy.column_stack(
+                    (velo_data[:, 0], velo_data[:, 2:], velo_data[:, 1])), -1)
+
+            ######## velocity in absolute frame output ########
+            if self.opts._export_velocity_in_absolute_frame:
+                velo_data = data['velocities']
+                # orientation of the body at the same time step
+                ids = pos_data[:, 1].max() + 1 if len(pos_data) else 1
+                pkeys = numpy.searchsorted(times, pos_data[:, 0]) * ids \
+                    + pos_data[:, 1]
+                vkeys = numpy.searchsorted(times, velo_data[:, 0]) * ids \
+                    + velo_data[:, 1]
+                order = numpy.argsort(pkeys)
+                q = pos_data[order[numpy.searchsorted(pkeys[order], vkeys)],
+                             5:9]
+                # rotation by the unit quaternion q = (w, u)
+                w, u, v = q[:, :1], q[:, 1:], velo_data[:, 5:8]
+                uv = numpy.cross(u, v)
+                velo = v + 2 * w * uv + 2 * numpy.cross(u, uv)
+                write('velocity-absolute-body', numpy.column_stack(
+                    (velo_data[:, 0], velo_data[:, 2:5], velo,
+                     velo_data[:, 1])), -1)
+
+            ######## contact output ########
+            if self.opts._export_cf:
+                cf_data = data['cf']
+                write('cf-contact', numpy.column_stack(
+                    (cf_data[:, 0], cf_data[:, 2:], cf_data[:, 23])), -1)
+
+            progress.update(pos_data.shape[0], sum(d.nbytes for d in data.values()))
+        tables.flush()
+        progress.done()
 
     def initialize_vtk(self):
         self.print_verbose('initialize_vtk')
@@ -3011,8 +2981,52 @@ from siconos.io.mechanics_hdf5 import MechanicsHdf5
 from siconos.io.mechanics_hdf5 import tmpfile as io_tmpfile
 from siconos.io.mechanics_hdf5 import occ_topo_list, occ_load_file,\
     topods_shape_reader, brep_reader
+from siconos.io import hdf5_stream
 
 nan = numpy.nan
+
+
+def export_steps(opts):
+    """
+    Worker: export in VTK format the time steps
+    opts.start_step:opts.end_step:opts.stride, returns the number of
+    steps exported.
+    """
+    with MechanicsHdf5(io_filename=opts.io_filename, mode='r') as io:
+        vview = VView(io, opts)
+        vview.initialize_vtk()
+        vview.export()
+        return len(vview.io_reader._times[
+            opts.start_step:opts.end_step:opts.stride])
+
+
+def export_parallel(opts):
+    """
+    Export in VTK format with opts.processes processes, each one
+    exporting consecutive time steps. The files are named as with
+    a single process.
+    """
+    with h5py.File(opts.io_filename, mode='r') as f:
+        nsteps = len(hdf5_stream.time_index(f, 'dynamic')[0])
+    end_step = nsteps if opts.end_step is None else min(opts.end_step, nsteps)
+    steps = list(range(opts.start_step, end_step, opts.stride))
+
+    # ranges of steps aligned on the stride
+    tasks = []
+    bounds = numpy.linspace(0, len(steps), opts.processes + 1).astype(int)
+    for a, b in zip(bounds[:-1], bounds[1:]):
+        if b > a:
+            task = copy.copy(opts)
+            task.start_step = steps[a]
+            task.end_step = steps[b - 1] + 1
+            tasks.append(task)
+
+    progress = hdf5_stream.Progress('export', len(steps), stream=sys.stdout)
+    for n in hdf5_stream.parallel_map(export_steps, tasks, opts.processes):
+        progress.update(n)
+    progress.done()
+
+
 if __name__=='__main__':
     ## Options and config already loaded above
     with MechanicsHdf5(io_filename=opts.io_filename, mode='r') as io:
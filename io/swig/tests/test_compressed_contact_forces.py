@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+
+#
+# Write contact forces in the compressed, delta-encoded format and
+# read them back as the 'cf' dataset.
+#
+
+import os
+import tempfile
+
+import numpy
+
+from siconos.io.mechanics_hdf5 import MechanicsHdf5, CompressedContactForces
+
+
+def contact_steps(nsteps=250, ncontacts=200):
+    """rows of the 'cf' dataset for contacts that slide slowly, with
+    births and deaths"""
+    rng = numpy.random.RandomState(0)
+    ids = numpy.arange(ncontacts, dtype=float)
+    points = rng.normal(size=(ncontacts, 9))
+    next_id = ncontacts
+    steps = []
+    for k in range(nsteps):
+        alive = rng.random_sample(len(ids)) > 0.02
+        born = rng.randint(0, 5)
+        ids = numpy.concatenate((ids[alive], next_id + numpy.arange(born)))
+        points = numpy.concatenate((points[alive],
+                                    rng.normal(size=(born, 9))))
+        points += 1e-3 * rng.normal(size=points.shape)
+        next_id += born
+
+        rows = numpy.zeros((len(ids), 26))
+        rows[:, 0] = k * 1e-3
+        rows[:, 1] = 0.3
+        rows[:, 2:11] = points
+        rows[:, 11:23] = rng.normal(size=(len(ids), 12))
+        rows[:, 23] = ids
+        rows[:, 24] = ids % 7
+        rows[:, 25] = 0
+        steps.append(rows[rng.permutation(len(ids))])
+    return steps
+
+
+def check_format(float32, tol):
+    steps = contact_steps()
+    expected = numpy.concatenate(steps)
+    _, filename = tempfile.mkstemp(suffix='.hdf5')
+    try:
+        with MechanicsHdf5(io_filename=filename, mode='w',
+                           compress_contact_forces=True,
+                           contact_forces_float32=float32) as io:
+            cf = io.contact_forces_data()
+            assert isinstance(cf, CompressedContactForces)
+            for rows in steps:
+                first = cf.shape[0]
+                cf.append(rows[0, 0], rows)
+                io.add_time_index('cf', rows[0, 0], first, cf.shape[0],
+                                  mu=rows[:, 1])
+
+        with MechanicsHdf5(io_filename=filename, mode='r') as io:
+            cf = io.contact_forces_data()
+            assert cf.shape == expected.shape
+            assert numpy.allclose(cf[:], expected, rtol=0, atol=tol)
+
+            # one time step, as read by vview
+            times, first, last = io.time_index('cf')
+            assert len(times) == len(steps)
+            i = len(steps) - 3
+            assert numpy.allclose(cf[first[i]:last[i], :],
+                                  expected[first[i]:last[i]],
+                                  rtol=0, atol=tol)
+            assert numpy.allclose(cf[first[i]:last[i], 14],
+                                  expected[first[i]:last[i], 14],
+                                  rtol=0, atol=tol)
+            assert numpy.allclose(cf[-1], expected[-1], rtol=0, atol=tol)
+            assert numpy.array_equal(io.contact_forces_mu(), [0.3])
+    finally:
+        os.remove(filename)
+
+
+def test_compressed_contact_forces():
+    check_format(float32=False, tol=1e-12)
+
+
+def test_compressed_contact_forces_float32():
+    check_format(float32=True, tol=1e-5)
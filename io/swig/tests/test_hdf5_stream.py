@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+
+#
+# Read a result file by blocks of time steps of bounded size, in
+# parallel, as the post-processing tools do.
+#
+
+import os
+import tempfile
+
+import numpy
+import h5py
+
+from siconos.io import hdf5_stream
+
+
+def write_file(filename, nsteps=120):
+    """a file with a 'dynamic' dataset of a variable number of rows
+    per step, with and without time index"""
+    rng = numpy.random.RandomState(0)
+    steps = []
+    for k in range(nsteps):
+        n = rng.randint(0, 40)
+        rows = rng.normal(size=(n, 9))
+        rows[:, 0] = k * 1e-3
+        rows[:, 1] = rng.randint(1, 10, n)
+        steps.append(rows)
+    rows = numpy.concatenate(steps)
+    counts = numpy.array([len(s) for s in steps])
+    with h5py.File(filename, mode='w') as f:
+        f.create_dataset('data/dynamic', data=rows, maxshape=(None, 9),
+                         chunks=(64, 9))
+        f.create_dataset('data/cf', data=rows, maxshape=(None, 9),
+                         chunks=(64, 9))
+        last = numpy.cumsum(counts)[counts > 0]
+        first = last - counts[counts > 0]
+        times = numpy.arange(nsteps)[counts > 0] * 1e-3
+        f.create_dataset('data/index/dynamic',
+                         data=numpy.stack((times, first, last), axis=1))
+    return rows
+
+
+def test_hdf5_stream():
+    _, filename = tempfile.mkstemp(suffix='.hdf5')
+    try:
+        rows = write_file(filename)
+        with h5py.File(filename, mode='r') as f:
+            # time index written by the runner and read from the
+            # time column by blocks of rows
+            index = hdf5_stream.time_index(f, 'dynamic')
+            computed = hdf5_stream.time_index(f, 'cf', chunk_bytes=100 * 72)
+            for a, b in zip(index, computed):
+                assert numpy.array_equal(a, b)
+            times, first, last = index
+
+            assert hdf5_stream.searchsorted(f['data/cf'], times[10]) == first[10]
+            assert hdf5_stream.searchsorted_time(f, 'dynamic', times[10]) == first[10]
+            max_rows = hdf5_stream.chunk_rows(f['data/dynamic'],
+                                              chunk_bytes=100 * 72)
+            assert max_rows == 64
+
+        # every other step, without the object 3, by blocks of at most
+        # max_rows rows read by 2 processes
+        keep = slice(None, None, 2)
+        first, last = first[keep], last[keep]
+        ranges = hdf5_stream.time_ranges(first, last, max_rows)
+        assert all(j - i == 1 or last[i:j].sum() - first[i:j].sum() <= max_rows
+                   for i, j in ranges)
+        tasks = [(filename, 'dynamic',
+                  hdf5_stream.segments(first[i:j], last[i:j]),
+                  [3.], numpy.float32) for i, j in ranges]
+        result = numpy.concatenate(list(hdf5_stream.parallel_map(
+            hdf5_stream.read_segments, tasks, processes=2)))
+
+        expected = rows[numpy.isin(rows[:, 0], times[keep]) & (rows[:, 1] != 3)]
+        assert result.dtype == numpy.float32
+        assert numpy.allclose(result, expected, rtol=1e-6)
+
+        # maximum difference of a dataset with itself
+        tasks = [(filename, filename, 'dynamic', a, a, b - a, None)
+                 for a, b in hdf5_stream.row_ranges(0, rows.shape[0], 50)]
+        assert max(hdf5_stream.parallel_map(hdf5_stream.max_difference,
+                                            tasks, processes=1)) == 0.
+    finally:
+        os.remove(filename)
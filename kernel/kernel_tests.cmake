@@ -11,6 +11,13 @@ if(WITH_TESTING)
     DEPS "numerics;CPPUNIT::CPPUNIT;externals"
     )
 
+  # microbenchmark of the dense products (checks results against ublas)
+  new_test(
+    NAME ProdBenchmark
+    SOURCES ProdBenchmark.cpp
+    DEPS "numerics;externals"
+    )
+
   # ---- Siconos Memory tests ----
   begin_tests(src/utils/SiconosMemory/test)
 
@@ -52,6 +59,11 @@ if(WITH_TESTING)
   # ---- Simulation tools ---
   begin_tests(src/simulationTools/test DEPS "numerics;CPPUNIT::CPPUNIT")
   new_test(SOURCES OSNSPTest.cpp ${SIMPLE_TEST_MAIN})
+  if(WITH_OPENMP)
+    # several threads for the parallel computation of the blocks
+    set_property(TEST OSNSPTest APPEND PROPERTY ENVIRONMENT OMP_NUM_THREADS=4)
+  endif()
+  new_test(SOURCES InteractionsGraphSnapshotTest.cpp ${SIMPLE_TEST_MAIN})
   new_test(SOURCES testAVI.cpp ${SIMPLE_TEST_MAIN} DEPS LAPACK::LAPACK)
   if(HAS_FORTRAN)
     new_test(SOURCES ZOHTest.cpp ${SIMPLE_TEST_MAIN} DEPS LAPACK::LAPACK)
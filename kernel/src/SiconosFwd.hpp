@@ -108,6 +108,7 @@ DEFINE_SPTR(SiconosVector)
 DEFINE_SPTR(BlockVector)
 
 DEFINE_SPTR(OSNSMatrix)
+DEFINE_SPTR(InteractionsGraphSnapshot)
 
 DEFINE_SPTR(SiconosMemory)
 
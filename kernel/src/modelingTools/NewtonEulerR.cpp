@@ -246,8 +246,41 @@ void NewtonEulerR::computeJachqT(Interaction& inter, SP::BlockVector q0)
   DEBUG_PRINTF("with inter =  %p\n",&inter);
   DEBUG_EXPR(inter.display());
 
-  unsigned int k = 0;
   unsigned int ySize = inter.dimension();
+
+  if(_jachq->num() == Siconos::DENSE && _jachqT->num() == Siconos::DENSE)
+  {
+    // Fixed-size kernel on the column-major storages, the block of T
+    // for a body is [I 0; 0 Tq] with Tq the 4x3 block of the quaternion.
+    const double* jachq = _jachq->getArray();
+    double* jachqT = _jachqT->getArray();
+    const unsigned int ldq = _jachq->size(0);
+    const unsigned int ldqT = _jachqT->size(0);
+
+    for(unsigned int i = 0; i < q0->numberOfBlocks(); i++)
+    {
+      computeT((q0->getAllVect())[i], _T);
+      DEBUG_EXPR(_T->display());
+      const double* T = _T->getArray();
+
+      const double* Jq = jachq + 7 * i * ldq;
+      double* JqT = jachqT + 6 * i * ldqT;
+      for(unsigned int c = 0; c < 3; ++c)
+        for(unsigned int r = 0; r < ySize; ++r)
+          JqT[c * ldqT + r] = Jq[c * ldq + r];
+      for(unsigned int c = 3; c < 6; ++c)
+        for(unsigned int r = 0; r < ySize; ++r)
+          JqT[c * ldqT + r] = Jq[3 * ldq + r] * T[c * 7 + 3]
+                              + Jq[4 * ldq + r] * T[c * 7 + 4]
+                              + Jq[5 * ldq + r] * T[c * 7 + 5]
+                              + Jq[6 * ldq + r] * T[c * 7 + 6];
+    }
+    DEBUG_EXPR(_jachqT->display());
+    DEBUG_END("NewtonEulerR::computeJachqT(Interaction& inter, SP::BlockVector q0) \n");
+    return;
+  }
+
+  unsigned int k = 0;
   SP::SimpleMatrix auxBloc(new SimpleMatrix(ySize, 7));
   SP::SimpleMatrix auxBloc2(new SimpleMatrix(ySize, 6));
   Index dimIndex(2);
@@ -23,7 +23,11 @@
 #include <functional>
 using namespace std::placeholders;
 
+#include <algorithm>
+#include <exception>
 #include <limits>
+#include <typeindex>
+#include <vector>
 
 // #define DEBUG_NOCOLOR
 // #define DEBUG_MESSAGES
@@ -274,33 +278,91 @@ void NonSmoothDynamicalSystem::updateOutput(double time, unsigned int level_min,
   }
 }
 
-void NonSmoothDynamicalSystem::computeInteractionJacobians(double time)
+/* Jacobians of the interactions of an index set. With OpenMP, the
+ * NewtonEuler relations (rigid bodies joints and contacts) are sorted
+ * by relation type, so that each thread runs the same kernel on
+ * consecutive interactions, and evaluated in parallel. The
+ * interactions sharing a relation are evaluated by the same thread.
+ * The other relations may call user plugins and are evaluated
+ * serially. */
+static void computeJacobians(double time, InteractionsGraph& indexSet)
 {
-
-  DEBUG_BEGIN("NonSmoothDynamicalSystem::computeInteractionJacobians(double time)\n");
   InteractionsGraph::VIterator ui, uiend;
-  SP::Interaction inter;
-  SP::InteractionsGraph indexSet0 = _topology->indexSet0();
-  for(std::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+#ifdef _OPENMP
+  typedef std::pair<Relation*, Interaction*> RelationInteraction;
+  std::vector<RelationInteraction> batch;
+  for(std::tie(ui, uiend) = indexSet.vertices(); ui != uiend; ++ui)
   {
-    inter = indexSet0->bundle(*ui);
-    inter->relation()->computeJach(time, *inter);
-    inter->relation()->computeJacg(time, *inter);
+    Interaction& inter = *indexSet.bundle(*ui);
+    Relation& relation = *inter.relation();
+    if(relation.getType() == NewtonEuler)
+      batch.push_back(RelationInteraction(&relation, &inter));
+    else
+    {
+      relation.computeJach(time, inter);
+      relation.computeJacg(time, inter);
+    }
   }
+
+  std::stable_sort(batch.begin(), batch.end(),
+                   [](const RelationInteraction& a, const RelationInteraction& b)
+  {
+    std::type_index ta(typeid(*a.first)), tb(typeid(*b.first));
+    return ta < tb || (ta == tb && a.first < b.first);
+  });
+
+  // one task per relation
+  std::vector<unsigned int> tasks;
+  for(unsigned int i = 0; i < batch.size(); ++i)
+  {
+    if(i == 0 || batch[i].first != batch[i-1].first)
+      tasks.push_back(i);
+  }
+  tasks.push_back(batch.size());
+
+  // exceptions must not escape the parallel region
+  std::exception_ptr error;
+  int ntasks = (int)tasks.size() - 1;
+  #pragma omp parallel for schedule(static)
+  for(int k = 0; k < ntasks; ++k)
+  {
+    try
+    {
+      for(unsigned int i = tasks[k]; i < tasks[k+1]; ++i)
+      {
+        batch[i].first->computeJach(time, *batch[i].second);
+        batch[i].first->computeJacg(time, *batch[i].second);
+      }
+    }
+    catch(...)
+    {
+      #pragma omp critical
+      error = std::current_exception();
+    }
+  }
+  if(error)
+    std::rethrow_exception(error);
+#else
+  for(std::tie(ui, uiend) = indexSet.vertices(); ui != uiend; ++ui)
+  {
+    Interaction& inter = *indexSet.bundle(*ui);
+    inter.relation()->computeJach(time, inter);
+    inter.relation()->computeJacg(time, inter);
+  }
+#endif
+}
+
+void NonSmoothDynamicalSystem::computeInteractionJacobians(double time)
+{
+  DEBUG_BEGIN("NonSmoothDynamicalSystem::computeInteractionJacobians(double time)\n");
+  computeJacobians(time, *_topology->indexSet0());
   DEBUG_END("NonSmoothDynamicalSystem::computeInteractionJacobians(double time)\n");
 }
 
 void NonSmoothDynamicalSystem::computeInteractionJacobians(double time, InteractionsGraph& indexSet)
 {
   DEBUG_BEGIN("NonSmoothDynamicalSystem::computeInteractionJacobians(double time)\n");
-  InteractionsGraph::VIterator ui, uiend;
-  SP::Interaction inter;
-  for(std::tie(ui, uiend) = indexSet.vertices(); ui != uiend; ++ui)
-  {
-    inter = indexSet.bundle(*ui);
-    inter->relation()->computeJach(time, *inter);
-    inter->relation()->computeJacg(time, *inter);
-  }
+  computeJacobians(time, indexSet);
   DEBUG_END("NonSmoothDynamicalSystem::computeInteractionJacobians(double time)\n");
 }
 
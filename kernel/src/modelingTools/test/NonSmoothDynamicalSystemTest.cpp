@@ -18,6 +18,7 @@
 #include "NonSmoothDynamicalSystemTest.hpp"
 #include "LagrangianLinearTIR.hpp"
 #include "NewtonImpactNSL.hpp"
+#include "Topology.hpp"
 
 #define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
             if ((alpha) == (omega)) CPPUNIT_FAIL(message);
@@ -181,3 +182,74 @@ void NonSmoothDynamicalSystemTest::testremoveInteraction()
 
   std::cout << "------- test removeInteraction ok -------" <<std::endl;
 }
+
+void NonSmoothDynamicalSystemTest::testTopologyLookup()
+{
+  SP::NonSmoothDynamicalSystem  nsds(new NonSmoothDynamicalSystem(0., 10.));
+  SP::Topology topo = nsds->topology();
+
+  SP::DynamicalSystem ds1(new LagrangianDS(std::make_shared<SiconosVector>(3),
+                          std::make_shared<SiconosVector>(3)));
+  ds1->setNumber(23);
+  SP::DynamicalSystem ds2(new LagrangianDS(std::make_shared<SiconosVector>(3),
+                          std::make_shared<SiconosVector>(3)));
+  ds2->setNumber(32);
+
+  nsds->insertDynamicalSystem(ds1);
+  nsds->insertDynamicalSystem(ds2);
+  topo->setName(ds1, "ds1");
+  topo->setName(ds2, "ds2");
+
+  SP::Relation r1(new LagrangianLinearTIR(std::make_shared<SimpleMatrix>(1,3)));
+  SP::Relation r2(new LagrangianLinearTIR(std::make_shared<SimpleMatrix>(1,6)));
+  SP::NonSmoothLaw nsl(new NewtonImpactNSL(0.0));
+  SP::Interaction inter1(new Interaction(nsl, r1));
+  SP::Interaction inter2(new Interaction(nsl, r2));
+  nsds->link(inter1, ds1);
+  nsds->link(inter2, ds1, ds2);
+  topo->setName(inter1, "inter1");
+  topo->setName(inter2, "inter2");
+
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupA: ", topo->getDynamicalSystem(23) == ds1, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupB: ", topo->getDynamicalSystem("ds2") == ds2, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupC: ", topo->getInteraction(inter2->number()) == inter2, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupD: ", topo->getInteraction("inter1") == inter1, true);
+
+  std::vector<unsigned int> numbers = {32, 1000, 23};
+  std::vector<SP::DynamicalSystem> dss = topo->getDynamicalSystems(numbers);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupE: ", dss.size() == 3, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupF: ", dss[0] == ds2 && !dss[1] && dss[2] == ds1, true);
+
+  // renaming
+  topo->setName(ds1, "body");
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupG: ", topo->getDynamicalSystem("body") == ds1, true);
+  try
+  {
+    topo->getDynamicalSystem("ds1");
+    CPPUNIT_FAIL("testTopologyLookupH: ds1 must not be found anymore");
+  }
+  catch(const Siconos::exception& e)
+  {
+    /*  Pass */
+  }
+
+  // removal of a ds removes its interactions from the lookup tables
+  nsds->removeDynamicalSystem(ds2);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupI: ", !topo->getInteraction("inter2"), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupJ: ", !topo->getInteraction(inter2->number()), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupK: ", topo->getInteraction("inter1") == inter1, true);
+
+  nsds->removeInteraction(inter1);
+  std::vector<unsigned int> inumbers = {inter1->number()};
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupL: ", !topo->getInteractions(inumbers)[0], true);
+
+  // as many interactions added as removed since the last lookup
+  SP::Interaction inter3(new Interaction(nsl, r1));
+  nsds->link(inter3, ds1);
+  topo->setName(inter3, "inter3");
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupM: ", topo->getInteraction(inter3->number()) == inter3, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupN: ", !topo->getInteraction(inter1->number()), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testTopologyLookupO: ", topo->getInteraction("inter3") == inter3, true);
+
+  std::cout << "------- test topology lookup ok -------" <<std::endl;
+}
@@ -40,6 +40,7 @@ private:
   CPPUNIT_TEST(testinsertInteraction);
   CPPUNIT_TEST(testremoveDynamicalSystem);
   CPPUNIT_TEST(testremoveInteraction);
+  CPPUNIT_TEST(testTopologyLookup);
   CPPUNIT_TEST_SUITE_END();
 
   // \todo exception test
@@ -48,6 +49,7 @@ private:
   void testinsertInteraction();
   void testremoveDynamicalSystem();
   void testremoveInteraction();
+  void testTopologyLookup();
 
 public:
   void setUp();
@@ -187,6 +187,28 @@ void EventsManager::scheduleNonSmoothEvent(Simulation& sim, double time, bool ye
   mpz_clear(delta_time);
 }
 
+void EventsManager::advanceTo(unsigned int k)
+{
+  if(k < _k)
+    THROW_EXCEPTION("EventsManager::advanceTo - the new time index must not be lower than the current one.");
+  if(k == _k)
+    return;
+
+  for(unsigned int j = 1; j < _events.size(); j++)
+  {
+    if(_events[j]->getType() != TD_EVENT)
+      THROW_EXCEPTION("EventsManager::advanceTo - only time discretisation events may be scheduled.");
+  }
+
+  _events[0]->setTime(_td->getTk(k));
+  _events[0]->setK(k);
+  for(unsigned int j = 1; j < _events.size(); j++)
+  {
+    static_cast<TimeDiscretisationEvent&>(*_events[j]).update(k + j);
+  }
+  _k = k;
+}
+
 void EventsManager::processEvents(Simulation& sim)
 {
   //process next event
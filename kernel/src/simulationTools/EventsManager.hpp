@@ -156,6 +156,25 @@ public:
    */
   void noSaveInMemory(const Simulation& sim);
 
+  /** move the time-discretisation events forward to the time
+   *  instant t_k, without processing them. This is used to restart a
+   *  time-stepping simulation from a state checkpoint; only time
+   *  discretisation events may be scheduled.
+   *
+   *  \param k the index of the new current time instant, not lower than
+   *  the current one
+   */
+  void advanceTo(unsigned int k);
+
+  /** get the index of the current time instant
+   *
+   *  \return the index k of t_k
+   */
+  inline unsigned int currentTimeIndex() const
+  {
+    return _k;
+  };
+
   /** get the current event
    *
    *  \return a pointer to Event
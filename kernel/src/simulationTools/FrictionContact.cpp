@@ -20,6 +20,7 @@
 #include "Simulation.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
 #include "NewtonImpactFrictionNSL.hpp"
+#include "NewtonEuler1DR.hpp"
 #include "OSNSMatrix.hpp"
 #include "NonSmoothDrivers.h" // from numerics, for fcX_driver
 #include <fc2d_Solvers.h>
@@ -109,6 +110,41 @@ void FrictionContact::updateMu()
   }
 }
 
+void FrictionContact::updateContactPoints()
+{
+  SolverOptions * options = &*_numerics_solver_options;
+  if(_contactProblemDim != 3 || options->solverId != SICONOS_FRICTION_3D_NSGS
+      || (options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] != SICONOS_FRICTION_3D_NSGS_ORDERING_MORTON
+          && options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] != SICONOS_FRICTION_3D_NSGS_ORDERING_BOTTOM_UP))
+    return;
+
+  size_t size = _sizeOutput;
+  if(options->dWorkSize != size)
+  {
+    options->dWork = (double*)realloc(options->dWork, size * sizeof(double));
+    options->dWorkSize = size;
+  }
+  // contact points in the order of the rows of the problem; the ordering
+  // is skipped by numerics if some relation does not provide them.
+  SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  InteractionsGraph::VIterator ui, uiend;
+  size_t pos = 0;
+  for(std::tie(ui, uiend) = indexSet->vertices(); ui != uiend; ++ui, pos += 3)
+  {
+    SP::NewtonEuler1DR relation =
+      std::dynamic_pointer_cast<NewtonEuler1DR>(indexSet->bundle(*ui)->relation());
+    if(!relation || !relation->pc1())
+    {
+      free(options->dWork);
+      options->dWork = nullptr;
+      options->dWorkSize = 0;
+      return;
+    }
+    for(unsigned int k = 0; k < 3; ++k)
+      options->dWork[pos + k] = relation->pc1()->getValue(k);
+  }
+}
+
 SP::FrictionContactProblem FrictionContact::frictionContactProblem()
 {
   SP::FrictionContactProblem numerics_problem(new FrictionContactProblem());
@@ -186,6 +222,7 @@ int FrictionContact::compute(double time)
   }
 
   updateMu();
+  updateContactPoints();
 
   // --- Call Numerics driver ---
   // Inputs:
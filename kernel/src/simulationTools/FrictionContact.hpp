@@ -135,6 +135,11 @@ public:
    */
   void updateMu();
 
+  /** pass the contact points to the NSGS solver when it is asked for a
+   *  geometric ordering of the contacts (see SICONOS_FRICTION_3D_NSGS_ORDERING)
+   */
+  void updateContactPoints();
+
   /**
      set the driver-function used to solve the problem
 
@@ -103,6 +103,16 @@ public:
   void computeDiagonalInteractionBlock(
       const InteractionsGraph::VDescriptor &vd) override;
 
+  /** the blocks computation updates the problem description (sizes,
+   *  types of the sub-problems) and is thus kept serial
+   *
+   *  \return false
+   */
+  bool prepareParallelInteractionBlocks() override
+  {
+    return false;
+  }
+
   /** print the data to the screen */
   void display() const override;
 
@@ -0,0 +1,95 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "InteractionsGraphSnapshot.hpp"
+#include <unordered_map>
+#include "Interaction.hpp"
+#include "NonSmoothLaw.hpp"
+
+// #define DEBUG_NOCOLOR
+// #define DEBUG_STDOUT
+// #define DEBUG_MESSAGES
+#include "siconos_debug.h"
+
+bool InteractionsGraphSnapshot::update(InteractionsGraph& indexSet)
+{
+  if(isUpToDate(indexSet))
+    return false;
+
+  DEBUG_BEGIN("bool InteractionsGraphSnapshot::update(InteractionsGraph& indexSet)\n");
+  clear();
+  unsigned int n = indexSet.size();
+  _vertices.reserve(n);
+  _interactions.reserve(n);
+  _properties.reserve(n);
+  _sizes.reserve(n);
+
+  // === vertices, in the order of the graph iteration ===
+  std::unordered_map<InteractionsGraph::VDescriptor, unsigned int> denseIndex(n);
+  InteractionsGraph::VIterator vi, viend;
+  for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+  {
+    denseIndex[*vi] = _vertices.size();
+    Interaction& inter = *indexSet.bundle(*vi);
+    InteractionProperties& props = indexSet.properties(*vi);
+    unsigned int size = inter.nonSmoothLaw()->size();
+
+    _vertices.push_back(*vi);
+    _interactions.push_back(&inter);
+    _properties.push_back(&props);
+    _sizes.push_back(size);
+    _dimension += size;
+  }
+
+  // === CSR adjacency ===
+  _adjacencyStart.reserve(n + 1);
+  _adjacentVertices.reserve(2 * indexSet.edges_number());
+  _adjacentEdges.reserve(2 * indexSet.edges_number());
+  _adjacencyStart.push_back(0);
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    InteractionsGraph::OEIterator oei, oeiend;
+    for(std::tie(oei, oeiend) = indexSet.out_edges(_vertices[i]);
+        oei != oeiend; ++oei)
+    {
+      assert(denseIndex.find(indexSet.target(*oei)) != denseIndex.end());
+      _adjacentVertices.push_back(denseIndex[indexSet.target(*oei)]);
+      _adjacentEdges.push_back(&indexSet.properties(*oei));
+    }
+    _adjacencyStart.push_back(_adjacentVertices.size());
+  }
+
+  _graph = &indexSet;
+  _structureStamp = indexSet.structure_stamp();
+  DEBUG_PRINTF("%u vertices, %u edges, dimension %u\n", size(), edgesNumber(), _dimension);
+  DEBUG_END("bool InteractionsGraphSnapshot::update(InteractionsGraph& indexSet)\n");
+  return true;
+}
+
+void InteractionsGraphSnapshot::clear()
+{
+  _graph = nullptr;
+  _structureStamp = 0;
+  _dimension = 0;
+  _vertices.clear();
+  _interactions.clear();
+  _properties.clear();
+  _sizes.clear();
+  _adjacencyStart.clear();
+  _adjacentVertices.clear();
+  _adjacentEdges.clear();
+}
@@ -0,0 +1,235 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file InteractionsGraphSnapshot.hpp
+  Compact, array based view of an index set
+*/
+
+#ifndef InteractionsGraphSnapshot_H
+#define InteractionsGraphSnapshot_H
+
+#include <vector>
+#include "SimulationGraphs.hpp"
+
+/**
+   Compact view of an InteractionsGraph (index set)
+
+   The index sets are boost adjacency lists (linked lists of vertices
+   and edges, with property maps). Iterating over them at each time
+   step costs a pointer chase and a property lookup per vertex. This
+   class stores, for a given state of the graph:
+
+   - the vertices in dense arrays (0 ... size()-1, in the order of the
+   graph iteration): descriptors, interactions, properties and sizes
+   of the nonsmooth laws,
+
+   - the adjacency in CSR format: the neighbours of the vertex i are
+   the entries k in [adjacencyBegin(i), adjacencyEnd(i)), given by
+   their dense index adjacentVertex(k) and the properties of the
+   connecting edge adjacentEdgeProperties(k).
+
+   The snapshot is rebuilt by update() only when the structure of the
+   graph has changed (see SiconosGraph::structure_stamp()), so it can
+   be called before each loop at the price of a comparison. Since
+   properties are reached by pointers, their values (blocks, work
+   vectors ...) are always the current ones.
+
+   The snapshot does not compute the absolute positions of the
+   interactions: they depend on the OSNSMatrix (sizes of the
+   nonsmooth laws, or of the projection for
+   OSNSMatrixProjectOnConstraints) and are read in the properties,
+   where the fill of the matrix has set them.
+*/
+class InteractionsGraphSnapshot
+{
+private:
+
+  /** the graph of the last update (not owned) */
+  InteractionsGraph* _graph = nullptr;
+
+  /** structure stamp of _graph at the last update */
+  size_t _structureStamp = 0;
+
+  /** sum of the sizes of the nonsmooth laws */
+  unsigned int _dimension = 0;
+
+  /** vertex descriptors */
+  std::vector<InteractionsGraph::VDescriptor> _vertices;
+
+  /** interactions (bundles of the vertices) */
+  std::vector<Interaction*> _interactions;
+
+  /** properties of the vertices */
+  std::vector<InteractionProperties*> _properties;
+
+  /** sizes of the nonsmooth laws */
+  std::vector<unsigned int> _sizes;
+
+  /** CSR adjacency : start of the neighbours of each vertex
+   * (size() + 1 entries) */
+  std::vector<unsigned int> _adjacencyStart;
+
+  /** CSR adjacency : dense indices of the neighbours */
+  std::vector<unsigned int> _adjacentVertices;
+
+  /** CSR adjacency : properties of the connecting edges */
+  std::vector<DynamicalSystemProperties*> _adjacentEdges;
+
+  /** private copy constructor => no copy nor pass by value */
+  InteractionsGraphSnapshot(const InteractionsGraphSnapshot&);
+
+  /** private assignment -> forbidden */
+  InteractionsGraphSnapshot& operator=(const InteractionsGraphSnapshot&);
+
+public:
+
+  /** constructor, with an empty snapshot
+   */
+  InteractionsGraphSnapshot() = default;
+
+  /** destructor
+   */
+  ~InteractionsGraphSnapshot() = default;
+
+  /** rebuild the snapshot if indexSet is not the graph of the last
+   *  update or if its structure has changed since then.
+   *
+   *  \param indexSet the graph
+   *  \return true if the snapshot has been rebuilt
+   */
+  bool update(InteractionsGraph& indexSet);
+
+  /** \param indexSet a graph
+   *  \return true if the snapshot corresponds to the current
+   *  structure of indexSet
+   */
+  inline bool isUpToDate(const InteractionsGraph& indexSet) const
+  {
+    return _graph == &indexSet
+      && _structureStamp == indexSet.structure_stamp();
+  };
+
+  /** empty the snapshot; the next call to update() rebuilds it
+   */
+  void clear();
+
+  /** \return the graph of the last update (may be nullptr)
+   */
+  inline InteractionsGraph* graph() const
+  {
+    return _graph;
+  };
+
+  /** \return the number of vertices (interactions)
+   */
+  inline unsigned int size() const
+  {
+    return _vertices.size();
+  };
+
+  /** \return the sum of the sizes of the nonsmooth laws
+   */
+  inline unsigned int dimension() const
+  {
+    return _dimension;
+  };
+
+  /** \return the number of edges, each one being stored twice in the
+   *  adjacency
+   */
+  inline unsigned int edgesNumber() const
+  {
+    return _adjacentVertices.size() / 2;
+  };
+
+  /** \param i dense index of a vertex
+   *  \return its descriptor in the graph
+   */
+  inline InteractionsGraph::VDescriptor vertex(unsigned int i) const
+  {
+    return _vertices[i];
+  };
+
+  /** \param i dense index of a vertex
+   *  \return the interaction
+   */
+  inline Interaction& interaction(unsigned int i) const
+  {
+    return *_interactions[i];
+  };
+
+  /** \param i dense index of a vertex
+   *  \return the properties of the vertex
+   */
+  inline InteractionProperties& properties(unsigned int i) const
+  {
+    return *_properties[i];
+  };
+
+  /** \param i dense index of a vertex
+   *  \return the absolute position of the interaction, as set in
+   *  its properties by the last fill of the OSNSMatrix
+   */
+  inline unsigned int position(unsigned int i) const
+  {
+    return _properties[i]->absolute_position;
+  };
+
+  /** \param i dense index of a vertex
+   *  \return the size of the nonsmooth law of the interaction
+   */
+  inline unsigned int interactionSize(unsigned int i) const
+  {
+    return _sizes[i];
+  };
+
+  /** \param i dense index of a vertex
+   *  \return the first adjacency entry of the vertex
+   */
+  inline unsigned int adjacencyBegin(unsigned int i) const
+  {
+    return _adjacencyStart[i];
+  };
+
+  /** \param i dense index of a vertex
+   *  \return the adjacency entry past the last one of the vertex
+   */
+  inline unsigned int adjacencyEnd(unsigned int i) const
+  {
+    return _adjacencyStart[i + 1];
+  };
+
+  /** \param k an adjacency entry
+   *  \return the dense index of the neighbour
+   */
+  inline unsigned int adjacentVertex(unsigned int k) const
+  {
+    return _adjacentVertices[k];
+  };
+
+  /** \param k an adjacency entry
+   *  \return the properties of the edge (dynamical system) connecting
+   *  the two vertices
+   */
+  inline DynamicalSystemProperties& adjacentEdgeProperties(unsigned int k) const
+  {
+    return *_adjacentEdges[k];
+  };
+};
+
+#endif
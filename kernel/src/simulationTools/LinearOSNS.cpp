@@ -42,8 +42,12 @@
 #include "LagrangianLinearTIDS.hpp"
 #include "NewtonEulerDS.hpp"
 #include "OSNSMatrix.hpp"
+#include "InteractionsGraphSnapshot.hpp"
 
+#include "BoundaryCondition.hpp"
 #include "Tools.hpp"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 
 using namespace RELATION;
@@ -51,6 +55,178 @@ using namespace RELATION;
 //#define DEBUG_STDOUT
 //#define DEBUG_MESSAGES
 #include "siconos_debug.h"
+
+namespace
+{
+std::atomic<std::size_t> blockWorkspaceAllocationCount(0);
+
+/* Dense scratch matrices of the interaction-block computations, one set
+   per thread, cached by (slot, shape). */
+class BlockWorkspace
+{
+  struct Entry
+  {
+    unsigned int slot, rows, cols;
+    SP::SimpleMatrix matrix;
+  };
+  std::vector<Entry> _entries;
+
+public:
+  SimpleMatrix& get(unsigned int slot, unsigned int rows, unsigned int cols)
+  {
+    for(Entry& e : _entries)
+      if(e.slot == slot && e.rows == rows && e.cols == cols)
+        return *e.matrix;
+    ++blockWorkspaceAllocationCount;
+    _entries.push_back({slot, rows, cols, SP::SimpleMatrix(new SimpleMatrix(rows, cols))});
+    return *_entries.back().matrix;
+  }
+};
+
+thread_local BlockWorkspace blockWorkspace;
+
+/* C += A * B, column-major storage, A is M x K, B is K x N. */
+template<unsigned int M, unsigned int N, unsigned int K>
+inline void gemmAdd(const double* A, unsigned int lda, const double* B,
+                    unsigned int ldb, double* C, unsigned int ldc)
+{
+  for(unsigned int j = 0; j < N; ++j)
+    for(unsigned int p = 0; p < K; ++p)
+    {
+      const double b = B[p + j * ldb];
+      for(unsigned int i = 0; i < M; ++i)
+        C[i + j * ldc] += A[i + p * lda] * b;
+    }
+}
+
+void gemmAdd(unsigned int m, unsigned int n, unsigned int k,
+             const double* A, unsigned int lda, const double* B,
+             unsigned int ldb, double* C, unsigned int ldc)
+{
+  // usual contact shapes: 3D (frictional) and 2D contacts on 6 or 3 dofs bodies
+  if(m == 3 && n == 3 && k == 6)
+    gemmAdd<3, 3, 6>(A, lda, B, ldb, C, ldc);
+  else if(m == 3 && n == 3 && k == 3)
+    gemmAdd<3, 3, 3>(A, lda, B, ldb, C, ldc);
+  else if(m == 2 && n == 2 && k == 3)
+    gemmAdd<2, 2, 3>(A, lda, B, ldb, C, ldc);
+  else if(m == 6 && n == 6 && k == 6)
+    gemmAdd<6, 6, 6>(A, lda, B, ldb, C, ldc);
+  else if(m == 1 && n == 1 && k == 3)
+    gemmAdd<1, 1, 3>(A, lda, B, ldb, C, ldc);
+  else if(m == 1 && n == 1 && k == 6)
+    gemmAdd<1, 1, 6>(A, lda, B, ldb, C, ldc);
+  else
+  {
+    for(unsigned int j = 0; j < n; ++j)
+      for(unsigned int p = 0; p < k; ++p)
+      {
+        const double b = B[p + j * ldb];
+        for(unsigned int i = 0; i < m; ++i)
+          C[i + j * ldc] += A[i + p * lda] * b;
+      }
+  }
+}
+
+/* zeroes the columns of the velocities prescribed by bc */
+void zeroVelocityColumns(SiconosMatrix& left, BoundaryCondition& bc)
+{
+  for(unsigned int index : *bc.velocityIndices())
+    for(unsigned int i = 0; i < left.size(0); ++i)
+      left.setValue(i, index, 0.);
+}
+
+/* block += H1 * W^{-1} * H2^T, where H1 (resp. H2) are the sizeDS columns of
+   the relation matrix J1 (resp. J2) starting at pos1 (resp. pos2), read in
+   place. Columns of velocities prescribed by bc are zeroed in H1 and, if
+   bcOnRight, in H2. Returns false (nothing done) if some storage is not
+   dense, in which case the generic path must be used. */
+bool addLeftWinvLeftT(const SiconosMatrix& J1, unsigned int pos1,
+                      const SiconosMatrix& J2, unsigned int pos2,
+                      unsigned int sizeDS, BoundaryCondition* bc, bool bcOnRight,
+                      SiconosMatrix& W, SiconosMatrix& block)
+{
+  if(J1.num() != Siconos::DENSE || J2.num() != Siconos::DENSE
+      || block.num() != Siconos::DENSE)
+    return false;
+
+  unsigned int m = block.size(0), n = block.size(1);
+  if(J1.size(0) != m || J2.size(0) != n
+      || J1.size(1) < pos1 + sizeDS || J2.size(1) < pos2 + sizeDS)
+    return false;
+
+  const double* H1 = J1.getArray() + pos1 * m;
+  const double* H2 = J2.getArray() + pos2 * n;
+
+  if(bc)
+  {
+    SimpleMatrix& left = blockWorkspace.get(0, m, sizeDS);
+    double* l = left.getArray();
+    std::copy(H1, H1 + m * sizeDS, l);
+    for(unsigned int index : *bc->velocityIndices())
+      std::fill(l + index * m, l + (index + 1) * m, 0.);
+    H1 = l;
+  }
+
+  // work = W^{-1} H2^T
+  SimpleMatrix& work = blockWorkspace.get(1, sizeDS, n);
+  double* w = work.getArray();
+  for(unsigned int p = 0; p < sizeDS; ++p)
+    for(unsigned int j = 0; j < n; ++j)
+      w[p + j * sizeDS] = H2[j + p * n];
+  if(bc && bcOnRight)
+  {
+    for(unsigned int index : *bc->velocityIndices())
+      for(unsigned int j = 0; j < n; ++j)
+        w[index + j * sizeDS] = 0.;
+  }
+  W.Solve(work);
+
+  gemmAdd(m, n, sizeDS, H1, m, w, sizeDS, block.getArray(), m);
+  return true;
+}
+}
+
+std::size_t LinearOSNS::blockWorkspaceAllocations()
+{
+  return blockWorkspaceAllocationCount;
+}
+
+bool LinearOSNS::prepareParallelInteractionBlocks()
+{
+#ifdef _OPENMP
+  SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  DynamicalSystemsGraph& DSG0 = *simulation()->nonSmoothDynamicalSystem()->dynamicalSystems();
+  InteractionsGraph::VIterator vi, viend;
+  for(std::tie(vi, viend) = indexSet->vertices(); vi != viend; ++vi)
+  {
+    RELATION::TYPES relationType = indexSet->bundle(*vi)->relation()->getType();
+    if(relationType != Lagrangian && relationType != NewtonEuler)
+      return false;
+    SP::DynamicalSystem ds[2] = {indexSet->properties(*vi).source,
+                                 indexSet->properties(*vi).target
+                                };
+    for(SP::DynamicalSystem& d : ds)
+    {
+      OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(d)).osi;
+      if(osi.getType() == OSI::MOREAUJEANBILBAOOSI
+          || Type::value(*d) == Type::LagrangianLinearDiagonalDS)
+        return false;
+      // Solve factorizes lazily: it must not happen concurrently.
+      // The sparse solvers share a work buffer: dense W only
+      SP::SimpleMatrix W = getOSIMatrix(osi, d);
+      if(W->num() != Siconos::DENSE)
+        return false;
+      if(!W->isFactorized())
+        W->Factorize();
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
 //#define WITH_TIMER
 void LinearOSNS::initVectorsMemory()
 {
@@ -449,16 +625,13 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
     OSI::TYPES osiType = osi.getType();
     unsigned int sizeDS = ds->dimension();
 
-    // get _interactionBlocks corresponding to the current DS
-    // These _interactionBlocks depends on the relation type.
-    leftInteractionBlock = inter->getLeftInteractionBlockForDS(pos, nslawSize, sizeDS);
-    DEBUG_EXPR(leftInteractionBlock->display(););
     // Computing depends on relation type -> move this in Interaction method?
     if(relationType == FirstOrder)
     {
-
-
-
+      // get _interactionBlocks corresponding to the current DS
+      // These _interactionBlocks depends on the relation type.
+      leftInteractionBlock = inter->getLeftInteractionBlockForDS(pos, nslawSize, sizeDS);
+      DEBUG_EXPR(leftInteractionBlock->display(););
       rightInteractionBlock = inter->getRightInteractionBlockForDS(pos, sizeDS, nslawSize);
 
       if(osiType == OSI::EULERMOREAUOSI)
@@ -499,26 +672,16 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
     else if(relationType == Lagrangian ||
             relationType == NewtonEuler)
     {
-      // Applying boundary conditions
       SP::BoundaryCondition bc;
       SP::SecondOrderDS d = std::static_pointer_cast<SecondOrderDS> (ds);
       if(d->boundaryConditions()) bc = d->boundaryConditions();
-      if(bc)
-      {
-        for(std::vector<unsigned int>::iterator itindex = bc->velocityIndices()->begin() ;
-            itindex != bc->velocityIndices()->end();
-            ++itindex)
-        {
-          // (nslawSize,sizeDS));
-          SP::SiconosVector coltmp(new SiconosVector(nslawSize));
-          coltmp->zero();
-          leftInteractionBlock->setCol(*itindex, *coltmp);
-        }
-      }
 
       Type::Siconos dsType = Type::value(*ds);
       if(osiType == OSI::MOREAUJEANBILBAOOSI || dsType == Type::LagrangianLinearDiagonalDS)
       {
+        leftInteractionBlock = inter->getLeftInteractionBlockForDS(pos, nslawSize, sizeDS);
+        // Applying boundary conditions
+        if(bc) zeroVelocityColumns(*leftInteractionBlock, *bc);
         SP::SiconosMatrix work(new SimpleMatrix(*leftInteractionBlock));
         // Get inverse of the iteration matrix
         SiconosMatrix& inv_iteration_matrix = *getOSIMatrix(osi, ds);
@@ -526,39 +689,38 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
         axpy_prod(*leftInteractionBlock, inv_iteration_matrix, *work, true);
         leftInteractionBlock->trans();
         prod(*work,* leftInteractionBlock, *currentInteractionBlock, false);
-        if(relationSubType == CompliantLinearTIR)
-        {
-          if(osiType == OSI::MOREAUJEANOSI)
-          {
-            * currentInteractionBlock *= (static_cast<MoreauJeanOSI&>(osi)).theta() ;
-            * currentInteractionBlock +=  *std::static_pointer_cast<LagrangianCompliantLinearTIR>(inter->relation())->D()/simulation()->timeStep() ;
-          }
-        }
       }
       else
       {
-        DEBUG_PRINT("leftInteractionBlock after application of boundary conditions\n");
-        DEBUG_EXPR(leftInteractionBlock->display(););
         // (inter1 == inter2)
-        SP::SiconosMatrix work(new SimpleMatrix(*leftInteractionBlock));
-        work->trans();
         SP::SiconosMatrix centralInteractionBlock = getOSIMatrix(osi, ds);
         DEBUG_EXPR_WE(std::cout <<  std::boolalpha << " centralInteractionBlock->isFactorized() = "<< centralInteractionBlock->isFactorized() << std::endl;);
-        centralInteractionBlock->Solve(*work);
-        //*currentInteractionBlock +=  *leftInteractionBlock ** work;
-        DEBUG_EXPR(work->display(););
-        prod(*leftInteractionBlock, *work, *currentInteractionBlock, false);
-        //      gemm(CblasNoTrans,CblasNoTrans,1.0,*leftInteractionBlock,*work,1.0,*currentInteractionBlock);
-        //*currentInteractionBlock *=h;
+        // dense storage: H is read in place in the relation jacobian
+        SiconosMatrix& H = *inter->getLeftInteractionBlock();
+        if(!addLeftWinvLeftT(H, pos, H, pos, sizeDS, bc.get(), true,
+                             *centralInteractionBlock, *currentInteractionBlock))
+        {
+          leftInteractionBlock = inter->getLeftInteractionBlockForDS(pos, nslawSize, sizeDS);
+          // Applying boundary conditions
+          if(bc) zeroVelocityColumns(*leftInteractionBlock, *bc);
+          DEBUG_PRINT("leftInteractionBlock after application of boundary conditions\n");
+          DEBUG_EXPR(leftInteractionBlock->display(););
+          SP::SiconosMatrix work(new SimpleMatrix(*leftInteractionBlock));
+          work->trans();
+          centralInteractionBlock->Solve(*work);
+          //*currentInteractionBlock +=  *leftInteractionBlock ** work;
+          DEBUG_EXPR(work->display(););
+          prod(*leftInteractionBlock, *work, *currentInteractionBlock, false);
+        }
         DEBUG_EXPR(currentInteractionBlock->display(););
         //assert(currentInteractionBlock->checkSymmetry(1e-10));
-        if(relationSubType == CompliantLinearTIR)
+      }
+      if(relationSubType == CompliantLinearTIR)
+      {
+        if(osiType == OSI::MOREAUJEANOSI)
         {
-          if(osiType == OSI::MOREAUJEANOSI)
-          {
-            * currentInteractionBlock *= (static_cast<MoreauJeanOSI&>(osi)).theta() ;
-            * currentInteractionBlock +=  *std::static_pointer_cast<LagrangianCompliantLinearTIR>(inter->relation())->D()/simulation()->timeStep() ;
-          }
+          * currentInteractionBlock *= (static_cast<MoreauJeanOSI&>(osi)).theta() ;
+          * currentInteractionBlock +=  *std::static_pointer_cast<LagrangianCompliantLinearTIR>(inter->relation())->D()/simulation()->timeStep() ;
         }
       }
     }
@@ -669,13 +831,12 @@ void LinearOSNS::computeInteractionBlock(const InteractionsGraph::EDescriptor& e
   // loop over the common DS
   unsigned int sizeDS = ds->dimension();
 
-  // get _interactionBlocks corresponding to the current DS
-  // These _interactionBlocks depends on the relation type.
-  leftInteractionBlock = inter1->getLeftInteractionBlockForDS(pos1, nslawSize1, sizeDS);
-
   // Computing depends on relation type -> move this in Interaction method?
   if(relationType1 == FirstOrder && relationType2 == FirstOrder)
   {
+    // get _interactionBlocks corresponding to the current DS
+    // These _interactionBlocks depends on the relation type.
+    leftInteractionBlock = inter1->getLeftInteractionBlockForDS(pos1, nslawSize1, sizeDS);
     rightInteractionBlock = inter2->getRightInteractionBlockForDS(pos2, sizeDS, nslawSize2);
     // centralInteractionBlock contains a lu-factorized matrix and we solve
     // centralInteractionBlock * X = rightInteractionBlock with PLU
@@ -697,27 +858,17 @@ void LinearOSNS::computeInteractionBlock(const InteractionsGraph::EDescriptor& e
           relationType1 == NewtonEuler ||
           relationType2 == NewtonEuler)
   {
-    // Applying boundary conditions
     SP::BoundaryCondition bc;
     SP::SecondOrderDS d = std::static_pointer_cast<SecondOrderDS> (ds);
     if(d->boundaryConditions()) bc = d->boundaryConditions();
-    if(bc)
-    {
-      for(std::vector<unsigned int>::iterator itindex = bc->velocityIndices()->begin() ;
-          itindex != bc->velocityIndices()->end();
-          ++itindex)
-      {
-        // (nslawSize,sizeDS));
-        SP::SiconosVector coltmp(new SiconosVector(nslawSize1));
-        coltmp->zero();
-        leftInteractionBlock->setCol(*itindex, *coltmp);
-        }
-    }
 
     Type::Siconos dsType = Type::value(*ds);
 
     if(osiType == OSI::MOREAUJEANBILBAOOSI || dsType == Type::LagrangianLinearDiagonalDS)
     {
+      leftInteractionBlock = inter1->getLeftInteractionBlockForDS(pos1, nslawSize1, sizeDS);
+      // Applying boundary conditions
+      if(bc) zeroVelocityColumns(*leftInteractionBlock, *bc);
       // Rightinteractionblock used first as buffer to save left * W-1
       rightInteractionBlock.reset(new SimpleMatrix(nslawSize2, sizeDS));
       //SP::SiconosMatrix work(new SimpleMatrix(*leftInteractionBlock));
@@ -734,16 +885,26 @@ void LinearOSNS::computeInteractionBlock(const InteractionsGraph::EDescriptor& e
     else
     {
       // inter1 != inter2
-      rightInteractionBlock = inter2->getLeftInteractionBlockForDS(pos2, nslawSize2, sizeDS);
-      rightInteractionBlock->trans();
-      // Warning: we use getLeft for Right interactionBlock
-      // because right = transpose(left) and because of
-      // size checking inside the getBlock function, a
-      // getRight call will fail.
       SP::SimpleMatrix centralInteractionBlock = getOSIMatrix(osi, ds);
-      centralInteractionBlock->Solve(*rightInteractionBlock);
-      //*currentInteractionBlock +=  *leftInteractionBlock ** work;
-      prod(*leftInteractionBlock, *rightInteractionBlock, *currentInteractionBlock, false);
+      // dense storage: both blocks are read in place in the relation jacobians
+      if(!addLeftWinvLeftT(*inter1->getLeftInteractionBlock(), pos1,
+                           *inter2->getLeftInteractionBlock(), pos2,
+                           sizeDS, bc.get(), false,
+                           *centralInteractionBlock, *currentInteractionBlock))
+      {
+        leftInteractionBlock = inter1->getLeftInteractionBlockForDS(pos1, nslawSize1, sizeDS);
+        // Applying boundary conditions
+        if(bc) zeroVelocityColumns(*leftInteractionBlock, *bc);
+        rightInteractionBlock = inter2->getLeftInteractionBlockForDS(pos2, nslawSize2, sizeDS);
+        rightInteractionBlock->trans();
+        // Warning: we use getLeft for Right interactionBlock
+        // because right = transpose(left) and because of
+        // size checking inside the getBlock function, a
+        // getRight call will fail.
+        centralInteractionBlock->Solve(*rightInteractionBlock);
+        //*currentInteractionBlock +=  *leftInteractionBlock ** work;
+        prod(*leftInteractionBlock, *rightInteractionBlock, *currentInteractionBlock, false);
+      }
     }
   }
   else THROW_EXCEPTION("LinearOSNS::computeInteractionBlock not yet implemented for relation of type " + std::to_string(relationType1));
@@ -769,6 +930,20 @@ void LinearOSNS::computeqBlock(InteractionsGraph::VDescriptor& vertex_inter, uns
   DEBUG_END("LinearOSNS::computeqBlock(SP::Interaction inter, unsigned int pos)\n");
 }
 
+void LinearOSNS::computeqBlock(const InteractionsGraphSnapshot& snapshot, unsigned int i)
+{
+  DEBUG_BEGIN("LinearOSNS::computeqBlock(const InteractionsGraphSnapshot& snapshot, unsigned int i)\n");
+  InteractionsGraph::VDescriptor vertex_inter = snapshot.vertex(i);
+  OneStepIntegrator& osi1 = *snapshot.properties(i).osi1;
+
+  osi1.computeFreeOutput(vertex_inter, this);
+  SiconosVector& osnsp_rhs = osi1.osnsp_rhs(vertex_inter, *snapshot.graph());
+  setBlock(osnsp_rhs, _q, snapshot.interactionSize(i), 0, snapshot.position(i));
+
+  DEBUG_EXPR(_q->display());
+  DEBUG_END("LinearOSNS::computeqBlock(const InteractionsGraphSnapshot& snapshot, unsigned int i)\n");
+}
+
 void LinearOSNS::computeq(double time)
 {
   DEBUG_BEGIN("void LinearOSNS::computeq(double time)\n");
@@ -776,23 +951,28 @@ void LinearOSNS::computeq(double time)
     _q->resize(_sizeOutput);
   _q->zero();
 
-  // === Get index set from Simulation ===
-  SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  // === Get index set snapshot ===
+  const InteractionsGraphSnapshot& snapshot = indexSetSnapshot();
   // === Loop through "active" Interactions (ie present in
   // indexSets[level]) ===
 
-  unsigned int pos = 0;
-  InteractionsGraph::VIterator ui, uiend;
-  for(std::tie(ui, uiend) = indexSet->vertices(); ui != uiend; ++ui)
+  for(unsigned int i = 0, n = snapshot.size(); i < n; ++i)
   {
     // Compute q, this depends on the type of non smooth problem, on
     // the relation type and on the non smooth law
-    pos = indexSet->properties(*ui).absolute_position;
-    computeqBlock(*ui, pos); // free output is saved in y
+    computeqBlock(snapshot, i); // free output is saved in y
   }
   DEBUG_END("void LinearOSNS::computeq(double time)\n");
 }
 
+const InteractionsGraphSnapshot& LinearOSNS::indexSetSnapshot()
+{
+  if(!_indexSetSnapshot)
+    _indexSetSnapshot.reset(new InteractionsGraphSnapshot());
+  _indexSetSnapshot->update(*simulation()->indexSet(indexSetLevel()));
+  return *_indexSetSnapshot;
+}
+
 
 
 void LinearOSNS::computeM()
@@ -800,13 +980,11 @@ void LinearOSNS::computeM()
   if (_assemblyType == REDUCED_BLOCK)
   {
 
-    InteractionsGraph& indexSet = *simulation()->indexSet(indexSetLevel());
-
     // Computes new _interactionBlocks if required
     updateInteractionBlocks();
 
     //    _M->fill(indexSet);
-    _M->fillM(indexSet, !_hasBeenUpdated);
+    _M->fillM(indexSetSnapshot(), !_hasBeenUpdated);
 
   }
   else if (_assemblyType ==REDUCED_DIRECT)
@@ -927,13 +1105,13 @@ bool LinearOSNS::preCompute(double time)
     // Note : sizeOuput can be unchanged, but positions may have changed. (??)
     if(_keepLambdaAndYState)
     {
-      InteractionsGraph::VIterator ui, uiend;
-      for(std::tie(ui, uiend) = indexSet.vertices(); ui != uiend; ++ui)
+      const InteractionsGraphSnapshot& snapshot = indexSetSnapshot();
+      for(unsigned int i = 0, n = snapshot.size(); i < n; ++i)
       {
-        Interaction& inter = *indexSet.bundle(*ui);
+        Interaction& inter = snapshot.interaction(i);
         // Get the position of inter-interactionBlock in the vector w
         // or z
-        unsigned int pos = indexSet.properties(*ui).absolute_position;
+        unsigned int pos = snapshot.position(i);
         // VA 30/08/2021  : Warning. the values of y_k and lambda_k that are stored in Memory
         // may be undefined at the first time step.
         const SiconosVector& yOutput_k = inter.y_k(inputOutputLevel());
@@ -982,8 +1160,8 @@ void LinearOSNS::postCompute()
   // lcp_driver (w,z).  Only Interactions (ie Interactions) of
   // indexSet(leveMin) are concerned.
 
-  // === Get index set from Topology ===
-  InteractionsGraph& indexSet = *simulation()->indexSet(indexSetLevel());
+  // === Get index set snapshot ===
+  const InteractionsGraphSnapshot& snapshot = indexSetSnapshot();
 
   // y and lambda vectors
   SP::SiconosVector lambda;
@@ -994,13 +1172,12 @@ void LinearOSNS::postCompute()
 
   unsigned int pos = 0;
 
-  InteractionsGraph::VIterator ui, uiend;
-  for(std::tie(ui, uiend) = indexSet.vertices(); ui != uiend; ++ui)
+  for(unsigned int i = 0, n = snapshot.size(); i < n; ++i)
   {
-    Interaction& inter = *indexSet.bundle(*ui);
+    Interaction& inter = snapshot.interaction(i);
     // Get the  position of inter-interactionBlock in the vector w
     // or z
-    pos = indexSet.properties(*ui).absolute_position;
+    pos = snapshot.position(i);
 
     // Get Y and Lambda for the current Interaction
     y = inter.y(inputOutputLevel());
@@ -89,6 +89,10 @@ protected:
       size */
   bool _keepLambdaAndYState = true;
 
+  /** arrays view of the index set, used by the loops over the
+      interactions (rebuilt only when the index set changes) */
+  SP::InteractionsGraphSnapshot _indexSetSnapshot;
+
   /** nslaw effects : visitors experimentation
    */
   struct _TimeSteppingNSLEffect;
@@ -262,7 +266,31 @@ public:
    */
   void computeDiagonalInteractionBlock(
       const InteractionsGraph::VDescriptor &vd) override;
-  
+
+  /** factorizes the iteration matrices involved in the index set, so that
+   *  diagonal blocks may be computed concurrently. Only Lagrangian and
+   *  NewtonEuler relations integrated with MoreauJeanOSI-like schemes,
+   *  with dense iteration matrices, qualify, and only when built with
+   *  OpenMP.
+   *
+   *  \return true if the diagonal blocks may be computed in parallel
+   */
+  bool prepareParallelInteractionBlocks() override;
+
+  /** number of scratch matrices allocated so far by the interaction-block
+   *  computations (all threads). It stays constant once every block shape
+   *  has been met, i.e. in the steady state of a simulation.
+   *
+   *  \return the allocation count
+   */
+  static std::size_t blockWorkspaceAllocations();
+
+  /** update (if required) the snapshot of the index set of the problem
+   *
+   *  \return the snapshot, up to date with the current index set
+   */
+  const InteractionsGraphSnapshot& indexSetSnapshot();
+
   /** compute matrix M */
   virtual void computeM();
 
@@ -274,6 +302,16 @@ public:
   virtual void computeqBlock(InteractionsGraph::VDescriptor &vertex,
                              unsigned int pos);
 
+  /** To compute a part of the q vector of the OSNS, with the
+   *  interaction, its properties and its position taken in the
+   *  snapshot of the index set
+   *
+   *  \param snapshot the up-to-date snapshot of the index set
+   *  \param i dense index of the interaction in the snapshot
+   */
+  void computeqBlock(const InteractionsGraphSnapshot& snapshot,
+                     unsigned int i);
+
   /** compute vector q
    *
    *  \param time the current time
@@ -35,6 +35,8 @@
 #include "TypeName.hpp"
 #include <odepack.h>
 
+#include <mutex>
+
 using namespace RELATION;
 
 // #define DEBUG_NOCOLOR
@@ -48,7 +50,12 @@ int LsodarOSI::count_NFE = 0;
 // ===== Out of class objects and functions =====
 
 // global object and wrapping functions -> required for function plug-in and call in fortran routine.
-SP::LsodarOSI global_object;
+// One per thread, so that integrators may run concurrently in different threads.
+thread_local SP::LsodarOSI global_object;
+
+// ODEPACK keeps the state of the integration in common blocks: the calls
+// to LSODAR are serialized.
+static std::mutex odepackMutex;
 
 // This first function must have the same signature as argument F (arg 1) in DLSODAR (see opkdmain.f in Numerics)
 extern "C" void LsodarOSI_f_wrapper(integer* sizeOfX, doublereal* time, doublereal* x, doublereal* xdot);
@@ -79,6 +86,9 @@ LsodarOSI::LsodarOSI():
   _itol=1;
   _intData.resize(9);
   for(int i = 0; i < 9; i++) _intData[i] = 0;
+  // sizes given in DSRCAR
+  _rsav.resize(245);
+  _isav.resize(55);
   _sizeMem = 2;
   _steps=1;
 
@@ -514,6 +524,13 @@ void LsodarOSI::integrate(double& tinit, double& tend, double& tout, int& istate
   _intData[4] = istate;
 
 #ifdef HAS_FORTRAN
+  std::unique_lock<std::mutex> lock(odepackMutex);
+  // a continuation call needs the common blocks left by the previous call
+  // of this integrator
+  integer job = 2;
+  if(istate != 1)
+    CNAME(dsrcar)(_rsav.data(), _isav.data(), &job);
+
   // call LSODAR to integrate dynamical equation
   CNAME(dlsodar)(pointerToF,
                  &(_intData[0]),
@@ -535,6 +552,12 @@ void LsodarOSI::integrate(double& tinit, double& tend, double& tout, int& istate
                  pointerToG, &
                  (_intData[1]),
                  jroot.get());
+  job = 1;
+  CNAME(dsrcar)(_rsav.data(), _isav.data(), &job);
+  // Update counters
+  count_NST = iwork[10];
+  count_NFE = iwork[11];
+  lock.unlock();
 #else
   THROW_EXCEPTION("LsodarOSI, Fortran Language is not enabled in siconos kernel. Compile with fortran if you need Lsodar");
 #endif
@@ -566,9 +589,6 @@ void LsodarOSI::integrate(double& tinit, double& tend, double& tout, int& istate
     //      std:: std::cout << "ok\n";
     assert(true);
   }
-  // Update counters
-  count_NST = iwork[10];
-  count_NFE = iwork[11];
   //  tinit = tinit_DR;
   DEBUG_END("LsodarOSI::integrate(double& tinit, double& tend, double& tout, int& istate)\n");
 }
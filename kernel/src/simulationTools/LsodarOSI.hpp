@@ -78,6 +78,13 @@ private:
   SP::BlockVector _xWork;
 
   SP::SiconosVector _xtmp;
+
+  /** saved ODEPACK common blocks of this integrator, see DSRCAR in
+   *  opkda1.f: they are restored before each call to LSODAR, so that
+   *  several integrators may be used alternately */
+  std::vector<doublereal> _rsav;
+  std::vector<integer> _isav;
+
   /** nslaw effects
    */
   struct _NSLEffectOnFreeOutput;
@@ -90,7 +97,8 @@ public:
 
   enum LsodarOSI_interaction_workBlockVector_id { xfree, BLOCK_WORK_LENGTH };
 
-  /** Lsodar counter : Number of steps taken for the problem so far. */
+  /** Lsodar counter : Number of steps taken for the problem so far
+   *  (by the last integrator called). */
   static int count_NST;
   /** Number of RHS evaluations for the problem so far. */
   static int count_NFE;
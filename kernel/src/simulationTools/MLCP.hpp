@@ -139,6 +139,16 @@ public:
   void computeDiagonalInteractionBlock(
       const InteractionsGraph::VDescriptor &vd) override;
 
+  /** the blocks computation updates the problem description (sizes,
+   *  types of the sub-problems) and is thus kept serial
+   *
+   *  \return false
+   */
+  bool prepareParallelInteractionBlocks() override
+  {
+    return false;
+  }
+
   /** Compute the unknown z and w and update the Interaction (y and lambda )
    * 
    *  \param time current time
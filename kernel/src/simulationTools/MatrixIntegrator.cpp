@@ -25,6 +25,7 @@
 #include "TimeDiscretisation.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
 #include "EventsManager.hpp"
+#include "AlgebraTools.hpp"
 
 //#define DEBUG_WHERE_MESSAGES
 
@@ -99,9 +100,80 @@ void MatrixIntegrator::commonInit(const DynamicalSystem& ds, const NonSmoothDyna
 
 }
 
+bool MatrixIntegrator::hasClosedForm() const
+{
+  const FirstOrderLinearDS& ds = static_cast<const FirstOrderLinearDS&>(*_DS);
+  if(!_closedForm || _plugin || ds.M() || ds.getPluginA()->isPlugged())
+    return false;
+  return (!ds.A() || ds.A()->num() == Siconos::DENSE)
+         && (!_E || _E->num() == Siconos::DENSE);
+}
+
+void MatrixIntegrator::integrateClosedForm(double h)
+{
+  DEBUG_BEGIN("MatrixIntegrator::integrateClosedForm(double h)\n");
+  SP::SimpleMatrix& cached = _closedFormCache[h];
+  if(cached)
+  {
+    *_mat = *cached;
+    DEBUG_END("MatrixIntegrator::integrateClosedForm(double h)\n");
+    return;
+  }
+
+  SP::SiconosMatrix A = static_cast<FirstOrderLinearDS&>(*_DS).A();
+  unsigned int n = _DS->n();
+  unsigned int p = _mat->size(1);
+  if(!_E)
+  {
+    // Ad = exp(Ah)
+    SimpleMatrix Ah(n, n);
+    if(A)
+    {
+      Ah = *A;
+      Ah *= h;
+    }
+    // expm exits on a null matrix
+    if(Ah.normInf() > 0.)
+      Siconos::algebra::tools::expm(Ah, *_mat);
+    else
+      _mat->eye();
+  }
+  else
+  {
+    // int_0^h exp(At)dt E is the upper-right block of exp(h [A E; 0 0])
+    SimpleMatrix M(n + p, n + p);
+    if(A)
+      for(unsigned int j = 0; j < n; ++j)
+        for(unsigned int i = 0; i < n; ++i)
+          M(i, j) = h * (*A)(i, j);
+    for(unsigned int j = 0; j < p; ++j)
+      for(unsigned int i = 0; i < n; ++i)
+        M(i, n + j) = h * (*_E)(i, j);
+    SimpleMatrix expM(n + p, n + p);
+    if(M.normInf() > 0.)
+      Siconos::algebra::tools::expm(M, expM);
+    else
+      expM.eye();
+    for(unsigned int j = 0; j < p; ++j)
+      for(unsigned int i = 0; i < n; ++i)
+        (*_mat)(i, j) = expM(i, n + j);
+  }
+  cached.reset(new SimpleMatrix(*_mat));
+
+  DEBUG_EXPR(_mat->display(););
+  DEBUG_END("MatrixIntegrator::integrateClosedForm(double h)\n");
+}
+
 void MatrixIntegrator::integrate()
 {
   DEBUG_BEGIN("MatrixIntegrator::integrate()\n");
+  if(hasClosedForm())
+  {
+    integrateClosedForm(_TD->currentTimeStep(_k++));
+    DEBUG_END("MatrixIntegrator::integrate()\n");
+    return;
+  }
+
   SiconosVector& x0 = *_DS->x0();
   SiconosVector& x = *_DS->x();
 
@@ -30,6 +30,8 @@
 
 #include "SiconosFwd.hpp"
 
+#include <map>
+
 class MatrixIntegrator
 {
 private:
@@ -68,9 +70,30 @@ protected:
   /** OneStepIntegrator of type LsodarOSI */
   SP::LsodarOSI _OSI;
 
+  /** flag to compute _mat with a matrix exponential instead of the
+   * integration with LsodarOSI */
+  bool _closedForm = false;
+
+  /** index of the next time step, for the closed form */
+  unsigned int _k = 0;
+
+  /** results of the closed form, by time step */
+  std::map<double, SP::SimpleMatrix> _closedFormCache;
+
   /** */
   void commonInit(const DynamicalSystem& ds, const NonSmoothDynamicalSystem& nsds, const TimeDiscretisation & td);
 
+  /** \return true if A is constant and E is constant and given, so that
+   *  _mat can be computed with a matrix exponential */
+  bool hasClosedForm() const;
+
+  /** Computes _mat with a matrix exponential: \f$ \exp(Ah) \f$, or the
+   *  upper-right block of the exponential of
+   *  \f$ h\begin{bmatrix} A & E \\ 0 & 0 \end{bmatrix} \f$.
+   *  \param h the time step
+   */
+  void integrateClosedForm(double h);
+
   /** Default constructor */
   MatrixIntegrator() {};
 
@@ -110,6 +133,22 @@ public:
   /** Check whether the solution of the ODE is time-invariant*/
   inline bool isConst() { return _isConst; }
 
+  /** Compute _mat with a Padé matrix exponential, instead of one
+   *  integration with LsodarOSI per column, when A and E are constant.
+   *  The result for each time step is kept in this object and reused.
+   *  The two methods agree up to the integration tolerance only: the
+   *  closed form is not used unless it is enabled.
+   * \param closedForm true to use the closed form
+   */
+  inline void setClosedForm(bool closedForm) { _closedForm = closedForm; }
+
+  /** \return true if the closed form is enabled */
+  inline bool closedForm() const { return _closedForm; }
+
+  /** \return the number of time steps for which the closed form
+   *  has been computed */
+  inline unsigned int closedFormCacheSize() const { return _closedFormCache.size(); }
+
 };
 
 #endif
@@ -22,6 +22,7 @@
 #include "Tools.hpp"
 #include "BlockCSRMatrix.hpp"
 #include "SimulationGraphs.hpp"
+#include "InteractionsGraphSnapshot.hpp"
 #include "SimpleMatrix.hpp"
 #include "Interaction.hpp"
 #include "DynamicalSystem.hpp"
@@ -286,6 +287,80 @@ void OSNSMatrix::fillM(InteractionsGraph& indexSet, bool update)
   DEBUG_END("void OSNSMatrix::fillM(SP::InteractionsGraph indexSet, bool update)\n");
 }
 
+// Fill the matrix W using the arrays of the snapshot
+void OSNSMatrix::fillM(const InteractionsGraphSnapshot& snapshot, bool update)
+{
+  DEBUG_BEGIN("void OSNSMatrix::fillM(const InteractionsGraphSnapshot& snapshot, bool update)\n");
+  DEBUG_PRINTF(" update = %i\n", update);
+  assert(snapshot.graph());
+  if(update)
+  {
+    // same positions as updateSizeAndPositions(indexSet), saved in
+    // the properties where the snapshot reads them
+    unsigned int dim = 0;
+    for(unsigned int i = 0, n = snapshot.size(); i < n; ++i)
+    {
+      snapshot.properties(i).absolute_position = dim;
+      dim += snapshot.interactionSize(i);
+    }
+    assert(dim == snapshot.dimension());
+    _dimColumn = dim;
+    _dimRow = _dimColumn;
+  }
+
+  if(_storageType == NM_DENSE)
+  {
+    if(update)
+    {
+      if(! _M1)
+        _M1.reset(new SimpleMatrix(_dimRow, _dimColumn));
+      else
+      {
+        if(_M1->size(0) != _dimRow || _M1->size(1) != _dimColumn)
+          _M1->resize(_dimRow, _dimColumn);
+        _M1->zero();
+      }
+    }
+    SimpleMatrix& M1 = static_cast<SimpleMatrix&>(*_M1);
+
+    // Row by row: the diagonal block, then the blocks of the
+    // neighbours. Each edge is seen from its two vertices, so the
+    // upper block is set from the vertex with the lower position and
+    // the lower block from the other one.
+    for(unsigned int i = 0, n = snapshot.size(); i < n; ++i)
+    {
+      unsigned int pos = snapshot.position(i);
+      M1.setBlock(pos, pos, *snapshot.properties(i).block);
+
+      for(unsigned int k = snapshot.adjacencyBegin(i), kend = snapshot.adjacencyEnd(i);
+          k < kend; ++k)
+      {
+        unsigned int col = snapshot.position(snapshot.adjacentVertex(k));
+        const DynamicalSystemProperties& edgeProperties = snapshot.adjacentEdgeProperties(k);
+        assert(pos < _dimRow);
+        assert(col < _dimColumn);
+        assert(edgeProperties.upper_block);
+        assert(edgeProperties.lower_block);
+        if(pos < col)
+          M1.setBlock(pos, col, *edgeProperties.upper_block);
+        else
+          M1.setBlock(pos, col, *edgeProperties.lower_block);
+      }
+    }
+  }
+  else if(_storageType == NM_SPARSE_BLOCK)
+  {
+    // the block structure is built from the graph
+    if(! _M2)
+      _M2.reset(new BlockCSRMatrix(*snapshot.graph()));
+    else
+      _M2->fill(*snapshot.graph());
+  }
+  if(update)
+    convert();
+  DEBUG_END("void OSNSMatrix::fillM(const InteractionsGraphSnapshot& snapshot, bool update)\n");
+}
+
 // convert current matrix to NumericsMatrix structure
 void OSNSMatrix::convert()
 {
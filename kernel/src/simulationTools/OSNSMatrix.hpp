@@ -27,6 +27,8 @@
 #include "SimulationTypeDef.hpp"
 #include "NumericsMatrix.h" // for NM_types
 
+class InteractionsGraphSnapshot;
+
 /**
    Interface to some specific storage types for matrices used in
    OneStepNSProblem
@@ -251,6 +253,16 @@ public:
    */
   virtual void fillM(InteractionsGraph&indexSet, bool update = true);
 
+  /** fill the current class using the snapshot of an index set. The
+   *  dense storage loops over the arrays of the snapshot instead of
+   *  the graph; the result is the same as with fillM(indexSet, update).
+   * 
+   *  \param snapshot the up-to-date snapshot of the index set of the
+   *  active constraints
+   *  \param update if true update the size of the Matrix (default true)
+   */
+  virtual void fillM(const InteractionsGraphSnapshot& snapshot, bool update = true);
+
 
   /** Compute the M matrix given the inverse of W and H
    * 
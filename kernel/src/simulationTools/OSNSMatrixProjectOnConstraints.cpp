@@ -26,6 +26,7 @@
 #include "BlockCSRMatrix.hpp"
 #include "SimulationGraphs.hpp"
 #include "SimpleMatrix.hpp"
+#include "InteractionsGraphSnapshot.hpp"
 using namespace RELATION;
 using namespace Siconos;
 
@@ -177,6 +178,12 @@ void OSNSMatrixProjectOnConstraints::fillM(InteractionsGraph& indexSet, bool upd
     convert();
 }
 
+void OSNSMatrixProjectOnConstraints::fillM(const InteractionsGraphSnapshot& snapshot, bool update)
+{
+  assert(snapshot.graph());
+  fillM(*snapshot.graph(), update);
+}
+
 
 unsigned int OSNSMatrixProjectOnConstraints::computeSizeForProjection(SP::Interaction inter)
 {
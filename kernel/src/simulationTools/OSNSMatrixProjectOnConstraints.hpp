@@ -131,6 +131,13 @@ public:
   */
   void fillM(InteractionsGraph& indexSet, bool update = true);
 
+  /** fill the current class using the graph of the snapshot, since
+      the positions for projection are not stored in the snapshot
+      \param snapshot the up-to-date snapshot of the index set
+      \param update if true update the size and position
+  */
+  void fillM(const InteractionsGraphSnapshot& snapshot, bool update = true);
+
 };
 
 DEFINE_SPTR(OSNSMatrixProjectOnConstraints)
@@ -24,9 +24,47 @@
 #include "Relation.hpp"
 #include "EventsManager.hpp"
 #include <SiconosConfig.h>
+#include <algorithm>
+#include <exception>
 #include <functional>
+#include <unordered_map>
 using namespace std::placeholders;
 
+#ifdef _OPENMP
+namespace
+{
+// apply f to the interactions, one color after the other, the
+// interactions of a color in parallel
+template<typename F>
+void updateColoredInteractions(const std::vector<Interaction*>& interactions,
+                               const std::vector<unsigned int>& colors, F f)
+{
+  // exceptions must not escape the parallel region
+  std::exception_ptr error;
+  #pragma omp parallel
+  for(unsigned int k = 0; k + 1 < colors.size(); ++k)
+  {
+    int begin = colors[k], end = colors[k+1];
+    #pragma omp for schedule(dynamic, 16)
+    for(int i = begin; i < end; ++i)
+    {
+      try
+      {
+        f(*interactions[i]);
+      }
+      catch(...)
+      {
+        #pragma omp critical
+        error = std::current_exception();
+      }
+    }
+  }
+  if(error)
+    std::rethrow_exception(error);
+}
+}
+#endif
+
 SP::VectorOfVectors
 OneStepIntegrator::_initializeDSWorkVectors(SP::DynamicalSystem ds)
 {
@@ -149,10 +187,99 @@ void OneStepIntegrator::resetNonSmoothPart(unsigned int level)
   }
 }
 
+bool OneStepIntegrator::_colorInteractions(InteractionsGraph& indexSet0, bool byDS,
+                                           std::vector<Interaction*>& interactions,
+                                           std::vector<unsigned int>& colors)
+{
+  // colors already taken by the interactions which use a relation or
+  // a dynamical system
+  std::unordered_map<const void*, std::vector<bool>> taken;
+  std::vector<std::pair<Interaction*, unsigned int>> colored;
+  unsigned int ncolors = 0;
+
+  InteractionsGraph::VIterator ui, uiend;
+  for(std::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
+  {
+    if(!checkInteractionOSI(indexSet0, ui)) continue;
+    Interaction& inter = *indexSet0.bundle(*ui);
+    RELATION::TYPES relationType = inter.relation()->getType();
+    if(relationType != RELATION::Lagrangian && relationType != RELATION::NewtonEuler)
+      return false;
+
+    std::vector<bool>* resources[3];
+    unsigned int nresources = 0;
+    resources[nresources++] = &taken[inter.relation().get()];
+    if(byDS)
+    {
+      resources[nresources++] = &taken[indexSet0.properties(*ui).source.get()];
+      resources[nresources++] = &taken[indexSet0.properties(*ui).target.get()];
+    }
+
+    unsigned int color = 0;
+    if(byDS && _deterministicInput)
+    {
+      // after the previous interactions on the same dynamical systems
+      for(unsigned int r = 0; r < nresources; ++r)
+        color = std::max(color, (unsigned int) resources[r]->size());
+    }
+    else
+    {
+      // the first color which is free for all the resources
+      bool free = false;
+      while(!free)
+      {
+        free = true;
+        for(unsigned int r = 0; r < nresources && free; ++r)
+          free = color >= resources[r]->size() || !(*resources[r])[color];
+        if(!free) ++color;
+      }
+    }
+    for(unsigned int r = 0; r < nresources; ++r)
+    {
+      if(resources[r]->size() <= color)
+        resources[r]->resize(color + 1, false);
+      (*resources[r])[color] = true;
+    }
+    colored.push_back(std::make_pair(&inter, color));
+    ncolors = std::max(ncolors, color + 1);
+  }
+
+  if(colored.size() < 2)
+    return false;
+
+  // counting sort, the interactions of a color stay in the order of the
+  // vertices
+  colors.assign(ncolors + 1, 0);
+  for(const auto& c : colored)
+    colors[c.second + 1]++;
+  for(unsigned int k = 0; k < ncolors; ++k)
+    colors[k + 1] += colors[k];
+  interactions.resize(colored.size());
+  std::vector<unsigned int> next(colors.begin(), colors.end() - 1);
+  for(const auto& c : colored)
+    interactions[next[c.second]++] = c.first;
+  return true;
+}
+
 void OneStepIntegrator::updateOutput(double time, unsigned int level)
 {
   InteractionsGraph::VIterator ui, uiend;
   InteractionsGraph & indexSet0 = *_simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
+#ifdef _OPENMP
+  // the output only writes in the interaction and its relation
+  std::vector<Interaction*> interactions;
+  std::vector<unsigned int> colors;
+  if(_parallelInteractions && _colorInteractions(indexSet0, false, interactions, colors))
+  {
+    updateColoredInteractions(interactions, colors, [time, level](Interaction& inter)
+    {
+      assert(inter.lowerLevelForOutput() <= level);
+      assert(inter.upperLevelForOutput() >= level);
+      inter.computeOutput(time, level);
+    });
+    return;
+  }
+#endif
   for(std::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
   {
     if(!checkInteractionOSI(indexSet0, ui)) continue;
@@ -189,6 +316,22 @@ void OneStepIntegrator::updateInput(double time, unsigned int level)
   InteractionsGraph::VIterator ui, uiend;
   SP::Interaction inter;
   InteractionsGraph & indexSet0 = *_simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
+#ifdef _OPENMP
+  // the input is summed in the dynamical systems: the interactions
+  // updated concurrently must not share one
+  std::vector<Interaction*> interactions;
+  std::vector<unsigned int> colors;
+  if(_parallelInteractions && _colorInteractions(indexSet0, true, interactions, colors))
+  {
+    updateColoredInteractions(interactions, colors, [time, level](Interaction& inter)
+    {
+      assert(inter.lowerLevelForInput() <= level);
+      assert(inter.upperLevelForInput() >= level);
+      inter.computeInput(time, level);
+    });
+    return;
+  }
+#endif
   for(std::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
   {
     if(!checkInteractionOSI(indexSet0, ui)) continue;
@@ -102,6 +102,18 @@ protected:
 
   bool _explicitJacobiansOfRelation;
 
+  /** if true (default), the input and output of the Lagrangian and
+   *  Newton-Euler interactions are updated in parallel when OpenMP is
+   *  available
+   */
+  bool _parallelInteractions;
+
+  /** if true, the parallel update of the input sums the contributions
+   *  of the interactions to each dynamical system in the order of the
+   *  serial loop, false by default
+   */
+  bool _deterministicInput;
+
 
 
   /** A link to the simulation that owns this OSI */
@@ -115,7 +127,8 @@ protected:
     : _integratorType(type), _sizeMem(1), _steps(0),
       _levelMinForOutput(0), _levelMaxForOutput(0),
       _levelMinForInput(0), _levelMaxForInput(0),
-      _isInitialized(false), _explicitJacobiansOfRelation(false) {};
+      _isInitialized(false), _explicitJacobiansOfRelation(false),
+      _parallelInteractions(true), _deterministicInput(false) {};
 
   /** struct to add terms in the integration. Useful for Control */
   SP::ExtraAdditionalTerms _extraAdditionalTerms;
@@ -135,6 +148,21 @@ protected:
    */
   SP::VectorOfVectors _initializeDSWorkVectors(SP::DynamicalSystem ds);
 
+  /** sort the interactions of the index set 0 integrated by this osi
+   *  by color, for a parallel update: two interactions of the same
+   *  color share no relation and, with byDS, no dynamical system.
+   *
+   *  \param indexSet0 the index set 0
+   *  \param byDS if true, the interactions of a color share no dynamical system
+   *  \param interactions the interactions, sorted by color
+   *  \param colors the first interaction of each color, followed by
+   *  the number of interactions
+   *  \return false if the interactions must be updated serially
+   */
+  bool _colorInteractions(InteractionsGraph& indexSet0, bool byDS,
+                          std::vector<Interaction*>& interactions,
+                          std::vector<unsigned int>& colors);
+
   /** default constructor */
   OneStepIntegrator() {};
 
@@ -266,6 +294,46 @@ public:
     _explicitJacobiansOfRelation = newval;
   };
 
+  /** \return true if the input and output of the interactions are
+   *  updated in parallel
+   */
+  bool parallelInteractions() const
+  {
+    return _parallelInteractions;
+  }
+
+  /** update the input and output of the Lagrangian and Newton-Euler
+   *  interactions in parallel (only with OpenMP). The relations must
+   *  then be safe to evaluate concurrently for distinct interactions.
+   *
+   *  \param newval true (default) for a parallel update
+   */
+  void setParallelInteractions(bool newval)
+  {
+    _parallelInteractions = newval;
+  };
+
+  /** \return true if the parallel update of the input is deterministic
+   */
+  bool deterministicInput() const
+  {
+    return _deterministicInput;
+  }
+
+  /** sum the contributions of the interactions to the input of each
+   *  dynamical system in the order of the serial loop, so that the
+   *  parallel update gives the same result. Otherwise the order
+   *  depends on the coloring of the interactions only, and the result
+   *  does not depend on the number of threads either, but it may
+   *  differ from the serial one by rounding.
+   *
+   *  \param newval true for the order of the serial loop
+   */
+  void setDeterministicInput(bool newval)
+  {
+    _deterministicInput = newval;
+  };
+
   /** initialise the integrator
    */
   virtual void initialize();
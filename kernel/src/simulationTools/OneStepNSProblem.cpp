@@ -33,6 +33,8 @@
 #include "NonSmoothLaw.hpp"
 #include "Simulation.hpp"
 
+#include <exception>
+
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES
 #include "siconos_debug.h"
@@ -81,6 +83,8 @@ void OneStepNSProblem::updateInteractionBlocks()
   if(indexSet->properties().symmetric)
   {
     DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Symmetric case");
+    // blocks are allocated serially, then computed (possibly in parallel)
+    _diagonalBlockVertices.clear();
     InteractionsGraph::VIterator vi, viend;
     for(std::tie(vi, viend) = indexSet->vertices();
         vi != viend; ++vi)
@@ -94,8 +98,39 @@ void OneStepNSProblem::updateInteractionBlocks()
 
       if(!isLinear || !_hasBeenUpdated)
       {
-        computeDiagonalInteractionBlock(*vi);
+        _diagonalBlockVertices.push_back(*vi);
+      }
+    }
+
+    int nblocks = (int)_diagonalBlockVertices.size();
+    if(nblocks > 1 && prepareParallelInteractionBlocks())
+    {
+      // exceptions must not escape the parallel region
+      std::exception_ptr error;
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic, 16)
+#endif
+      for(int i = 0; i < nblocks; ++i)
+      {
+        try
+        {
+          computeDiagonalInteractionBlock(_diagonalBlockVertices[i]);
+        }
+        catch(...)
+        {
+#ifdef _OPENMP
+          #pragma omp critical
+#endif
+          error = std::current_exception();
+        }
       }
+      if(error)
+        std::rethrow_exception(error);
+    }
+    else
+    {
+      for(int i = 0; i < nblocks; ++i)
+        computeDiagonalInteractionBlock(_diagonalBlockVertices[i]);
     }
 
     /* interactionBlock must be zeroed at init */
@@ -108,6 +108,9 @@ protected:
   /*During Newton it, this flag allows to update the numerics matrices only once if necessary.*/
   bool _hasBeenUpdated = false;
 
+  /** vertices whose diagonal block is recomputed by updateInteractionBlocks (work buffer) */
+  std::vector<InteractionsGraph::VDescriptor> _diagonalBlockVertices;
+
   // --- CONSTRUCTORS/DESTRUCTOR ---
   /** default constructor */
   OneStepNSProblem() = default;
@@ -261,6 +264,18 @@ public:
    */
   virtual void computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd) = 0;
 
+  /** called by updateInteractionBlocks before the diagonal blocks are
+   *  computed. Derived classes may do here, serially, the lazy work shared
+   *  between blocks (factorizations ...).
+   *
+   *  \return true if computeDiagonalInteractionBlock may run concurrently
+   *  on the vertices of the index set (false by default)
+   */
+  virtual bool prepareParallelInteractionBlocks()
+  {
+    return false;
+  }
+
   /** \return bool _hasBeenUpdated
    */
   bool hasBeenUpdated()
@@ -390,6 +390,13 @@ public:
   */
   virtual void initialize();
 
+  /** \return true if initialize() has already been called
+   */
+  inline bool isInitialized() const
+  {
+    return _isInitialized;
+  };
+
   /** Initialize a single Interaction for this Simulation, used for dynamic
    *  topology updates. */
   virtual void initializeInteraction(double time, SP::Interaction inter);
@@ -85,12 +85,15 @@ Topology::__addInteractionInIndexSet0(SP::Interaction inter, SP::DynamicalSystem
 
   // _IG = L(_DSG),  L is the line graph transformation
   // vector of the Interaction
+  __updateLookupTables();
   DynamicalSystemsGraph::VDescriptor dsgv1, dsgv2;
   dsgv1 = _DSG[0]->add_vertex(ds1);
+  _dsByNumber.emplace(ds1->number(), dsgv1);
 
   if(ds2)
   {
     dsgv2 = _DSG[0]->add_vertex(ds2);
+    _dsByNumber.emplace(ds2->number(), dsgv2);
   }
   else
   {
@@ -104,6 +107,8 @@ Topology::__addInteractionInIndexSet0(SP::Interaction inter, SP::DynamicalSystem
   InteractionsGraph::VDescriptor ig_new_ve;
   DynamicalSystemsGraph::EDescriptor new_ed;
   std::tie(new_ed, ig_new_ve) = _DSG[0]->add_edge(dsgv1, dsgv2, inter, *_IG[0]);
+  _interactionByNumber[inter->number()] = ig_new_ve;
+  __lookupTablesUpToDate();
 
   inter->initializeLinkToDsVariables(*ds1, *ds2_);
 
@@ -215,18 +220,23 @@ struct VertexIsRemovedDS
    corresponding vertices are removed from _IG */
 void Topology::__removeInteractionFromIndexSet(SP::Interaction inter)
 {
+  __updateLookupTables();
+  __unregisterInteraction(inter);
 
   SP::DynamicalSystem ds1 = _IG[0]->properties(_IG[0]->descriptor(inter)).source;
   SP::DynamicalSystem ds2 = _IG[0]->properties(_IG[0]->descriptor(inter)).target;
   _DSG[0]->remove_out_edge_if(_DSG[0]->descriptor(ds1), VertexIsRemoved(inter, _DSG[0], _IG[0]));
   if(ds1 != ds2)
     _DSG[0]->remove_out_edge_if(_DSG[0]->descriptor(ds2), VertexIsRemoved(inter, _DSG[0], _IG[0]));
+  __lookupTablesUpToDate();
 }
 
 
 void Topology::insertDynamicalSystem(SP::DynamicalSystem ds)
 {
-  _DSG[0]->add_vertex(ds);
+  __updateLookupTables();
+  _dsByNumber.emplace(ds->number(), _DSG[0]->add_vertex(ds));
+  __lookupTablesUpToDate();
   setHasChanged(true);
 }
 
@@ -234,18 +244,125 @@ void Topology::insertDynamicalSystem(SP::DynamicalSystem ds)
    corresponding vertices are removed from _DSG */
 void Topology::__removeDynamicalSystemFromIndexSet(SP::DynamicalSystem ds)
 {
+  __updateLookupTables();
+  DynamicalSystemsGraph::VDescriptor dsgv = _DSG[0]->descriptor(ds);
+
+  // the interactions linked to ds are removed with it
+  DynamicalSystemsGraph::OEIterator oei, oeiend;
+  for(std::tie(oei, oeiend) = _DSG[0]->out_edges(dsgv); oei != oeiend; ++oei)
+  {
+    __unregisterInteraction(_DSG[0]->bundle(*oei));
+  }
+
+  auto itn = _dsByNumber.find(ds->number());
+  if(itn != _dsByNumber.end() && itn->second == dsgv)
+    _dsByNumber.erase(itn);
+  if(_DSG[0]->name.hasKey(dsgv))
+  {
+    auto its = _dsByName.find(_DSG[0]->name[dsgv]);
+    if(its != _dsByName.end() && its->second == dsgv)
+      _dsByName.erase(its);
+  }
+
   _DSG[0]->remove_edge_if(_DSG[0]->descriptor(ds),
                           VertexIsRemovedDS(ds, _DSG[0], _IG[0]));
 
   // note: remove_vertex also calls clear_vertex and removes all in/out edges
   _DSG[0]->remove_vertex(ds);
+  __lookupTablesUpToDate();
+}
+
+
+void Topology::__unregisterInteraction(SP::Interaction inter)
+{
+  if(!_IG[0]->is_vertex(inter))
+    return;
+
+  InteractionsGraph::VDescriptor igv = _IG[0]->descriptor(inter);
+  auto itn = _interactionByNumber.find(inter->number());
+  if(itn != _interactionByNumber.end() && itn->second == igv)
+    _interactionByNumber.erase(itn);
+  if(_IG[0]->name.hasKey(igv))
+  {
+    auto its = _interactionByName.find(_IG[0]->name[igv]);
+    if(its != _interactionByName.end() && its->second == igv)
+      _interactionByName.erase(its);
+  }
+}
+
+void Topology::__updateLookupTables() const
+{
+  if(_dsLookupStamp != _DSG[0]->structure_stamp())
+  {
+    DEBUG_PRINT("Topology::__updateLookupTables : rebuild ds tables\n");
+    _dsByNumber.clear();
+    _dsByName.clear();
+    DynamicalSystemsGraph::VIterator dsi, dsiend;
+    for(std::tie(dsi, dsiend) = _DSG[0]->vertices(); dsi != dsiend; ++dsi)
+    {
+      _dsByNumber.emplace(_DSG[0]->bundle(*dsi)->number(), *dsi);
+      if(_DSG[0]->name.hasKey(*dsi))
+        _dsByName.emplace(_DSG[0]->name[*dsi], *dsi);
+    }
+    _dsLookupStamp = _DSG[0]->structure_stamp();
+  }
+
+  if(_interactionLookupStamp != _IG[0]->structure_stamp())
+  {
+    DEBUG_PRINT("Topology::__updateLookupTables : rebuild interaction tables\n");
+    _interactionByNumber.clear();
+    _interactionByName.clear();
+    InteractionsGraph::VIterator ui, uiend;
+    for(std::tie(ui, uiend) = _IG[0]->vertices(); ui != uiend; ++ui)
+    {
+      _interactionByNumber.emplace(_IG[0]->bundle(*ui)->number(), *ui);
+      if(_IG[0]->name.hasKey(*ui))
+        _interactionByName.emplace(_IG[0]->name[*ui], *ui);
+    }
+    _interactionLookupStamp = _IG[0]->structure_stamp();
+  }
 }
 
+void Topology::__lookupTablesUpToDate()
+{
+  _dsLookupStamp = _DSG[0]->structure_stamp();
+  _interactionLookupStamp = _IG[0]->structure_stamp();
+}
+
+bool Topology::__findDynamicalSystem(unsigned int number,
+                                     DynamicalSystemsGraph::VDescriptor& dsgv) const
+{
+  __updateLookupTables();
+  auto it = _dsByNumber.find(number);
+  if(it == _dsByNumber.end())
+    return false;
+  dsgv = it->second;
+  return true;
+}
+
+bool Topology::__findInteraction(unsigned int number,
+                                 InteractionsGraph::VDescriptor& igv) const
+{
+  __updateLookupTables();
+  auto it = _interactionByNumber.find(number);
+  if(it == _interactionByNumber.end())
+    return false;
+  igv = it->second;
+  return true;
+}
 
 void Topology::setName(SP::DynamicalSystem ds, const std::string& name)
 {
+  __updateLookupTables();
   DynamicalSystemsGraph::VDescriptor dsgv = _DSG[0]->descriptor(ds);
+  if(_DSG[0]->name.hasKey(dsgv))
+  {
+    auto its = _dsByName.find(_DSG[0]->name[dsgv]);
+    if(its != _dsByName.end() && its->second == dsgv)
+      _dsByName.erase(its);
+  }
   _DSG[0]->name.insert(dsgv, name);
+  _dsByName[name] = dsgv;
 }
 
 std::string Topology::name(SP::DynamicalSystem ds)
@@ -259,8 +376,16 @@ std::string Topology::name(SP::DynamicalSystem ds)
 
 void Topology::setName(SP::Interaction inter, const std::string& name)
 {
+  __updateLookupTables();
   InteractionsGraph::VDescriptor igv = _IG[0]->descriptor(inter);
+  if(_IG[0]->name.hasKey(igv))
+  {
+    auto its = _interactionByName.find(_IG[0]->name[igv]);
+    if(its != _interactionByName.end() && its->second == igv)
+      _interactionByName.erase(its);
+  }
   _IG[0]->name.insert(igv, name);
+  _interactionByName[name] = igv;
 }
 
 std::string Topology::name(SP::Interaction inter)
@@ -391,24 +516,21 @@ void Topology::clear()
 {
   _IG.clear();
   _DSG.clear();
+  _dsByNumber.clear();
+  _dsByName.clear();
+  _interactionByNumber.clear();
+  _interactionByName.clear();
+  _dsLookupStamp = 0;
+  _interactionLookupStamp = 0;
 }
 
 SP::DynamicalSystem Topology::getDynamicalSystem(unsigned int requiredNumber) const
 {
-  DynamicalSystemsGraph::VIterator vi, vdend;
-  SP::DynamicalSystem ds;
-  unsigned int currentNumber;
-  for(std::tie(vi, vdend) = _DSG[0]->vertices(); vi != vdend; ++vi)
-  {
-    ds = _DSG[0]->bundle(*vi);
-    currentNumber = ds->number();
-    if(currentNumber == requiredNumber)
-      return ds;
-  }
-
-  THROW_EXCEPTION("Topology::getDynamicalSystem(n) ds not found.");
+  DynamicalSystemsGraph::VDescriptor dsgv;
+  if(!__findDynamicalSystem(requiredNumber, dsgv))
+    THROW_EXCEPTION("Topology::getDynamicalSystem(n) ds not found.");
 
-  return ds;
+  return _DSG[0]->bundle(dsgv);
 }
 
 
@@ -428,16 +550,28 @@ void Topology::displayDynamicalSystems() const
 
 SP::DynamicalSystem Topology::getDynamicalSystem(std::string name) const
 {
-  DynamicalSystemsGraph::VIterator vi, vdend;
-  for(std::tie(vi, vdend) = _DSG[0]->vertices(); vi != vdend; ++vi)
-  {
-    if(name == _DSG[0]->name.at(*vi))
-      return _DSG[0]->bundle(*vi);
-  }
+  __updateLookupTables();
+  auto it = _dsByName.find(name);
+  if(it == _dsByName.end())
+    THROW_EXCEPTION("Topology::getDynamicalSystem() ds not found.");
 
-  THROW_EXCEPTION("Topology::getDynamicalSystem() ds not found.");
+  return _DSG[0]->bundle(it->second);
+}
 
-  return SP::DynamicalSystem();
+std::vector<SP::DynamicalSystem>
+Topology::getDynamicalSystems(const std::vector<unsigned int>& numbers) const
+{
+  std::vector<SP::DynamicalSystem> result;
+  result.reserve(numbers.size());
+  DynamicalSystemsGraph::VDescriptor dsgv;
+  for(unsigned int number : numbers)
+  {
+    if(__findDynamicalSystem(number, dsgv))
+      result.push_back(_DSG[0]->bundle(dsgv));
+    else
+      result.push_back(SP::DynamicalSystem());
+  }
+  return result;
 }
 
 
@@ -494,30 +628,37 @@ unsigned int Topology::numberOfInvolvedDS(unsigned int inumber)
 
 SP::Interaction Topology::getInteraction(unsigned int requiredNumber) const
 {
-  InteractionsGraph::VIterator vi, vdend;
-  SP::Interaction inter;
-  unsigned int currentNumber;
-  for(std::tie(vi, vdend) = _IG[0]->vertices(); vi != vdend; ++vi)
-  {
-    inter = _IG[0]->bundle(*vi);
-    currentNumber = inter->number();
-    if(currentNumber == requiredNumber)
-      return inter;
-  }
+  InteractionsGraph::VDescriptor igv;
+  if(!__findInteraction(requiredNumber, igv))
+    return SP::Interaction();
 
-  return inter;
+  return _IG[0]->bundle(igv);
 }
 
 SP::Interaction Topology::getInteraction(std::string name) const
 {
-  DynamicalSystemsGraph::VIterator vi, vdend;
-  for(std::tie(vi, vdend) = _IG[0]->vertices(); vi != vdend; ++vi)
+  __updateLookupTables();
+  auto it = _interactionByName.find(name);
+  if(it == _interactionByName.end())
+    return SP::Interaction();
+
+  return _IG[0]->bundle(it->second);
+}
+
+std::vector<SP::Interaction>
+Topology::getInteractions(const std::vector<unsigned int>& numbers) const
+{
+  std::vector<SP::Interaction> result;
+  result.reserve(numbers.size());
+  InteractionsGraph::VDescriptor igv;
+  for(unsigned int number : numbers)
   {
-    if(name == _IG[0]->name.at(*vi))
-      return _IG[0]->bundle(*vi);
+    if(__findInteraction(number, igv))
+      result.push_back(_IG[0]->bundle(igv));
+    else
+      result.push_back(SP::Interaction());
   }
-
-  return SP::Interaction();
+  return result;
 }
 
 std::vector<SP::Interaction> Topology::interactionsForDS(
@@ -26,6 +26,8 @@
 #include "SimulationTypeDef.hpp"
 #include "SimulationGraphs.hpp"
 
+#include <unordered_map>
+
 /**
    This class describes the topology of the non-smooth dynamical
    system. It holds all the "potential" Interactions".
@@ -77,6 +79,23 @@ private:
   /** symmetry in the blocks computation */
   bool _symmetric = false;
 
+  /** lookup tables from DynamicalSystem number and name to vertex
+      descriptor in _DSG[0]. They are kept up to date by the insertions
+      and removals, and are not serialized: they are rebuilt from the
+      graph if it was modified by other means (see __updateLookupTables). */
+  mutable std::unordered_map<unsigned int, DynamicalSystemsGraph::VDescriptor> _dsByNumber;
+  mutable std::unordered_map<std::string, DynamicalSystemsGraph::VDescriptor> _dsByName;
+
+  /** lookup tables from Interaction number and name to vertex
+      descriptor in _IG[0] */
+  mutable std::unordered_map<unsigned int, InteractionsGraph::VDescriptor> _interactionByNumber;
+  mutable std::unordered_map<std::string, InteractionsGraph::VDescriptor> _interactionByName;
+
+  /** structure stamps of _DSG[0] and _IG[0] the lookup tables are
+      consistent with (0: never built) */
+  mutable size_t _dsLookupStamp = 0;
+  mutable size_t _interactionLookupStamp = 0;
+
   /** initializations ( time invariance) from non
       smooth laws kind */
   struct SetupFromNslaw;
@@ -108,6 +127,44 @@ private:
    */
   void __removeDynamicalSystemFromIndexSet(SP::DynamicalSystem ds);
 
+  /** remove an Interaction from the number and name lookup tables
+   *
+   *  \param inter a pointer to the Interaction, still a vertex of _IG[0]
+   */
+  void __unregisterInteraction(SP::Interaction inter);
+
+  /** rebuild the number and name lookup tables of a graph that was
+   *  modified without them being updated (after a deserialization, or
+   *  a direct modification of the graph for instance), detected with
+   *  the graph structure stamp
+   */
+  void __updateLookupTables() const;
+
+  /** record that the lookup tables are consistent with the current
+   *  graphs, to be called after updating them along with the graphs
+   */
+  void __lookupTablesUpToDate();
+
+  /** find the descriptor in _DSG[0] of the DynamicalSystem with a
+   *  given number
+   *
+   *  \param number the number of the DynamicalSystem
+   *  \param dsgv the descriptor, set if found
+   *  \return true if found
+   */
+  bool __findDynamicalSystem(unsigned int number,
+                             DynamicalSystemsGraph::VDescriptor& dsgv) const;
+
+  /** find the descriptor in _IG[0] of the Interaction with a given
+   *  number
+   *
+   *  \param number the number of the Interaction
+   *  \param igv the descriptor, set if found
+   *  \return true if found
+   */
+  bool __findInteraction(unsigned int number,
+                         InteractionsGraph::VDescriptor& igv) const;
+
   /* forbid copy and assignment */
   Topology(const Topology&) = delete;
   Topology& operator=(const Topology&) = delete;
@@ -351,8 +408,8 @@ public:
   /** initialize graphs properties */
   void setProperties();
 
-  /** Get a dynamical system using its number
-   *  \warning O(n) complexity
+  /** Get a dynamical system using its number (the one it had when
+   *  inserted)
    *
    *  \param requiredNumber the required number
    *  \return a DynamicalSystem
@@ -364,29 +421,44 @@ public:
   void displayDynamicalSystems() const;
 
   /** Get a dynamical system using its name
-   *  \warning O(n) complexity
    *
    *  \param name the name of the dynamical system
    *  \return a DynamicalSystem
    */
   SP::DynamicalSystem getDynamicalSystem(std::string name) const;
 
-  /** Get a interaction using its number
-   *  \warning O(n) complexity
+  /** Get a interaction using its number (the one it had when linked)
    *
    *  \param requiredNumber the required number
-   *  \return an Interaction
+   *  \return an Interaction, or a null pointer if not found
    */
   SP::Interaction getInteraction(unsigned int requiredNumber) const;
 
   /** Get a interaction using its name
-   *  \warning O(n) complexity
    *
    *  \param name the name of the Interaction
-   *  \return an Interaction pointer
+   *  \return an Interaction pointer, or a null pointer if not found
    */
   SP::Interaction getInteraction(std::string name) const;
 
+  /** Get several dynamical systems using their numbers
+   *
+   *  \param numbers the required numbers
+   *  \return a vector of DynamicalSystem, with a null pointer for
+   *  each number that is not found
+   */
+  std::vector<SP::DynamicalSystem>
+    getDynamicalSystems(const std::vector<unsigned int>& numbers) const;
+
+  /** Get several interactions using their numbers
+   *
+   *  \param numbers the required numbers
+   *  \return a vector of Interaction, with a null pointer for each
+   *  number that is not found
+   */
+  std::vector<SP::Interaction>
+    getInteractions(const std::vector<unsigned int>& numbers) const;
+
   /** get Interactions for a given DS
    *
    *  \return a vector of pointers to Interaction
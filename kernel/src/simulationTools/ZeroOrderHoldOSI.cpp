@@ -51,7 +51,7 @@ using namespace RELATION;
 
 // --- constructor from a minimum set of data ---
 ZeroOrderHoldOSI::ZeroOrderHoldOSI():
-  OneStepIntegrator(OSI::ZOHOSI), _useGammaForRelation(false)
+  OneStepIntegrator(OSI::ZOHOSI), _useGammaForRelation(false), _closedForm(false)
 {
   _steps = 1;
   _levelMinForOutput= 0;
@@ -80,6 +80,7 @@ void ZeroOrderHoldOSI::initializeWorkVectorsForDS(double t, SP::DynamicalSystem
   if(!DSG0.Ad.hasKey(dsgVD))
   {
     DSG0.Ad[dsgVD].reset(new MatrixIntegrator(*ds, *_simulation->nonSmoothDynamicalSystem(), _simulation->eventsManager()->timeDiscretisation()));
+    DSG0.Ad.at(dsgVD)->setClosedForm(_closedForm);
     if(DSG0.Ad.at(dsgVD)->isConst())
       DSG0.Ad.at(dsgVD)->integrate();
   }
@@ -91,6 +92,7 @@ void ZeroOrderHoldOSI::initializeWorkVectorsForDS(double t, SP::DynamicalSystem
     SP::SiconosMatrix E(new SimpleMatrix(ds->n(), ds->n(), 0));
     E->eye();
     DSG0.AdInt.insert(dsgVD, SP::MatrixIntegrator(new MatrixIntegrator(*ds,* _simulation->nonSmoothDynamicalSystem(),_simulation->eventsManager()->timeDiscretisation(), E)));
+    DSG0.AdInt.at(dsgVD)->setClosedForm(_closedForm);
     if(DSG0.AdInt.at(dsgVD)->isConst())
       DSG0.AdInt.at(dsgVD)->integrate();
   }
@@ -120,6 +122,7 @@ void ZeroOrderHoldOSI::initializeWorkVectorsForDS(double t, SP::DynamicalSystem
         if(!relR.getPluginJacLg()->isPlugged())
         {
           DSG0.Bd[dsgVD].reset(new MatrixIntegrator(*ds,*_simulation->nonSmoothDynamicalSystem(),_simulation->eventsManager()->timeDiscretisation(), relR.B()));
+          DSG0.Bd.at(dsgVD)->setClosedForm(_closedForm);
           if(DSG0.Bd.at(dsgVD)->isConst())
             DSG0.Bd.at(dsgVD)->integrate();
         }
@@ -55,6 +55,10 @@ protected:
   /** Unused for now */
   bool _useGammaForRelation;
 
+  /** compute Ad, AdInt and Bd with matrix exponentials, see
+   *  MatrixIntegrator::setClosedForm */
+  bool _closedForm;
+
 public:
   enum ZeroOrderHoldOSI_ds_workVector_id {
     RESIDU_FREE,
@@ -99,6 +103,17 @@ public:
    */
   const SiconosMatrix &Bd(SP::DynamicalSystem ds);
 
+  /** compute \f$ \Phi \f$ and \f$ B_d \f$ with matrix exponentials
+   *  instead of integrations with LsodarOSI when the system matrices
+   *  are constant. Must be set before the initialization.
+   *
+   *  \param closedForm true to use the closed form
+   */
+  inline void setClosedForm(bool closedForm) { _closedForm = closedForm; }
+
+  /** \return true if the matrices are computed in closed form */
+  inline bool closedForm() const { return _closedForm; }
+
   // --- OTHER FUNCTIONS ---
 
   /*initialization of the ZeroOrderHoldOSI integrator */
@@ -0,0 +1,173 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "InteractionsGraphSnapshotTest.hpp"
+#include "InteractionsGraphSnapshot.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "Topology.hpp"
+#include "LagrangianDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "Interaction.hpp"
+#include "OSNSMatrix.hpp"
+#include "SimpleMatrix.hpp"
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(InteractionsGraphSnapshotTest);
+
+
+void InteractionsGraphSnapshotTest::setUp()
+{
+  // a chain ds1 - ds2 - ds3, with one interaction on ds1 alone
+  nsds.reset(new NonSmoothDynamicalSystem(0., 10.));
+  ds1.reset(new LagrangianDS(std::make_shared<SiconosVector>(3),
+                             std::make_shared<SiconosVector>(3)));
+  ds2.reset(new LagrangianDS(std::make_shared<SiconosVector>(3),
+                             std::make_shared<SiconosVector>(3)));
+  ds3.reset(new LagrangianDS(std::make_shared<SiconosVector>(3),
+                             std::make_shared<SiconosVector>(3)));
+  nsds->insertDynamicalSystem(ds1);
+  nsds->insertDynamicalSystem(ds2);
+  nsds->insertDynamicalSystem(ds3);
+
+  SP::NonSmoothLaw nsl(new NewtonImpactNSL(0.0));
+  inter1.reset(new Interaction(nsl, std::make_shared<LagrangianLinearTIR>(std::make_shared<SimpleMatrix>(1, 3))));
+  inter2.reset(new Interaction(nsl, std::make_shared<LagrangianLinearTIR>(std::make_shared<SimpleMatrix>(1, 6))));
+  inter3.reset(new Interaction(nsl, std::make_shared<LagrangianLinearTIR>(std::make_shared<SimpleMatrix>(1, 6))));
+  nsds->link(inter1, ds1);
+  nsds->link(inter2, ds1, ds2);
+  nsds->link(inter3, ds2, ds3);
+}
+
+void InteractionsGraphSnapshotTest::tearDown()
+{}
+
+void InteractionsGraphSnapshotTest::testBuild()
+{
+  InteractionsGraph& indexSet = *nsds->topology()->indexSet0();
+  InteractionsGraphSnapshot snapshot;
+
+  // the positions belong to the OSNSMatrix: the snapshot reads them
+  // and must not overwrite them
+  InteractionsGraph::VIterator vi, viend;
+  unsigned int i = 0;
+  for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi, ++i)
+    indexSet.properties(*vi).absolute_position = 10 + i;
+
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", snapshot.update(indexSet), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", snapshot.graph() == &indexSet, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", snapshot.size(), 3u);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", snapshot.dimension(), 3u);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", snapshot.edgesNumber(), 2u);
+
+  unsigned int degree = 0;
+  i = 0;
+  for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi, ++i)
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", snapshot.vertex(i) == *vi, true);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", &snapshot.interaction(i) == indexSet.bundle(*vi).get(), true);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", &snapshot.properties(i) == &indexSet.properties(*vi), true);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", indexSet.properties(*vi).absolute_position, 10 + i);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", snapshot.position(i), 10 + i);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", snapshot.interactionSize(i), 1u);
+
+    // the neighbours are the same as in the graph
+    for(unsigned int k = snapshot.adjacencyBegin(i); k < snapshot.adjacencyEnd(i); ++k)
+    {
+      InteractionsGraph::VDescriptor vd = snapshot.vertex(snapshot.adjacentVertex(k));
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", indexSet.edge_exists(*vi, vd), true);
+      degree++;
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBuild : ", degree, 4u);
+}
+
+void InteractionsGraphSnapshotTest::testUpdate()
+{
+  InteractionsGraph& indexSet = *nsds->topology()->indexSet0();
+  InteractionsGraphSnapshot snapshot;
+  snapshot.update(indexSet);
+
+  // no change in the graph : nothing to do
+  indexSet.update_vertices_indices();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.isUpToDate(indexSet), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.update(indexSet), false);
+
+  // a new interaction
+  SP::Interaction inter4(new Interaction(std::make_shared<NewtonImpactNSL>(0.0),
+                                         std::make_shared<LagrangianLinearTIR>(std::make_shared<SimpleMatrix>(1, 6))));
+  nsds->link(inter4, ds1, ds3);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.isUpToDate(indexSet), false);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.update(indexSet), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.size(), 4u);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.dimension(), 4u);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.edgesNumber(), 5u);
+
+  // removal
+  nsds->removeInteraction(inter1);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.update(indexSet), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.size(), 3u);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.edgesNumber(), 3u);
+
+  // another graph
+  InteractionsGraph other;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.update(other), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.size(), 0u);
+
+  snapshot.clear();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testUpdate : ", snapshot.isUpToDate(other), false);
+}
+
+void InteractionsGraphSnapshotTest::testFillM()
+{
+  InteractionsGraph& indexSet = *nsds->topology()->indexSet0();
+
+  // set some values in the diagonal and extra-diagonal blocks
+  double value = 1.;
+  InteractionsGraph::VIterator vi, viend;
+  for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+  {
+    indexSet.properties(*vi).block.reset(new SimpleMatrix(1, 1));
+    (*indexSet.properties(*vi).block)(0, 0) = value++;
+  }
+  InteractionsGraph::EIterator ei, eiend;
+  for(std::tie(ei, eiend) = indexSet.edges(); ei != eiend; ++ei)
+  {
+    indexSet.properties(*ei).upper_block.reset(new SimpleMatrix(1, 1));
+    indexSet.properties(*ei).lower_block.reset(new SimpleMatrix(1, 1));
+    (*indexSet.properties(*ei).upper_block)(0, 0) = value++;
+    (*indexSet.properties(*ei).lower_block)(0, 0) = value++;
+  }
+
+  OSNSMatrix M1(indexSet, NM_DENSE);
+
+  InteractionsGraphSnapshot snapshot;
+  snapshot.update(indexSet);
+  for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+    indexSet.properties(*vi).absolute_position = 0;
+  OSNSMatrix M2;
+  M2.fillM(snapshot);
+
+  // the fill has set the positions read by the snapshot
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillM : ", M2.size(), 3u);
+  for(unsigned int i = 0; i < snapshot.size(); ++i)
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillM : ", snapshot.position(i), i);
+  SimpleMatrix diff(*M1.defaultMatrix());
+  diff -= *M2.defaultMatrix();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillM : ", diff.normInf() == 0., true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillM : ", M2.defaultMatrix()->normInf() > 0., true);
+}
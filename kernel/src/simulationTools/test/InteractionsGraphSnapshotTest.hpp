@@ -0,0 +1,53 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __InteractionsGraphSnapshotTest__
+#define __InteractionsGraphSnapshotTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "SiconosFwd.hpp"
+
+class InteractionsGraphSnapshotTest : public CppUnit::TestFixture
+{
+
+private:
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(InteractionsGraphSnapshotTest);
+
+  // tests to be done ...
+  CPPUNIT_TEST(testBuild);
+  CPPUNIT_TEST(testUpdate);
+  CPPUNIT_TEST(testFillM);
+  CPPUNIT_TEST_SUITE_END();
+
+  void testBuild();
+  void testUpdate();
+  void testFillM();
+
+  // Members
+  SP::NonSmoothDynamicalSystem nsds;
+  SP::DynamicalSystem ds1, ds2, ds3;
+  SP::Interaction inter1, inter2, inter3;
+
+public:
+
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
@@ -18,6 +18,8 @@
 #include "OSNSPTest.hpp"
 #include "SolverOptions.h"
 #include "FrictionContact.hpp"
+#include "SiconosKernel.hpp"
+#include "SiconosConfig.h"
 
 // test suite registration
 CPPUNIT_TEST_SUITE_REGISTRATION(OSNSPTest);
@@ -58,3 +60,199 @@ void OSNSPTest::testOSNSBuild_options()
   auto options_link = problem->numericsSolverOptions();
   CPPUNIT_ASSERT_EQUAL_MESSAGE("test solver options : ",  options_link->solverId == SICONOS_FRICTION_3D_ADMM, true);
 }
+
+void OSNSPTest::testInteractionBlocks()
+{
+  // a ball held between two walls: both contacts are active at each step
+  unsigned int nDof = 3;
+  double m = 2.;
+  SP::SiconosMatrix Mass(new SimpleMatrix(nDof, nDof));
+  (*Mass)(0, 0) = m;
+  (*Mass)(1, 1) = m;
+  (*Mass)(2, 2) = m;
+  SP::SiconosVector q0(new SiconosVector(nDof));
+  SP::SiconosVector v0(new SiconosVector(nDof));
+  // non linear DS type, to get the blocks updated at each step
+  SP::LagrangianDS ball(new LagrangianDS(q0, v0, Mass));
+  SP::SiconosVector weight(new SiconosVector(nDof));
+  (*weight)(0) = -m * 9.81;
+  ball->setFExtPtr(weight);
+
+  SP::SimpleMatrix H1(new SimpleMatrix(1, nDof));
+  (*H1)(0, 0) = 1.0;
+  SP::SimpleMatrix H2(new SimpleMatrix(1, nDof));
+  (*H2)(0, 0) = -1.0;
+  SP::NonSmoothLaw nslaw(new NewtonImpactNSL(0.));
+  SP::Interaction inter1(new Interaction(nslaw, SP::Relation(new LagrangianLinearTIR(H1))));
+  SP::Interaction inter2(new Interaction(nslaw, SP::Relation(new LagrangianLinearTIR(H2))));
+
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0, 1));
+  nsds->insertDynamicalSystem(ball);
+  nsds->link(inter1, ball);
+  nsds->link(inter2, ball);
+
+  SP::MoreauJeanOSI osi(new MoreauJeanOSI(0.5));
+  SP::TimeDiscretisation td(new TimeDiscretisation(0, 0.01));
+  SP::TimeStepping s(new TimeStepping(nsds, td, osi, SP::OneStepNSProblem(new LCP())));
+
+  for(unsigned int k = 0; k < 5; ++k)
+  {
+    s->computeOneStep();
+    s->nextStep();
+  }
+
+  // blocks are H W^{-1} H^T with W = M
+  SP::InteractionsGraph indexSet = s->indexSet(1);
+  CPPUNIT_ASSERT_EQUAL((size_t) 2, indexSet->size());
+  InteractionsGraph::VIterator vi, viend;
+  for(std::tie(vi, viend) = indexSet->vertices(); vi != viend; ++vi)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1. / m, (*indexSet->properties(*vi).block)(0, 0), 1e-14);
+  InteractionsGraph::EIterator ei, eiend;
+  for(std::tie(ei, eiend) = indexSet->edges(); ei != eiend; ++ei)
+  {
+    SP::SiconosMatrix block = indexSet->properties(*ei).upper_block;
+    if(!block) block = indexSet->properties(*ei).lower_block;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-1. / m, (*block)(0, 0), 1e-14);
+  }
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0., ball->q()->getValue(0), 1e-12);
+
+  // steady state: no new scratch matrix in the block workspace (other
+  // allocations are not counted)
+  std::size_t allocations = LinearOSNS::blockWorkspaceAllocations();
+  CPPUNIT_ASSERT(allocations > 0);
+  for(unsigned int k = 0; k < 50; ++k)
+  {
+    s->computeOneStep();
+    s->nextStep();
+  }
+  CPPUNIT_ASSERT_EQUAL(allocations, LinearOSNS::blockWorkspaceAllocations());
+}
+
+void OSNSPTest::testParallelInteractionBlocks()
+{
+  // balls of different masses, slightly below the ground so that all
+  // the contacts stay active: many independent diagonal blocks,
+  // computed in parallel with OpenMP
+  unsigned int nBalls = 40;
+  unsigned int nDof = 3;
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0, 1));
+  SP::MoreauJeanOSI osi(new MoreauJeanOSI(0.5));
+  std::vector<SP::LagrangianDS> balls;
+  SP::NonSmoothLaw nslaw(new NewtonImpactNSL(0.));
+  SP::SimpleMatrix H(new SimpleMatrix(1, nDof));
+  (*H)(0, 0) = 1.0;
+  for(unsigned int i = 0; i < nBalls; ++i)
+  {
+    double m = 1. + i;
+    SP::SiconosMatrix Mass(new SimpleMatrix(nDof, nDof));
+    (*Mass)(0, 0) = m;
+    (*Mass)(1, 1) = m;
+    (*Mass)(2, 2) = m;
+    SP::SiconosVector q0(new SiconosVector(nDof));
+    (*q0)(0) = -0.01;
+    SP::LagrangianDS ball(new LagrangianDS(q0, std::make_shared<SiconosVector>(nDof), Mass));
+    SP::SiconosVector weight(new SiconosVector(nDof));
+    (*weight)(0) = -m * 9.81;
+    ball->setFExtPtr(weight);
+    nsds->insertDynamicalSystem(ball);
+    nsds->link(std::make_shared<Interaction>(nslaw, std::make_shared<LagrangianLinearTIR>(H)), ball);
+    balls.push_back(ball);
+  }
+
+  SP::LCP lcp(new LCP());
+  SP::TimeDiscretisation td(new TimeDiscretisation(0, 0.01));
+  SP::TimeStepping s(new TimeStepping(nsds, td, osi, lcp));
+  for(unsigned int k = 0; k < 5; ++k)
+  {
+    s->computeOneStep();
+    s->nextStep();
+  }
+
+  // the parallel loop is used only when built with OpenMP
+  SP::InteractionsGraph indexSet = s->indexSet(1);
+  CPPUNIT_ASSERT_EQUAL((size_t) nBalls, indexSet->size());
+#ifdef WITH_OPENMP
+  CPPUNIT_ASSERT(lcp->prepareParallelInteractionBlocks());
+#else
+  CPPUNIT_ASSERT(!lcp->prepareParallelInteractionBlocks());
+#endif
+
+  // blocks are H W^{-1} H^T with W = M
+  InteractionsGraph::VIterator vi, viend;
+  for(std::tie(vi, viend) = indexSet->vertices(); vi != viend; ++vi)
+  {
+    SP::DynamicalSystem ds = indexSet->properties(*vi).source;
+    double m = (*std::static_pointer_cast<LagrangianDS>(ds)->mass())(0, 0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1. / m, (*indexSet->properties(*vi).block)(0, 0), 1e-14);
+  }
+  for(SP::LagrangianDS& ball : balls)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., ball->velocity()->getValue(0), 1e-12);
+}
+
+void OSNSPTest::testParallelInteractionUpdate()
+{
+  // a row of balls, each one touching the ground and its neighbours:
+  // the interactions share the balls, the input must be summed without
+  // conflicts
+  unsigned int nBalls = 40;
+  unsigned int nDof = 3;
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0, 1));
+  SP::MoreauJeanOSI osi(new MoreauJeanOSI(0.5));
+  std::vector<SP::LagrangianDS> balls;
+  SP::NonSmoothLaw nslaw(new NewtonImpactNSL(0.));
+  SP::SimpleMatrix Hground(new SimpleMatrix(1, nDof));
+  (*Hground)(0, 0) = 1.0;
+  SP::SimpleMatrix Hpair(new SimpleMatrix(1, 2 * nDof));
+  (*Hpair)(0, 0) = -1.0;
+  (*Hpair)(0, nDof) = 1.0;
+  for(unsigned int i = 0; i < nBalls; ++i)
+  {
+    SP::SiconosVector q0(new SiconosVector(nDof));
+    SP::SiconosVector v0(new SiconosVector(nDof));
+    (*q0)(0) = 1. + 0.1 * i;
+    (*v0)(0) = std::sin(1. + i);
+    SP::LagrangianDS ball(new LagrangianDS(q0, v0, std::make_shared<SimpleMatrix>(nDof, nDof, Siconos::IDENTITY)));
+    nsds->insertDynamicalSystem(ball);
+    nsds->link(std::make_shared<Interaction>(nslaw, std::make_shared<LagrangianLinearTIR>(Hground)), ball);
+    if(i > 0)
+      nsds->link(std::make_shared<Interaction>(nslaw, std::make_shared<LagrangianLinearTIR>(Hpair)),
+                 balls.back(), ball);
+    balls.push_back(ball);
+  }
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(0, 0.01));
+  SP::TimeStepping s(new TimeStepping(nsds, td, osi, std::make_shared<LCP>()));
+  s->initialize();
+
+  InteractionsGraph& indexSet0 = *nsds->topology()->indexSet0();
+  InteractionsGraph::VIterator vi, viend;
+  unsigned int k = 0;
+  for(std::tie(vi, viend) = indexSet0.vertices(); vi != viend; ++vi)
+    indexSet0.bundle(*vi)->lambda(1)->setValue(0, std::cos(1. + 0.3 * k++));
+
+  auto update = [&](bool parallel, bool deterministic)
+  {
+    osi->setParallelInteractions(parallel);
+    osi->setDeterministicInput(deterministic);
+    osi->resetNonSmoothPart(1);
+    osi->updateInput(0., 1);
+    osi->updateOutput(0., 1);
+    std::vector<double> result;
+    for(SP::LagrangianDS& ball : balls)
+      result.push_back(ball->p(1)->getValue(0));
+    for(std::tie(vi, viend) = indexSet0.vertices(); vi != viend; ++vi)
+      result.push_back(indexSet0.bundle(*vi)->y(1)->getValue(0));
+    return result;
+  };
+
+  std::vector<double> serial = update(false, false);
+  std::vector<double> ordered = update(true, true);
+  std::vector<double> colored = update(true, false);
+  for(unsigned int i = 0; i < serial.size(); ++i)
+  {
+    // same summation order as the serial loop: same result
+    CPPUNIT_ASSERT_EQUAL(serial[i], ordered[i]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(serial[i], colored[i], 1e-14);
+  }
+  CPPUNIT_ASSERT(std::fabs(serial[nBalls / 2]) > 0.);
+}
@@ -31,11 +31,17 @@ private:
   CPPUNIT_TEST(testOSNSBuild_default);
   CPPUNIT_TEST(testOSNSBuild_solverid);
   CPPUNIT_TEST(testOSNSBuild_options);
+  CPPUNIT_TEST(testInteractionBlocks);
+  CPPUNIT_TEST(testParallelInteractionBlocks);
+  CPPUNIT_TEST(testParallelInteractionUpdate);
   CPPUNIT_TEST_SUITE_END();
 
   void testOSNSBuild_default();
   void testOSNSBuild_solverid();
   void testOSNSBuild_options();
+  void testInteractionBlocks();
+  void testParallelInteractionBlocks();
+  void testParallelInteractionUpdate();
 
 
 public:
@@ -18,6 +18,7 @@
 #include "ZOHTest.hpp"
 #include "EventsManager.hpp"
 #include "SiconosAlgebraProd.hpp"
+#include "MatrixIntegrator.hpp"
 
 #define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
             if ((alpha) == (omega)) CPPUNIT_FAIL(message);
@@ -340,3 +341,56 @@ void ZOHTest::testMatrixIntegration4()
   std::cout << "------- Integration Ok, error = " << (dataPlot - dataPlotRef).normInf() << " -------" <<std::endl;
   CPPUNIT_ASSERT_EQUAL_MESSAGE("testMatrixExp4 : ", (dataPlot - dataPlotRef).normInf() < _tol, true);
 }
+
+void ZOHTest::testClosedForm()
+{
+  std::cout << "===========================================" <<std::endl;
+  std::cout << " ===== ZOH tests start ... ===== " <<std::endl;
+  std::cout << "===========================================" <<std::endl;
+  std::cout << "------- Closed-form computation of the matrices -------" <<std::endl;
+  // Ad of an oscillator, computed by the integrator
+  _A->zero();
+  (*_A)(0, 1) = 1;
+  (*_A)(1, 0) = -1;
+  _DS.reset(new FirstOrderLinearTIDS(_x0, _A, _b));
+  _TD.reset(new TimeDiscretisation(_t0, _h));
+  _model.reset(new NonSmoothDynamicalSystem(_t0, _T));
+  _sim.reset(new TimeStepping(_model, _TD, 0));
+  _ZOH.reset(new ZeroOrderHoldOSI());
+  _ZOH->setClosedForm(true);
+  _model->insertDynamicalSystem(_DS);
+  _sim->associate(_ZOH, _DS);
+  _sim->initialize();
+  SimpleMatrix AdRef(_n, _n);
+  AdRef(0, 0) = cos(_h);
+  AdRef(0, 1) = sin(_h);
+  AdRef(1, 0) = -sin(_h);
+  AdRef(1, 1) = cos(_h);
+  double diff = (AdRef - _ZOH->Ad(_DS)).normInf();
+  std::cout << "------- Ad error = " << diff << " -------" <<std::endl;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testClosedForm Ad : ", diff < _tol, true);
+
+  // Bd of a double integrator with time steps .1, .1, .05
+  _A->zero();
+  (*_A)(0, 1) = 1;
+  _DS.reset(new FirstOrderLinearTIDS(_x0, _A, _b));
+  TkVector tk = {0., .1, .2, .25, .3};
+  _TD.reset(new TimeDiscretisation(tk));
+  _model.reset(new NonSmoothDynamicalSystem(0., .3));
+  SP::SimpleMatrix E(new SimpleMatrix(_n, 1, 0));
+  (*E)(1, 0) = 1;
+  MatrixIntegrator Bd(*_DS, *_model, *_TD, E);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testClosedForm isConst : ", Bd.isConst(), false);
+  Bd.setClosedForm(true);
+  double h[3] = {.1, .1, .05};
+  for(unsigned int k = 0; k < 3; ++k)
+  {
+    Bd.integrate();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testClosedForm Bd0 : ", std::abs(Bd.mat()(0, 0) - h[k] * h[k] / 2) < _tol, true);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testClosedForm Bd1 : ", std::abs(Bd.mat()(1, 0) - h[k]) < _tol, true);
+  }
+  // the second step reuses the result of the first one
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testClosedForm cache : ", Bd.closedFormCacheSize() == 2, true);
+  std::cout << "------- Closed-form computations ok -------" <<std::endl;
+  std::cout <<std::endl <<std::endl;
+}
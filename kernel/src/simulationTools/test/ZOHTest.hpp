@@ -49,6 +49,7 @@ private:
   CPPUNIT_TEST(testMatrixIntegration2);
   CPPUNIT_TEST(testMatrixIntegration3);
   CPPUNIT_TEST(testMatrixIntegration4);
+  CPPUNIT_TEST(testClosedForm);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -60,6 +61,7 @@ private:
   void testMatrixIntegration2();
   void testMatrixIntegration3();
   void testMatrixIntegration4();
+  void testClosedForm();
   // Members
 
   unsigned int _n;
@@ -26,6 +26,149 @@
 #include "BlockVector.hpp"
 #include "SiconosVector.hpp"
 #include "SiconosException.hpp"
+#include "SiconosBlas.h"
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace
+{
+// Dense products: the storage type is checked once by the callers below,
+// then small operands (dimensions up to SMALL_SIZE, i.e. the usual DS and
+// contact sizes) go to kernels specialized at compile time, and larger
+// ones to BLAS.
+
+constexpr unsigned int SMALL_SIZE = 12;
+
+typedef void (*SmallGemvKernel)(double alpha, const double* A, const double* x,
+                                double beta, double* y);
+typedef void (*SmallGemmKernel)(unsigned int n, double alpha, const double* A,
+                                const double* B, double beta, double* C);
+
+/* y = alpha * r + beta * y, y not being read if beta == 0 */
+template<unsigned int M>
+inline void smallUpdate(double alpha, const double* r, double beta, double* y)
+{
+  if(beta == 0.)
+    for(unsigned int i = 0; i < M; ++i) y[i] = alpha * r[i];
+  else
+    for(unsigned int i = 0; i < M; ++i) y[i] = beta * y[i] + alpha * r[i];
+}
+
+/* y = alpha * A x + beta * y, A being M x N, column-major */
+template<unsigned int M, unsigned int N>
+void smallGemv(double alpha, const double* A, const double* x, double beta, double* y)
+{
+  double Ax[M] = {};
+  for(unsigned int j = 0; j < N; ++j)
+    for(unsigned int i = 0; i < M; ++i)
+      Ax[i] += A[i + j * M] * x[j];
+  smallUpdate<M>(alpha, Ax, beta, y);
+}
+
+/* y = alpha * trans(A) x + beta * y, A being M x N, column-major */
+template<unsigned int M, unsigned int N>
+void smallGemvTrans(double alpha, const double* A, const double* x, double beta, double* y)
+{
+  double Ax[N] = {};
+  for(unsigned int j = 0; j < N; ++j)
+    for(unsigned int i = 0; i < M; ++i)
+      Ax[j] += A[i + j * M] * x[i];
+  smallUpdate<N>(alpha, Ax, beta, y);
+}
+
+/* C = alpha * A B + beta * C, A being M x K and B K x n, column-major */
+template<unsigned int M, unsigned int K>
+void smallGemm(unsigned int n, double alpha, const double* A, const double* B,
+               double beta, double* C)
+{
+  for(unsigned int j = 0; j < n; ++j)
+    smallGemv<M, K>(alpha, A, B + j * K, beta, C + j * M);
+}
+
+template<std::size_t... I>
+constexpr std::array<SmallGemvKernel, sizeof...(I)> smallGemvTable(std::index_sequence<I...>)
+{
+  return {{ &smallGemv<I / SMALL_SIZE + 1, I % SMALL_SIZE + 1>... }};
+}
+
+template<std::size_t... I>
+constexpr std::array<SmallGemvKernel, sizeof...(I)> smallGemvTransTable(std::index_sequence<I...>)
+{
+  return {{ &smallGemvTrans<I / SMALL_SIZE + 1, I % SMALL_SIZE + 1>... }};
+}
+
+template<std::size_t... I>
+constexpr std::array<SmallGemmKernel, sizeof...(I)> smallGemmTable(std::index_sequence<I...>)
+{
+  return {{ &smallGemm<I / SMALL_SIZE + 1, I % SMALL_SIZE + 1>... }};
+}
+
+// kernels indexed by (rows - 1) * SMALL_SIZE + (cols - 1) of the left operand
+const std::array<SmallGemvKernel, SMALL_SIZE * SMALL_SIZE> smallGemvKernels =
+  smallGemvTable(std::make_index_sequence<SMALL_SIZE * SMALL_SIZE>());
+const std::array<SmallGemvKernel, SMALL_SIZE * SMALL_SIZE> smallGemvTransKernels =
+  smallGemvTransTable(std::make_index_sequence<SMALL_SIZE * SMALL_SIZE>());
+const std::array<SmallGemmKernel, SMALL_SIZE * SMALL_SIZE> smallGemmKernels =
+  smallGemmTable(std::make_index_sequence<SMALL_SIZE * SMALL_SIZE>());
+
+/* y = beta * y, y of size n, without reading y if beta == 0 */
+inline void scaleOutput(unsigned int n, double beta, double* y)
+{
+  if(beta == 0.)
+    std::fill(y, y + n, 0.);
+  else if(beta != 1.)
+    for(unsigned int i = 0; i < n; ++i) y[i] *= beta;
+}
+
+/* y = alpha * op(A) x + beta * y, op(A) = A or trans(A). y is not read if
+   beta == 0. x and y must not overlap. */
+void denseGemv(bool trans, double alpha, const DenseMat& Ad, const DenseVect& xd,
+               double beta, DenseVect& yd)
+{
+  const unsigned int m = Ad.size1(), n = Ad.size2();
+  double* y = yd.data().data();
+  if(m == 0 || n == 0)
+  {
+    scaleOutput(yd.size(), beta, y);
+    return;
+  }
+  const double* A = Ad.data().data();
+  const double* x = xd.data().data();
+  if(m <= SMALL_SIZE && n <= SMALL_SIZE)
+  {
+    unsigned int kernel = (m - 1) * SMALL_SIZE + (n - 1);
+    (trans ? smallGemvTransKernels : smallGemvKernels)[kernel](alpha, A, x, beta, y);
+  }
+  else
+    cblas_dgemv(CblasColMajor, trans ? CblasTrans : CblasNoTrans, m, n, alpha,
+                A, m, x, 1, beta, y, 1);
+}
+
+/* C = alpha * A B + beta * C. C is not read if beta == 0. C must not
+   overlap A or B. */
+void denseGemm(double alpha, const DenseMat& Ad, const DenseMat& Bd, double beta, DenseMat& Cd)
+{
+  const unsigned int m = Ad.size1(), n = Bd.size2(), k = Ad.size2();
+  if(m == 0 || n == 0)
+    return;
+  double* C = Cd.data().data();
+  if(k == 0)
+  {
+    scaleOutput(m * n, beta, C);
+    return;
+  }
+  const double* A = Ad.data().data();
+  const double* B = Bd.data().data();
+  if(m <= SMALL_SIZE && k <= SMALL_SIZE)
+  {
+    smallGemmKernels[(m - 1) * SMALL_SIZE + (k - 1)](n, alpha, A, B, beta, C);
+  }
+  else
+    cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, n, k, alpha,
+                A, m, B, k, beta, C, m);
+}
+}
 
 void prod(const SiconosMatrix& A, const SiconosVector& x, BlockVector& y, bool init)
 {
@@ -101,6 +244,12 @@ void prod(const SiconosMatrix& A, const SiconosVector& x, SiconosVector& y, bool
     }
   }
 
+  else if(numA == Siconos::DENSE && numX == Siconos::DENSE
+          && numY == Siconos::DENSE && &x != &y)
+  {
+    denseGemv(false, 1.0, *A.dense(), *x.dense(), init ? 0. : 1., *y.dense());
+  }
+
   else // A is not 0 or identity
   {
 
@@ -291,6 +440,12 @@ void prod(const SiconosVector& x, const SiconosMatrix& A, SiconosVector& y, bool
     }
   }
 
+  else if(numA == Siconos::DENSE && numX == Siconos::DENSE
+          && numY == Siconos::DENSE && &x != &y)
+  {
+    denseGemv(true, 1.0, *A.dense(), *x.dense(), init ? 0. : 1., *y.dense());
+  }
+
   else // A is not 0 or identity
   {
     {
@@ -597,6 +752,12 @@ void prod(const SiconosMatrix& A, const SiconosMatrix& B, SiconosMatrix& C, bool
     prod(A, B, tmp, init);
     C = tmp;
   }
+  else if(numA == Siconos::DENSE && numB == Siconos::DENSE && numC == Siconos::DENSE
+          && &C != &A && &C != &B)
+  {
+    denseGemm(1.0, *A.dense(), *B.dense(), init ? 0. : 1., *C.dense());
+    C.resetFactorizationFlags();
+  }
   else // neither A or B is equal to identity or zero.
   {
     if(init)
@@ -964,6 +1125,12 @@ void prod(double a, const SiconosMatrix& A, const SiconosVector& x, SiconosVecto
     scal(a, x, y, init);
   }
 
+  else if(numA == Siconos::DENSE && numX == Siconos::DENSE
+          && numY == Siconos::DENSE && &x != &y)
+  {
+    denseGemv(false, a, *A.dense(), *x.dense(), init ? 0. : 1., *y.dense());
+  }
+
   else // A is not 0 or identity
   {
 
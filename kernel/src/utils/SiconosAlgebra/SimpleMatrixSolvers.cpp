@@ -443,8 +443,14 @@ void SimpleMatrix::Solve(SiconosMatrix &B)
     THROW_EXCEPTION(" SimpleMatrix::Solve: only implemented for dense and sparse matrices in RHS.");
 
 #else
-  B.updateNumericsMatrix();
-  NumericsMatrix * NM_B = B.numericsMatrix();
+  // A dense rhs is solved in place on its array: wrapping it in a fresh
+  // NumericsMatrix at each call is only needed for sparse storage.
+  NumericsMatrix * NM_B = nullptr;
+  if(B.num() != DENSE)
+  {
+    B.updateNumericsMatrix();
+    NM_B = B.numericsMatrix();
+  }
   //NM_display(NM_B);
 #endif
 
@@ -458,7 +464,8 @@ void SimpleMatrix::Solve(SiconosMatrix &B)
 #ifdef SPARSE_RHS_COPY_TO_DENSE
       info  = NM_Cholesky_solve(NM, b, B.size(1));
 #else
-      info  = NM_Cholesky_solve_matrix_rhs(NM, NM_B);
+      info  = NM_B ? NM_Cholesky_solve_matrix_rhs(NM, NM_B)
+              : NM_Cholesky_solve(NM, B.getArray(), B.size(1));
 #endif
       if(info != 0)
       {
@@ -476,7 +483,8 @@ void SimpleMatrix::Solve(SiconosMatrix &B)
 #ifdef SPARSE_RHS_COPY_TO_DENSE
     info  = NM_LU_solve(NM, b, B.size(1));
 #else
-    info  = NM_LU_solve_matrix_rhs(NM, NM_B);
+    info  = NM_B ? NM_LU_solve_matrix_rhs(NM, NM_B)
+            : NM_LU_solve(NM, B.getArray(), B.size(1));
 #endif
     if(info != 0)
     {
@@ -0,0 +1,150 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Microbenchmark of the dense products of SiconosAlgebra (prod for
+   matrix-vector, transposed matrix-vector and matrix-matrix) against the
+   plain ublas products, on the usual DS/contact shapes and on a few larger
+   ones. Results are checked against ublas: the program fails on mismatch.
+
+   Usage: ProdBenchmark [scale] where scale multiplies the number of
+   repetitions (default 1, kept small to run as a test). */
+
+#include "SiconosVector.hpp"
+#include "SimpleMatrix.hpp"
+#include "SiconosAlgebraProd.hpp"
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+std::mt19937 generator(42);
+
+void randomize(SiconosMatrix& A)
+{
+  std::uniform_real_distribution<double> d(-1., 1.);
+  for(unsigned int i = 0; i < A.size(0); ++i)
+    for(unsigned int j = 0; j < A.size(1); ++j)
+      A(i, j) = d(generator);
+}
+
+void randomize(SiconosVector& x)
+{
+  std::uniform_real_distribution<double> d(-1., 1.);
+  for(unsigned int i = 0; i < x.size(); ++i)
+    x(i) = d(generator);
+}
+
+// repetitions so that each measure does about the same amount of flops
+unsigned int repetitions(double flops, unsigned int scale)
+{
+  double r = 2e6 * scale / flops;
+  return r < 1. ? 1 : (unsigned int) r;
+}
+
+template<typename F>
+double nanoseconds(unsigned int n, F f)
+{
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i < n; ++i)
+    f();
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / n;
+}
+
+bool check(const char* what, double error, double tol = 1e-12)
+{
+  if(error > tol)
+  {
+    std::printf("%s: error %g exceeds %g\n", what, error, tol);
+    return false;
+  }
+  return true;
+}
+
+bool benchGemv(unsigned int m, unsigned int n, unsigned int scale)
+{
+  SimpleMatrix A(m, n);
+  SiconosVector x(n), xt(m), y(m), yt(n);
+  randomize(A);
+  randomize(x);
+  randomize(xt);
+  DenseVect yref(m), ytref(n);
+  unsigned int rep = repetitions(2. * m * n, scale);
+
+  double tprod = nanoseconds(rep, [&]() { prod(A, x, y, true); });
+  double tublas = nanoseconds(rep, [&]() { ublas::noalias(yref) = ublas::prod(*A.dense(), *x.dense()); });
+  double tprodT = nanoseconds(rep, [&]() { prod(xt, A, yt, true); });
+  double tublasT = nanoseconds(rep, [&]() { ublas::noalias(ytref) = ublas::prod(ublas::trans(*A.dense()), *xt.dense()); });
+  std::printf("gemv  %4u x %-4u       prod %10.1f ns  ublas %10.1f ns  | trans prod %10.1f ns  ublas %10.1f ns\n",
+              m, n, tprod, tublas, tprodT, tublasT);
+
+  // += and scaled variants
+  SiconosVector y2(y);
+  prod(A, x, y2, false);
+  SiconosVector y3(m);
+  prod(2., A, x, y3, true);
+  return check("gemv", ublas::norm_inf(*y.dense() - yref))
+         && check("gemv trans", ublas::norm_inf(*yt.dense() - ytref))
+         && check("gemv +=", ublas::norm_inf(*y2.dense() - 2. * yref))
+         && check("gemv scaled", ublas::norm_inf(*y3.dense() - 2. * yref));
+}
+
+bool benchGemm(unsigned int m, unsigned int n, unsigned int k, unsigned int scale)
+{
+  SimpleMatrix A(m, k), B(k, n), C(m, n);
+  randomize(A);
+  randomize(B);
+  DenseMat Cref(m, n);
+  unsigned int rep = repetitions(2. * m * n * k, scale);
+
+  double tprod = nanoseconds(rep, [&]() { prod(A, B, C, true); });
+  double tublas = nanoseconds(rep, [&]() { ublas::noalias(Cref) = ublas::prod(*A.dense(), *B.dense()); });
+  std::printf("gemm  %4u x %-4u x %-4u prod %10.1f ns  ublas %10.1f ns\n", m, n, k, tprod, tublas);
+
+  SimpleMatrix C2(C);
+  prod(A, B, C2, false);
+  return check("gemm", ublas::norm_inf(*C.dense() - Cref), 1e-12 * k)
+         && check("gemm +=", ublas::norm_inf(*C2.dense() - 2. * Cref), 1e-12 * k);
+}
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned int scale = argc > 1 ? std::atoi(argv[1]) : 1;
+  if(scale == 0) scale = 1;
+
+  bool ok = true;
+  const unsigned int gemvShapes[][2] = {{1, 3}, {2, 3}, {3, 3}, {3, 6}, {6, 6}, {3, 12},
+    {12, 12}, {13, 13}, {50, 50}, {200, 200}
+  };
+  for(const auto& s : gemvShapes)
+    ok = benchGemv(s[0], s[1], scale) && ok;
+
+  const unsigned int gemmShapes[][3] = {{2, 2, 3}, {3, 3, 6}, {3, 6, 6}, {6, 6, 6},
+    {12, 12, 12}, {13, 13, 13}, {50, 50, 50}, {100, 100, 100}
+  };
+  for(const auto& s : gemmShapes)
+    ok = benchGemm(s[0], s[1], s[2], scale) && ok;
+
+  return ok ? 0 : 1;
+}
@@ -22,6 +22,7 @@
 #endif
 
 #include <map>
+#include <mutex>
 #include <stddef.h>                     // for nullptr
 #include <iostream>                     // for operator<<, basic_ostream, etc
 #include <utility>                      // for make_pair, pair
@@ -32,6 +33,8 @@ namespace SiconosSharedLibrary
 
 std::multimap<const std::string, PluginHandle> openedPlugins;
 typedef std::multimap<const std::string, PluginHandle>::iterator iter;
+// plugins may be loaded by simulations running in different threads
+std::mutex openedPluginsMutex;
 
 PluginHandle loadPlugin(const std::string& pluginPath)
 {
@@ -65,6 +68,7 @@ PluginHandle loadPlugin(const std::string& pluginPath)
     THROW_EXCEPTION("can not open or find plugin");
   }
 #endif
+  std::lock_guard<std::mutex> lock(openedPluginsMutex);
   openedPlugins.insert(std::make_pair(pluginPath, HandleRes));
   return HandleRes;
 }
@@ -96,6 +100,7 @@ void * getProcAddress(PluginHandle plugin, const std::string& procedure)
 
 void closePlugin(const std::string& pluginFile)
 {
+  std::lock_guard<std::mutex> lock(openedPluginsMutex);
   iter it = openedPlugins.find(pluginFile);
   if(it == openedPlugins.end())
   {
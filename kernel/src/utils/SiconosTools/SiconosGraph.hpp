@@ -41,6 +41,7 @@
 #endif
 
 #include <limits>
+#include <atomic>
 #include <boost/graph/graph_utility.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_concepts.hpp>
@@ -70,6 +71,16 @@ namespace boost
   BOOST_INSTALL_PROPERTY(edge, siconos_bundle);
 }
 
+#ifndef SWIG
+/** a new structure stamp, unique among all the graphs of the process
+ *  (see SiconosGraph::structure_stamp())
+ */
+inline size_t siconos_graph_new_structure_stamp()
+{
+  static std::atomic<size_t> last_stamp(0);
+  return ++last_stamp;
+}
+#endif
 
 
 template < class V, class E, class VProperties,
@@ -186,15 +197,26 @@ protected:
 
   graph_t g;
 
+  /** to be called after any modification of the vertices or edges
+   *  sets that does not go through the members of this class */
+  void structure_changed()
+  {
+    _structure_stamp = siconos_graph_new_structure_stamp();
+  }
+
 private:
 
+  /** changed on each modification of the vertices or edges sets */
+  size_t _structure_stamp;
+
   SiconosGraph(const SiconosGraph&);
 
 public:
 
   /** default constructor
    */
-  SiconosGraph() : _stamp(0)
+  SiconosGraph() : _stamp(0),
+    _structure_stamp(siconos_graph_new_structure_stamp())
   {
   };
 
@@ -497,6 +519,7 @@ public:
     if (current_vertex_iterator == vertex_descriptor.end())
     {
       new_vertex_descriptor = boost::add_vertex(g);
+      structure_changed();
 
       assert(vertex(size() - 1, g) == new_vertex_descriptor);
       assert(size() == vertex_descriptor.size() + 1);
@@ -587,6 +610,7 @@ public:
     assert(!adjacent_vertex_exists(vd));
 #endif
     boost::remove_vertex(vd, g);
+    structure_changed();
 
     assert(vertex_descriptor.size() == (size() + 1));
 
@@ -619,6 +643,7 @@ public:
     assert(!is_edge(vd1, vd2, e_bundle));
 
     std::tie(new_edge, inserted) = boost::add_edge(vd1, vd2, g);
+    structure_changed();
 
     // During a gdb session, I saw that inserted is always going to be true ...
     // This check is therefore unnecessary.
@@ -729,6 +754,7 @@ public:
     assert(adjacent_vertex_exists(source(ed)));
 
     boost::remove_edge(ed, g);
+    structure_changed();
     /* debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -774,6 +800,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_out_edge_if(vd, pred, g);
+    structure_changed();
     /* workaround on multisetS (tested on Disks : ok)
        multiset allows for member removal without invalidating iterators
 
@@ -807,6 +834,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_in_edge_if(vd, pred, g);
+    structure_changed();
     /*  debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -827,6 +855,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_edge_if(pred, g);
+    structure_changed();
     /*  debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -839,6 +868,18 @@ public:
     return _stamp;
   }
 
+  /** a stamp that changes each time a vertex or an edge is added or
+   *  removed. Contrary to stamp(), it is not modified by the
+   *  update of the indices, and two different graphs never share the
+   *  same value, so that (graph, structure_stamp()) identifies a
+   *  given state of the vertices and edges sets.
+   *  \return the structure stamp
+   */
+  size_t structure_stamp() const
+  {
+    return _structure_stamp;
+  }
+
   void update_vertices_indices()
   {
     VIterator vi, viend;
@@ -867,6 +908,7 @@ public:
   {
     g.clear();
     vertex_descriptor.clear();
+    structure_changed();
   };
 
   VMap vertex_descriptor_map() const
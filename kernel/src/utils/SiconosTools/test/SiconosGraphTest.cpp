@@ -370,3 +370,43 @@ void SiconosGraphTest::t8()
   CPPUNIT_ASSERT(g.bundle(vd6) == "three");
 
 }
+
+// structure stamp
+void SiconosGraphTest::t9()
+{
+  typedef SiconosGraph < std::string, int,
+          boost::no_property, boost::no_property, boost::no_property > G;
+  typedef SiconosGraph < int, std::string,
+          boost::no_property, boost::no_property, boost::no_property > AG;
+  G g, g2;
+  AG ag;
+
+  CPPUNIT_ASSERT(g.structure_stamp() != g2.structure_stamp());
+
+  size_t stamp = g.structure_stamp();
+  G::VDescriptor vd1 = g.add_vertex("hello");
+  CPPUNIT_ASSERT(g.structure_stamp() != stamp);
+
+  // an existing vertex does not change the structure
+  stamp = g.structure_stamp();
+  g.add_vertex("hello");
+  CPPUNIT_ASSERT(g.structure_stamp() == stamp);
+
+  // indices update does not change the structure
+  g.update_vertices_indices();
+  g.update_edges_indices();
+  CPPUNIT_ASSERT(g.structure_stamp() == stamp);
+
+  G::VDescriptor vd2 = g.add_vertex("goodbye");
+  stamp = g.structure_stamp();
+  g.add_edge(vd1, vd2, 1, ag);
+  CPPUNIT_ASSERT(g.structure_stamp() != stamp);
+
+  stamp = g.structure_stamp();
+  g.remove_vertex("goodbye");
+  CPPUNIT_ASSERT(g.structure_stamp() != stamp);
+
+  stamp = g.structure_stamp();
+  g.clear();
+  CPPUNIT_ASSERT(g.structure_stamp() != stamp);
+}
@@ -47,6 +47,7 @@ private:
 
   CPPUNIT_TEST(t7);
   CPPUNIT_TEST(t8);
+  CPPUNIT_TEST(t9);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -59,6 +60,7 @@ private:
   void t6();
   void t7();
   void t8();
+  void t9();
 
 public:
   void setUp();
@@ -6,6 +6,10 @@ if(WITH_TESTING)
   begin_tests(src/collision/native/test DEPS "numerics;kernel;CPPUNIT::CPPUNIT")
   new_test(SOURCES MultiBodyTest.cpp ${SIMPLE_TEST_MAIN})
 
+  # ---- Joints ----
+  begin_tests(src/joints/test DEPS "numerics;kernel")
+  new_test(NAME JointChainBenchmark SOURCES JointChainBenchmark.cpp)
+
   if(SICONOS_HAS_BULLET)
     begin_tests(src/collision/bullet/test DEPS "numerics;kernel;CPPUNIT::CPPUNIT")
     new_test(SOURCES  ContactTest.cpp ${SIMPLE_TEST_MAIN})
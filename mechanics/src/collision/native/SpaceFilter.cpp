@@ -23,6 +23,10 @@
 
 
 #include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <tuple>
 //#define DEBUG_MESSAGES 1
 #include "siconos_debug.h"
 
@@ -53,6 +57,213 @@ std::size_t hash_value(SP::Hashed const& h)
   return seed;
 }
 
+/* uniform grid */
+
+/* spread the 21 lower bits of x, 2 zeros between each bit */
+static inline uint64_t morton_spread(uint64_t x)
+{
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffff;
+  x = (x | x << 16) & 0x1f0000ff0000ff;
+  x = (x | x << 8) & 0x100f00f00f00f00f;
+  x = (x | x << 4) & 0x10c30c30c30c30c3;
+  x = (x | x << 2) & 0x1249249249249249;
+  return x;
+}
+
+uint64_t space_grid::morton(int i, int j, int k)
+{
+  /* cells coordinates are shifted in [0, 2^21[, two different cells
+   * may have the same code far from the origin, the coordinates are
+   * kept in the entries for this reason */
+  const int64_t shift = 1 << 20;
+  return morton_spread((uint64_t)(i + shift))
+         | morton_spread((uint64_t)(j + shift)) << 1
+         | morton_spread((uint64_t)(k + shift)) << 2;
+}
+
+static inline bool operator <(space_grid::cell_entry const& a,
+                              space_grid::cell_entry const& b)
+{
+  if(a.code != b.code) return a.code < b.code;
+  if(a.i != b.i) return a.i < b.i;
+  if(a.j != b.j) return a.j < b.j;
+  if(a.k != b.k) return a.k < b.k;
+  return a.body < b.body;
+}
+
+void space_grid::clear()
+{
+  _bodies.clear();
+  _cells.clear();
+  _index.clear();
+  _candidates_start.clear();
+  _candidates.clear();
+}
+
+unsigned int space_grid::_body_index(SP::DynamicalSystem ds)
+{
+  auto it = _index.find(ds.get());
+  if(it != _index.end())
+    return it->second;
+
+  unsigned int b = _bodies.size();
+  _index[ds.get()] = b;
+  body_entry body;
+  body.ds = ds;
+  body.x = body.y = body.z = body.radius = 0.;
+  body.planar = true;
+  body.bounded = false;
+  _bodies.push_back(body);
+  return b;
+}
+
+unsigned int space_grid::add_body(SP::DynamicalSystem ds, double x, double y,
+                                  double z, double radius, bool planar)
+{
+  unsigned int b = _body_index(ds);
+  body_entry& body = _bodies[b];
+  body.x = x;
+  body.y = y;
+  body.z = z;
+  body.radius = radius;
+  body.planar = planar;
+  body.bounded = true;
+  return b;
+}
+
+void space_grid::insert(SP::DynamicalSystem ds, int i, int j, int k)
+{
+  cell_entry entry = { morton(i, j, k), i, j, k, _body_index(ds) };
+  _cells.push_back(entry);
+}
+
+bool space_grid::find(const DynamicalSystem* ds, unsigned int& index) const
+{
+  auto it = _index.find(ds);
+  if(it == _index.end())
+    return false;
+  index = it->second;
+  return true;
+}
+
+std::pair<std::vector<space_grid::cell_entry>::const_iterator,
+    std::vector<space_grid::cell_entry>::const_iterator>
+space_grid::equal_range(int i, int j, int k) const
+{
+  cell_entry first = { morton(i, j, k), i, j, k, 0 };
+  cell_entry last = first;
+  last.body = std::numeric_limits<unsigned int>::max();
+  return std::make_pair(std::lower_bound(_cells.begin(), _cells.end(), first),
+                        std::upper_bound(_cells.begin(), _cells.end(), last));
+}
+
+void space_grid::build(unsigned int bboxfactor, unsigned int cellsize)
+{
+  const long n = _bodies.size();
+  const double cs = cellsize;
+
+  /* 1: the cells covered by the bounding box of each body */
+  std::vector<int> range(6 * n);
+  std::vector<size_t> start(n + 1, 0);
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for(long b = 0; b < n; ++b)
+  {
+    const body_entry& body = _bodies[b];
+    int* r = &range[6 * b];
+    if(body.bounded)
+    {
+      double d = bboxfactor * body.radius;
+      r[0] = (int) floor((body.x - d) / cs);
+      r[1] = (int) floor((body.x + d) / cs);
+      r[2] = (int) floor((body.y - d) / cs);
+      r[3] = (int) floor((body.y + d) / cs);
+      r[4] = body.planar ? 0 : (int) floor((body.z - d) / cs);
+      r[5] = body.planar ? 0 : (int) floor((body.z + d) / cs);
+      start[b + 1] = (size_t)(r[1] - r[0] + 1) * (r[3] - r[2] + 1) * (r[5] - r[4] + 1);
+    }
+  }
+  std::partial_sum(start.begin(), start.end(), start.begin());
+
+  /* the cells inserted explicitly are kept at the beginning */
+  size_t inserted = _cells.size();
+  _cells.resize(inserted + start[n]);
+
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for(long b = 0; b < n; ++b)
+  {
+    if(!_bodies[b].bounded) continue;
+    const int* r = &range[6 * b];
+    cell_entry* entry = &_cells[inserted + start[b]];
+    for(int i = r[0]; i <= r[1]; ++i)
+      for(int j = r[2]; j <= r[3]; ++j)
+        for(int k = r[4]; k <= r[5]; ++k, ++entry)
+        {
+          entry->code = morton(i, j, k);
+          entry->i = i;
+          entry->j = j;
+          entry->k = k;
+          entry->body = b;
+        }
+  }
+
+  /* 2: Morton order */
+  std::sort(_cells.begin(), _cells.end());
+
+  /* 3: candidates = the other bodies in the cell of the center */
+  std::vector<cell_entry>::const_iterator cbegin = _cells.begin();
+  std::vector<size_t> cell_first(n), cell_last(n);
+  _candidates_start.assign(n + 1, 0);
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for(long b = 0; b < n; ++b)
+  {
+    const body_entry& body = _bodies[b];
+    if(!body.bounded)
+    {
+      // no center: the body is only a candidate of the bodies whose
+      // center is in one of its cells
+      cell_first[b] = cell_last[b] = 0;
+      continue;
+    }
+    int i = (int) floor(body.x / cs);
+    int j = (int) floor(body.y / cs);
+    int k = body.planar ? 0 : (int) floor(body.z / cs);
+    auto cell = equal_range(i, j, k);
+    cell_first[b] = cell.first - cbegin;
+    cell_last[b] = cell.second - cbegin;
+    size_t count = 0;
+    for(auto e = cell.first; e != cell.second; ++e)
+    {
+      // a body may have been inserted twice in the cell
+      if(e->body != (unsigned int) b && (e == cell.first || e->body != (e - 1)->body))
+        ++count;
+    }
+    _candidates_start[b + 1] = count;
+  }
+  std::partial_sum(_candidates_start.begin(), _candidates_start.end(),
+                   _candidates_start.begin());
+  _candidates.resize(_candidates_start[n]);
+
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for(long b = 0; b < n; ++b)
+  {
+    unsigned int* c = &_candidates[_candidates_start[b]];
+    for(auto e = cbegin + cell_first[b]; e != cbegin + cell_last[b]; ++e)
+    {
+      if(e->body != (unsigned int) b && (e == cbegin + cell_first[b] || e->body != (e - 1)->body))
+        *c++ = e->body;
+    }
+  }
+}
+
 SpaceFilter::SpaceFilter(unsigned int bboxfactor,
                          unsigned int cellsize,
                          SP::SiconosMatrix plans,
@@ -62,6 +273,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
   _plans(plans),
   _moving_plans(moving_plans),
   _hash_table(new space_hash()),
+  _grid(new space_grid()),
   diskdisk_relations(new DiskDiskRDeclaredPool()),
   diskplan_relations(new DiskPlanRDeclaredPool()),
   circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -74,6 +286,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
   _cellsize(cellsize),
   _plans(plans),
   _hash_table(new space_hash()),
+  _grid(new space_grid()),
   diskdisk_relations(new DiskDiskRDeclaredPool()),
   diskplan_relations(new DiskPlanRDeclaredPool()),
   circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -81,6 +294,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
 
 SpaceFilter::SpaceFilter() :
   _hash_table(new space_hash()),
+  _grid(new space_grid()),
   diskdisk_relations(new DiskDiskRDeclaredPool()),
   diskplan_relations(new DiskPlanRDeclaredPool()),
   circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -97,105 +311,29 @@ public:
 
   using SiconosVisitor::visit;
 
+  /* the cells are computed in space_grid::build */
   void visit(SP::Disk pds)
   {
-    int i, j, imin, imax, jmin, jmax;
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for(i = imin; i <= imax; ++i)
-    {
-      for(j = jmin; j <= jmax; ++j)
-      {
-        parent.insert(pds, i, j, 0);
-      }
-    }
+    parent._grid->add_body(pds, pds->getQ(0), pds->getQ(1), 0.,
+                           pds->getRadius(), true);
   };
 
   void visit(SP::Circle pds)
   {
-    int i, j, imin, imax, jmin, jmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for(i = imin; i <= imax; ++i)
-    {
-      for(j = jmin; j <= jmax; ++j)
-      {
-        parent.insert(pds, i, j, 0);
-      }
-    }
+    parent._grid->add_body(pds, pds->getQ(0), pds->getQ(1), 0.,
+                           pds->getRadius(), true);
   }
 
   void visit(SP::SphereLDS pds)
   {
-    int i, j, k, imin, imax, jmin, jmax, kmin, kmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    kmin = (int) floor((pds->getQ(2) - _bboxfactor * pds->getRadius()) / _cellsize);
-    kmax = (int) floor((pds->getQ(2) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for(i = imin; i <= imax; ++i)
-    {
-      for(j = jmin; j <= jmax; ++j)
-      {
-        for(k = kmin; k <= kmax; ++k)
-        {
-          parent.insert(pds, i, j, k);
-        }
-      }
-    }
-
+    parent._grid->add_body(pds, pds->getQ(0), pds->getQ(1), pds->getQ(2),
+                           pds->getRadius(), false);
   }
 
   void visit(SP::SphereNEDS pds)
   {
-    int i, j, k, imin, imax, jmin, jmax, kmin, kmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    kmin = (int) floor((pds->getQ(2) - _bboxfactor * pds->getRadius()) / _cellsize);
-    kmax = (int) floor((pds->getQ(2) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for(i = imin; i <= imax; ++i)
-    {
-      for(j = jmin; j <= jmax; ++j)
-      {
-        for(k = kmin; k <= kmax; ++k)
-        {
-          parent.insert(pds, i, j, k);
-        }
-      }
-    }
-
+    parent._grid->add_body(pds, pds->getQ(0), pds->getQ(1), pds->getQ(2),
+                           pds->getRadius(), false);
   }
 
   void visit(SP::ExternalBody d)
@@ -957,30 +1095,22 @@ void SpaceFilter::_PlanSphereNEDSFilter(SP::Simulation sim,
 /* insertion */
 void SpaceFilter::insert(SP::Disk ds, int i, int j, int k)
 {
-
-  SP::Hashed hashed(new Hashed(std::static_pointer_cast<DynamicalSystem>(ds), i, j));
-  _hash_table->insert(hashed);
+  _grid->insert(ds, i, j, 0);
 }
 
 void SpaceFilter::insert(SP::Circle ds, int i, int j, int k)
 {
-
-  SP::Hashed hashed(new Hashed(std::static_pointer_cast<DynamicalSystem>(ds), i, j));
-  _hash_table->insert(hashed);
+  _grid->insert(ds, i, j, 0);
 }
 
 void SpaceFilter::insert(SP::SphereLDS ds, int i, int j, int k)
 {
-
-  SP::Hashed hashed(new Hashed(ds, i, j, k));
-  _hash_table->insert(hashed);
+  _grid->insert(ds, i, j, k);
 }
 
 void SpaceFilter::insert(SP::SphereNEDS ds, int i, int j, int k)
 {
-
-  SP::Hashed hashed(new Hashed(ds, i, j, k));
-  _hash_table->insert(hashed);
+  _grid->insert(ds, i, j, k);
 }
 
 void SpaceFilter::insert(SP::Hashed hashed)
@@ -1024,15 +1154,28 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
 
   using SiconosVisitor::visit;
 
-  typedef boost::unordered_multiset < interPair,
-          boost::hash<interPair> > interPairs;
-
   SP::Simulation sim;
   SP::SpaceFilter parent;
   double time;
   _FindInteractions(SP::Simulation s, SP::SpaceFilter p, double time)
     : sim(s), parent(p), time(time) {};
 
+  /* the candidates have been computed by space_grid::build */
+  template<typename Filter>
+  void filterCandidates(const DynamicalSystem& ds1, std::shared_ptr<Filter> filter)
+  {
+    unsigned int b;
+    if(!parent->_grid->find(&ds1, b))
+      return;
+
+    const std::vector<space_grid::body_entry>& bodies = parent->_grid->bodies();
+    const unsigned int *c, *cend;
+    for(std::tie(c, cend) = parent->_grid->candidates(b); c != cend; ++c)
+    {
+      bodies[*c].ds->acceptSP(filter);
+    }
+  }
+
   void visit_circular(SP::CircularDS  ds1)
   {
     assert(parent->_plans->size(0) > 0);
@@ -1062,46 +1205,11 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
       }
     }
 
-    SP::SiconosVector Q1 = ds1->q();
-
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    SP::Hashed hds1(new Hashed(std::static_pointer_cast<DynamicalSystem>(ds1),
-                               (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize)));
-
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
-
-    unsigned int j;
-    interPairs declaredInteractions;
+    // check proximity with all other systems that are in the same
+    // cell
     std::shared_ptr<_CircularFilter>
     circularFilter(new _CircularFilter(sim, parent, ds1));
-
-    for(j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
-    {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if(ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if(declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(circularFilter);
-        }
-
-      }
-    }
+    filterCandidates(*ds1, circularFilter);
   };
 
   void visit(SP::Circle circle)
@@ -1127,48 +1235,11 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
                                    (*parent->_plans)(i, 3), ds1);
     }
 
-    SP::SiconosVector Q1 = ds1->q();
-
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    double z1 = Q1->getValue(2);
-    SP::Hashed hds1(new Hashed(ds1, (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize),
-                               (int) floor(z1 / parent->_cellsize)));
-
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
-
-    unsigned int j;
-    interPairs declaredInteractions;
-
+    // check proximity with all other systems that are in the same
+    // cell
     std::shared_ptr<_SphereLDSFilter> sphereFilter(
       new _SphereLDSFilter(sim, parent, ds1));
-
-    for(j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
-    {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if(ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if(declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(sphereFilter);
-        }
-
-      }
-    }
+    filterCandidates(*ds1, sphereFilter);
   }
 
 
@@ -1184,48 +1255,11 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
                                     (*parent->_plans)(i, 3), ds1);
     }
 
-    SP::SiconosVector Q1 = ds1->q();
-
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    double z1 = Q1->getValue(2);
-    SP::Hashed hds1(new Hashed(ds1, (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize),
-                               (int) floor(z1 / parent->_cellsize)));
-
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
-
-    unsigned int j;
-    interPairs declaredInteractions;
-
+    // check proximity with all other systems that are in the same
+    // cell
     std::shared_ptr<_SphereNEDSFilter> sphereFilter(
       new _SphereNEDSFilter(sim, parent, ds1));
-
-    for(j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
-    {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if(ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if(declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(sphereFilter);
-        }
-
-      }
-    }
+    filterCandidates(*ds1, sphereFilter);
   }
 
   void visit(SP::ExternalBody d)
@@ -1251,6 +1285,7 @@ void SpaceFilter::updateInteractions(SP::Simulation sim)
   findInteractions(new _FindInteractions(sim, shared_from_this(), time));
 
   _hash_table->clear();
+  _grid->clear();
 
   // 1: rehash DS
   DynamicalSystemsGraph::VIterator vi, viend;
@@ -1260,6 +1295,7 @@ void SpaceFilter::updateInteractions(SP::Simulation sim)
     // to avoid cast see dual dispatch, visitor pattern
     DSG0->bundle(*vi)->acceptSP(hasher);
   }
+  _grid->build(_bboxfactor, _cellsize);
 
   // 2: prox detection
   for(std::tie(vi, viend) = DSG0->vertices();
@@ -1279,7 +1315,8 @@ bool SpaceFilter::haveNeighbours(SP::Hashed h)
 {
   std::pair<space_hash::iterator, space_hash::iterator> neighbours
     = _hash_table->equal_range(h);
-  return (neighbours.first != neighbours.second);
+  auto cell = _grid->equal_range(h->i, h->j, h->k);
+  return (neighbours.first != neighbours.second || cell.first != cell.second);
 }
 
 
@@ -1330,6 +1367,14 @@ double SpaceFilter::minDistance(SP::Hashed h)
 
       dmin = (std::min)(dmin, distance->result);
     }
+
+    auto cell = _grid->equal_range(h->i, h->j, h->k);
+    for(; cell.first != cell.second; ++cell.first)
+    {
+      _grid->bodies()[cell.first->body].ds->acceptSP(distance);
+
+      dmin = (std::min)(dmin, distance->result);
+    }
   }
 
   return dmin;
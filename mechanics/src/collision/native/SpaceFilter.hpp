@@ -43,6 +43,7 @@
 
 /* local forwards (see SpaceFilter_impl.hpp) */
 DEFINE_SPTR(space_hash);
+DEFINE_SPTR(space_grid);
 DEFINE_SPTR(DiskDiskRDeclaredPool);
 DEFINE_SPTR(DiskPlanRDeclaredPool);
 DEFINE_SPTR(CircleCircleRDeclaredPool);
@@ -68,9 +69,12 @@ protected:
   /** moving plans */
   SP::FMatrix _moving_plans;
 
-  /* the hash table */
+  /* the hash table, for the objects inserted as Hashed */
   SP::space_hash _hash_table;
 
+  /* the uniform grid, for disks, circles and spheres */
+  SP::space_grid _grid;
+
   /* relations pool */
   SP::DiskDiskRDeclaredPool diskdisk_relations;
   SP::DiskPlanRDeclaredPool diskplan_relations;
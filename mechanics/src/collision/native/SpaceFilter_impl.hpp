@@ -23,13 +23,16 @@
 #ifndef SpaceFilter_impl_hpp
 #define SpaceFilter_impl_hpp
 
-#include <map>
+#include <array>
+#include <vector>
+#include <cstdint>
 
 #include <NSLawMatrix.hpp>
 #include <SpaceFilter.hpp>
 #include "DiskMovingPlanR.hpp"
 #include <boost/numeric/ublas/symmetric.hpp>
 #include <boost/unordered_set.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/functional/hash.hpp>
 
@@ -68,25 +71,134 @@ class space_hash : public boost::unordered_multiset < SP::Hashed,
   ACCEPT_SERIALIZATION(space_hash);
 };
 
+/** uniform grid for the disks, circles and spheres
+ *
+ *  One entry per couple (body, cell) in a flat array sorted by the
+ *  Morton code of the cell: the bodies of a cell are contiguous and
+ *  neighbouring cells are close in memory. The entries of the bodies
+ *  added with add_body() are computed by build() from their bounding
+ *  box, and the lists of candidates for the proximity detection (the
+ *  other bodies of the cell of the center) are computed at the same
+ *  time. With OpenMP, these loops are done in parallel.
+ */
+class space_grid
+{
+public:
+
+  /** a body in a cell */
+  struct cell_entry
+  {
+    uint64_t code;
+    int i;
+    int j;
+    int k;
+    unsigned int body;
+  };
+
+  /** a body, with its center and radius */
+  struct body_entry
+  {
+    SP::DynamicalSystem ds;
+    double x;
+    double y;
+    double z;
+    double radius;
+    /** 2D body (k = 0) */
+    bool planar;
+    /** false if only inserted in some given cells: no center, and
+     *  then no candidates */
+    bool bounded;
+  };
+
+  /** Morton code of a cell, 21 bits by coordinate
+   *  \param i cell coordinate
+   *  \param j cell coordinate
+   *  \param k cell coordinate
+   *  \return the interleaved bits of the coordinates
+   */
+  static uint64_t morton(int i, int j, int k);
+
+  /** remove all the bodies and cells */
+  void clear();
+
+  /** add (or update) a body, its cells being computed by build()
+   *  \return the index of the body
+   */
+  unsigned int add_body(SP::DynamicalSystem ds, double x, double y,
+                        double z, double radius, bool planar);
+
+  /** insert a body in a given cell
+   */
+  void insert(SP::DynamicalSystem ds, int i, int j, int k);
+
+  /** compute the cells of the bodies, sort the cells and compute the
+   *  lists of candidates
+   *  \param bboxfactor bounding box factor
+   *  \param cellsize the cell size
+   */
+  void build(unsigned int bboxfactor, unsigned int cellsize);
+
+  /** \return the range of the entries of the cell (i,j,k) */
+  std::pair<std::vector<cell_entry>::const_iterator,
+            std::vector<cell_entry>::const_iterator>
+  equal_range(int i, int j, int k) const;
+
+  /** \param ds a body
+   *  \param[out] index the index of the body, if found
+   *  \return true if the body is in the grid
+   */
+  bool find(const DynamicalSystem* ds, unsigned int& index) const;
+
+  /** \return the bodies */
+  const std::vector<body_entry>& bodies() const { return _bodies; };
+
+  /** \param b index of a body
+   *  \return the candidates for proximity detection with the body b,
+   *  as a range of indices of bodies
+   */
+  std::pair<const unsigned int*, const unsigned int*> candidates(unsigned int b) const
+  {
+    const unsigned int* first = _candidates.data();
+    return std::make_pair(first + _candidates_start[b],
+                          first + _candidates_start[b + 1]);
+  };
+
+private:
+
+  std::vector<body_entry> _bodies;
+  std::vector<cell_entry> _cells;
+  boost::unordered_map<const DynamicalSystem*, unsigned int> _index;
+  std::vector<size_t> _candidates_start;
+  std::vector<unsigned int> _candidates;
+
+  unsigned int _body_index(SP::DynamicalSystem ds);
+};
+
 /* relations pool */
 typedef std::pair<double, double> CircleCircleRDeclared;
 typedef std::pair<double, double> DiskDiskRDeclared;
 typedef std::array<double, 6> DiskPlanRDeclared;
 
 
-class CircleCircleRDeclaredPool : public std::map<CircleCircleRDeclared, SP::CircularR>
+class CircleCircleRDeclaredPool :
+  public boost::unordered_map<CircleCircleRDeclared, SP::CircularR,
+                              boost::hash<CircleCircleRDeclared> >
 {
   ACCEPT_SERIALIZATION(CircleCircleRDeclaredPool);
 };
 
 
-class DiskDiskRDeclaredPool : public std::map<DiskDiskRDeclared, SP::CircularR>
+class DiskDiskRDeclaredPool :
+  public boost::unordered_map<DiskDiskRDeclared, SP::CircularR,
+                              boost::hash<DiskDiskRDeclared> >
 {
   ACCEPT_SERIALIZATION(DiskDiskRDeclaredPool);
 };
 
 
-class DiskPlanRDeclaredPool : public std::map<DiskPlanRDeclared, SP::DiskPlanR>
+class DiskPlanRDeclaredPool :
+  public boost::unordered_map<DiskPlanRDeclared, SP::DiskPlanR,
+                              boost::hash<DiskPlanRDeclared> >
 {
   ACCEPT_SERIALIZATION(DiskPlanRDeclaredPool);
 };
@@ -67,6 +67,7 @@
 #include "Circle.hpp"
 #include "DiskPlanR.hpp"
 #include "SpaceFilter.hpp"
+#include "SpaceFilter_impl.hpp"
 
 class Disks : public SiconosBodies, public std::enable_shared_from_this<Disks>
 {
@@ -373,8 +374,96 @@ void MultiBodyTest::t2()
 
 }
 
+// the interactions found with the uniform grid against a brute force
+// search
 void MultiBodyTest::t3()
 {
+  const unsigned int n = 200;
+  const unsigned int bboxfactor = 3;
+  const unsigned int cellsize = 6;
+
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0, 10));
+
+  std::vector<double> x(n), y(n);
+  unsigned long seed = 12345;
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    // some cells coordinates are negative
+    seed = (seed * 1103515245 + 12345) % 2147483648UL;
+    x[i] = -40. + 80. * seed / 2147483648.;
+    seed = (seed * 1103515245 + 12345) % 2147483648UL;
+    y[i] = -40. + 80. * seed / 2147483648.;
+
+    SP::SiconosVector q(new SiconosVector(NDOF));
+    SP::SiconosVector v(new SiconosVector(NDOF));
+    q->zero();
+    v->zero();
+    (*q)(0) = x[i];
+    (*q)(1) = y[i];
+    nsds->insertDynamicalSystem(SP::Disk(new Disk(1., 1., q, v)));
+  }
+
+  // a ground far away
+  SP::SiconosMatrix plans(new SimpleMatrix(1, 6));
+  plans->zero();
+  (*plans)(0, 1) = 1;
+  (*plans)(0, 2) = 1000;
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(0, 0.01));
+  SP::TimeStepping sim(new TimeStepping(nsds, td));
+  sim->insertIntegrator(SP::OneStepIntegrator(new MoreauJeanOSI(0.5)));
+  sim->insertNonSmoothProblem(SP::FrictionContact(new FrictionContact(2)));
+
+  SP::SpaceFilter playground(new SpaceFilter(bboxfactor, cellsize, plans));
+  playground->insertNonSmoothLaw(SP::NonSmoothLaw(new NewtonImpactFrictionNSL(0, 0, 0.3, 2)), 0, 0);
+  playground->updateInteractions(sim);
+
+  // a pair is checked if the center of one disk is in a cell of the
+  // bounding box of the other one
+  auto in_bbox = [&](unsigned int a, unsigned int b)
+  {
+    int i = (int) floor(x[b] / cellsize);
+    int j = (int) floor(y[b] / cellsize);
+    double d = bboxfactor * 1.;
+    return floor((x[a] - d) / cellsize) <= i && i <= floor((x[a] + d) / cellsize)
+      && floor((y[a] - d) / cellsize) <= j && j <= floor((y[a] + d) / cellsize);
+  };
+
+  unsigned int expected = 0;
+  for(unsigned int a = 0; a < n; ++a)
+    for(unsigned int b = a + 1; b < n; ++b)
+    {
+      if(hypot(x[a] - x[b], y[a] - y[b]) < 4. && (in_bbox(a, b) || in_bbox(b, a)))
+        ++expected;
+    }
+
+  unsigned int found = 0;
+  SP::InteractionsGraph indexSet0 = nsds->topology()->indexSet0();
+  InteractionsGraph::VIterator ui, uiend;
+  for(std::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+  {
+    if(indexSet0->bundle(*ui)->has2Bodies())
+      ++found;
+  }
+
+  CPPUNIT_ASSERT(expected > 0);
+  CPPUNIT_ASSERT_EQUAL(expected, found);
+
+  // a body only inserted in a given cell has no center: it is a
+  // candidate of the other bodies of the cell but has no candidates
+  space_grid grid;
+  SP::SiconosVector q(new SiconosVector(NDOF));
+  SP::SiconosVector v(new SiconosVector(NDOF));
+  SP::Disk bounded(new Disk(1., 1., q, v));
+  SP::Disk inserted(new Disk(1., 1., q, v));
+  grid.insert(inserted, 5, 5, 0);
+  unsigned int b = grid.add_body(bounded, 5.5 * cellsize, 5.5 * cellsize, 0., 1., true);
+  grid.build(bboxfactor, cellsize);
+  unsigned int bi;
+  CPPUNIT_ASSERT(grid.find(inserted.get(), bi));
+  CPPUNIT_ASSERT(grid.candidates(bi).first == grid.candidates(bi).second);
+  CPPUNIT_ASSERT_EQUAL(1L, (long)(grid.candidates(b).second - grid.candidates(b).first));
+  CPPUNIT_ASSERT_EQUAL(bi, *grid.candidates(b).first);
 }
 
 void MultiBodyTest::t4()
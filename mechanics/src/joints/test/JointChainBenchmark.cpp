@@ -0,0 +1,125 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Benchmark of the evaluation of the jacobians of a chain of bodies
+   linked alternately by knee and pivot joints, as done at each Newton
+   iteration by NonSmoothDynamicalSystem::computeInteractionJacobians.
+   The jacobians in the twist coordinates are checked against the
+   product of the jacobians in q by T: the program fails on mismatch.
+
+   Usage: JointChainBenchmark [scale] where scale multiplies the number
+   of joints (default 1 for 1000 joints, kept small to run as a test,
+   10 for 10k joints). */
+
+#include "SiconosKernel.hpp"
+#include "KneeJointR.hpp"
+#include "PivotJointR.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char* argv[])
+{
+  unsigned int scale = argc > 1 ? std::atoi(argv[1]) : 1;
+  if(scale == 0) scale = 1;
+  unsigned int njoints = 1000 * scale;
+  unsigned int repetitions = 10;
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> d(-1., 1.);
+
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  SP::SimpleMatrix inertia(new SimpleMatrix(3, 3));
+  inertia->eye();
+
+  std::vector<SP::NewtonEulerDS> bodies;
+  for(unsigned int i = 0; i <= njoints; ++i)
+  {
+    // a random orientation so that T is not trivial
+    SP::SiconosVector q(new SiconosVector(7));
+    q->setValue(0, i);
+    double n = 0.;
+    for(unsigned int k = 3; k < 7; ++k)
+    {
+      q->setValue(k, d(generator));
+      n += q->getValue(k) * q->getValue(k);
+    }
+    for(unsigned int k = 3; k < 7; ++k)
+      q->setValue(k, q->getValue(k) / std::sqrt(n));
+    SP::SiconosVector v(new SiconosVector(6));
+    SP::NewtonEulerDS body(new NewtonEulerDS(q, v, 1., inertia));
+    nsds->insertDynamicalSystem(body);
+    bodies.push_back(body);
+  }
+
+  SP::SiconosVector A(new SiconosVector(3));
+  A->setValue(2, 1.);
+  std::vector<SP::NewtonEulerR> relations;
+  for(unsigned int i = 0; i < njoints; ++i)
+  {
+    SP::SiconosVector P(new SiconosVector(3));
+    P->setValue(0, i + 0.5);
+    SP::NewtonEulerJointR joint;
+    if(i % 2)
+      joint.reset(new PivotJointR(P, A, true, bodies[i], bodies[i+1]));
+    else
+      joint.reset(new KneeJointR(P, true, bodies[i], bodies[i+1]));
+    SP::NonSmoothLaw nslaw(new EqualityConditionNSL(joint->numberOfConstraints()));
+    SP::Interaction inter(new Interaction(nslaw, joint));
+    nsds->link(inter, bodies[i], bodies[i+1]);
+    relations.push_back(joint);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned int r = 0; r < repetitions; ++r)
+    nsds->computeInteractionJacobians(0.);
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  std::printf("%u joints: computeInteractionJacobians %10.1f us (%6.3f us per joint)\n",
+              njoints, elapsed.count() / repetitions,
+              elapsed.count() / repetitions / njoints);
+
+  // reference: jachqT = jachq * diag(T(q1), T(q2))
+  double error = 0.;
+  SP::SimpleMatrix T(new SimpleMatrix(7, 6));
+  T->eye();
+  for(unsigned int i = 0; i < njoints; ++i)
+  {
+    const SimpleMatrix& jachq = *relations[i]->jachq();
+    const SimpleMatrix& jachqT = *relations[i]->jachqT();
+    for(unsigned int b = 0; b < 2; ++b)
+    {
+      computeT(bodies[i+b]->q(), T);
+      for(unsigned int r = 0; r < jachq.size(0); ++r)
+        for(unsigned int c = 0; c < 6; ++c)
+        {
+          double ref = 0.;
+          for(unsigned int k = 0; k < 7; ++k)
+            ref += jachq(r, 7 * b + k) * (*T)(k, c);
+          error = std::max(error, std::fabs(jachqT(r, 6 * b + c) - ref));
+        }
+    }
+  }
+  if(error > 1e-12)
+  {
+    std::printf("jachqT: error %g exceeds %g\n", error, 1e-12);
+    return 1;
+  }
+  return 0;
+}
@@ -4,6 +4,8 @@
 struct ContactShapeDistance
 {
 
+  ContactShapeDistance() : parameters(), hasParameters(false) {};
+
   double value;
 
   double x1;
@@ -18,6 +20,15 @@ struct ContactShapeDistance
   double ny;
   double nz;
 
+  /** Parameters of the closest points found by the last extremum
+   *  search, in the order of its unknowns. They are used to start the
+   *  next search.
+   */
+  double parameters[4];
+
+  /** True when parameters hold the result of a previous search. */
+  bool hasParameters;
+
 };
 
 #endif
@@ -25,7 +25,8 @@ void distanceFaceFace(const OccContactFace& csh1,
                       Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                       Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                       Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                      Standard_Real& MinDist)
+                      Standard_Real& MinDist,
+                      Standard_Real* UV, bool warmStart)
 {}
 
 template<typename DistType>
@@ -34,7 +35,8 @@ void distanceFaceEdge(const OccContactFace& csh1,
                       Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                       Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                       Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                      Standard_Real& MinDist)
+                      Standard_Real& MinDist,
+                      Standard_Real* UV, bool warmStart)
 {}
 
 template<typename DistType>
@@ -43,7 +45,8 @@ void distanceEdgeEdge(const OccContactEdge& csh1,
                       Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                       Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                       Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                      Standard_Real& MinDist)
+                      Standard_Real& MinDist,
+                      Standard_Real* UV, bool warmStart)
 {
   throw "Geometer: Edge-Edge distance unimplemented";
 }
@@ -55,10 +58,11 @@ void distanceFaceFace<CadmbtbDistanceType>(const OccContactFace& csh1,
                                    Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                                    Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                                    Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                                   Standard_Real& MinDist)
+                                   Standard_Real& MinDist,
+                                   Standard_Real* UV, bool warmStart)
 {
   cadmbtb_distanceFaceFace(csh1, csh2, X1, Y1, Z1, X2, Y2, Z2, nX, nY, nZ,
-                           MinDist);
+                           MinDist, UV, warmStart);
 }
 
 template<>
@@ -67,10 +71,11 @@ void distanceFaceEdge<CadmbtbDistanceType>(const OccContactFace& csh1,
                                    Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                                    Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                                    Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                                   Standard_Real& MinDist)
+                                   Standard_Real& MinDist,
+                                   Standard_Real* UV, bool warmStart)
 {
   cadmbtb_distanceFaceEdge(csh1, csh2, X1, Y1, Z1, X2, Y2, Z2, nX, nY, nZ,
-                           MinDist);
+                           MinDist, UV, warmStart);
 }
 
 
@@ -80,8 +85,10 @@ void distanceFaceFace<OccDistanceType>(const OccContactFace& csh1,
                                        Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                                        Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                                        Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                                       Standard_Real& MinDist)
+                                       Standard_Real& MinDist,
+                                       Standard_Real* UV, bool warmStart)
 {
+  // BRepExtrema_DistShapeShape cannot be given a starting point
   occ_distanceFaceFace(csh1, csh2, X1, Y1, Z1, X2, Y2, Z2, nX, nY, nZ,
                        MinDist);
 }
@@ -92,7 +99,8 @@ void distanceFaceEdge<OccDistanceType>(const OccContactFace& csh1,
                                Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                                Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                                Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                               Standard_Real& MinDist)
+                               Standard_Real& MinDist,
+                               Standard_Real* UV, bool warmStart)
 {
   occ_distanceFaceEdge(csh1, csh2, X1, Y1, Z1, X2, Y2, Z2, nX, nY, nZ, MinDist);
 }
@@ -114,7 +122,9 @@ struct FaceGeometer : public Geometer
                                dist.x1, dist.y1, dist.z1,
                                dist.x2, dist.y2, dist.z2,
                                dist.nx, dist.ny, dist.nz,
-                               dist.value);
+                               dist.value,
+                               dist.parameters, dist.hasParameters);
+    dist.hasParameters = true;
   }
   void visit(const OccContactEdge& edge2)
   {
@@ -124,7 +134,9 @@ struct FaceGeometer : public Geometer
                                dist.x1, dist.y1, dist.z1,
                                dist.x2, dist.y2, dist.z2,
                                dist.nx, dist.ny, dist.nz,
-                               dist.value);
+                               dist.value,
+                               dist.parameters, dist.hasParameters);
+    dist.hasParameters = true;
     dist.nx = -dist.nx;
     dist.ny = -dist.ny;
     dist.nz = -dist.nz;
@@ -149,7 +161,9 @@ struct EdgeGeometer : public Geometer
                                dist.x1, dist.y1, dist.z1,
                                dist.x2, dist.y2, dist.z2,
                                dist.nx, dist.ny, dist.nz,
-                               dist.value);
+                               dist.value,
+                               dist.parameters, dist.hasParameters);
+    dist.hasParameters = true;
   }
   void visit(const OccContactEdge& edge2)
   {
@@ -159,7 +173,9 @@ struct EdgeGeometer : public Geometer
                                dist.x1, dist.y1, dist.z1,
                                dist.x2, dist.y2, dist.z2,
                                dist.nx, dist.ny, dist.nz,
-                               dist.value);
+                               dist.value,
+                               dist.parameters, dist.hasParameters);
+    dist.hasParameters = true;
   }
 
 };
@@ -129,6 +129,16 @@ const OccContactShape& OccBody::contactShape(unsigned int id) const
   return *boost::get<0>((*this->_contactShapes)[id]);
 }
 
+unsigned int OccBody::numberOfContactShapes() const
+{
+  return this->_contactShapes->size();
+}
+
+unsigned int OccBody::contactShapeGroup(unsigned int id) const
+{
+  return boost::get<2>((*this->_contactShapes)[id]);
+}
+
 const TopoDS_Shape& OccBody::shape(unsigned int id) const
 {
   return *boost::get<0>((*this->_shapes)[id]);
@@ -85,6 +85,15 @@ public:
    */
   const OccContactShape& contactShape(unsigned int id) const;
 
+  /** Get the number of associated contact shapes.
+   */
+  unsigned int numberOfContactShapes() const;
+
+  /** Get the contact group of an associated contact shape.
+   *  \param id the number of the shape.
+   */
+  unsigned int contactShapeGroup(unsigned int id) const;
+
   /** Get an associated shape by its rank of association.
    *  \param id the number of the shape.
    */
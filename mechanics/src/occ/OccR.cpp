@@ -4,9 +4,14 @@
 #include "ContactShapeDistance.hpp"
 #include "WhichGeometer.hpp"
 #include "SiconosException.hpp"
+#include "SiconosVector.hpp"
+#include "BlockVector.hpp"
 #include <limits>
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 #include <boost/typeof/typeof.hpp>
+#include <boost/math/quaternion.hpp>
 
 // #define  DEBUG_MESSAGES
 #include "siconos_debug.h"
@@ -19,7 +24,11 @@ OccR::OccR(const ContactPoint& contact1,
   _contact2(contact2),
   _geometer(),
   _offset1(0.),
-  _offset2(0.)
+  _offset2(0.),
+  _poseTolerance(0.),
+  _hasDistance(false),
+  _distanceEvaluations(0),
+  _distanceReuses(0)
 {
   DEBUG_BEGIN("OccR::OccR(const ContactPoint& contact1, const ContactPoint& contact2,                         const DistanceCalculatorType& distance_calculator)\n");
   switch(Type::value(distance_calculator))
@@ -39,14 +48,123 @@ OccR::OccR(const ContactPoint& contact1,
 }
 
 
+typedef ::boost::math::quaternion<double> Quaternion;
+
+/* rotation of the body number i of q0 */
+static Quaternion bodyRotation(const BlockVector& q0, unsigned int i)
+{
+  unsigned int k = 7*i + 3;
+  return Quaternion(q0.getValue(k), q0.getValue(k+1),
+                    q0.getValue(k+2), q0.getValue(k+3));
+}
+
+/* Pose of the second body in the frame of the first one, or pose of
+ * the body if there is only one. */
+static void relativePose(const BlockVector& q0, double* pose)
+{
+  if(q0.size() < 14)
+  {
+    for(unsigned int i=0; i<7; ++i)
+      pose[i] = q0.getValue(i);
+    return;
+  }
+  Quaternion q1 = bodyRotation(q0, 0);
+  Quaternion t(0., q0.getValue(7) - q0.getValue(0),
+               q0.getValue(8) - q0.getValue(1),
+               q0.getValue(9) - q0.getValue(2));
+  t = conj(q1) * t * q1;
+  Quaternion q = conj(q1) * bodyRotation(q0, 1);
+  pose[0] = t.R_component_2();
+  pose[1] = t.R_component_3();
+  pose[2] = t.R_component_4();
+  pose[3] = q.R_component_1();
+  pose[4] = q.R_component_2();
+  pose[5] = q.R_component_3();
+  pose[6] = q.R_component_4();
+}
+
+/* Express the points and the normal of dist in the frame of the first
+ * body (toBody == true) or in the inertial frame. With one body the
+ * other shape does not move and dist is kept in the inertial frame. */
+static void changeFrame(const BlockVector& q0, bool toBody, ContactShapeDistance& dist)
+{
+  if(q0.size() < 14)
+    return;
+  Quaternion q = bodyRotation(q0, 0);
+  Quaternion r = conj(q);
+  if(!toBody)
+    std::swap(q, r);
+  double x = toBody ? q0.getValue(0) : 0.;
+  double y = toBody ? q0.getValue(1) : 0.;
+  double z = toBody ? q0.getValue(2) : 0.;
+
+  Quaternion p1 = r * Quaternion(0., dist.x1 - x, dist.y1 - y, dist.z1 - z) * q;
+  Quaternion p2 = r * Quaternion(0., dist.x2 - x, dist.y2 - y, dist.z2 - z) * q;
+  Quaternion n = r * Quaternion(0., dist.nx, dist.ny, dist.nz) * q;
+
+  x = toBody ? 0. : q0.getValue(0);
+  y = toBody ? 0. : q0.getValue(1);
+  z = toBody ? 0. : q0.getValue(2);
+  dist.x1 = p1.R_component_2() + x;
+  dist.y1 = p1.R_component_3() + y;
+  dist.z1 = p1.R_component_4() + z;
+  dist.x2 = p2.R_component_2() + x;
+  dist.y2 = p2.R_component_3() + y;
+  dist.z2 = p2.R_component_4() + z;
+  dist.nx = n.R_component_2();
+  dist.ny = n.R_component_3();
+  dist.nz = n.R_component_4();
+}
+
+const ContactShapeDistance& OccR::computeDistance(const BlockVector& q0)
+{
+  DEBUG_BEGIN("OccR::computeDistance(const BlockVector& q0)\n");
+  double pose[7];
+  relativePose(q0, pose);
+
+  bool reuse = _hasDistance;
+  if(reuse)
+  {
+    double dt = 0., dq = 0., dqm = 0.;
+    for(unsigned int i=0; i<3; ++i)
+      dt += (pose[i] - _relativePose[i]) * (pose[i] - _relativePose[i]);
+    for(unsigned int i=3; i<7; ++i)
+    {
+      dq += (pose[i] - _relativePose[i]) * (pose[i] - _relativePose[i]);
+      dqm += (pose[i] + _relativePose[i]) * (pose[i] + _relativePose[i]);
+    }
+    // q and -q are the same rotation
+    reuse = std::sqrt(dt) <= _poseTolerance
+      && std::sqrt(std::min(dq, dqm)) <= _poseTolerance;
+  }
+
+  if(reuse)
+  {
+    ++_distanceReuses;
+    DEBUG_PRINT("OccR::computeDistance: the previous distance is reused\n");
+  }
+  else
+  {
+    // the extremum search starts from the previous closest points
+    this->_contact2.contactShape().accept(*this->_geometer);
+    _relativeDistance = this->_geometer->answer;
+    changeFrame(q0, true, _relativeDistance);
+    std::copy(pose, pose + 7, _relativePose);
+    _hasDistance = true;
+    ++_distanceEvaluations;
+  }
+
+  _distance = _relativeDistance;
+  changeFrame(q0, false, _distance);
+  DEBUG_END("OccR::computeDistance(const BlockVector& q0)\n");
+  return _distance;
+}
+
 void OccR::computeh(double time, const BlockVector& q0, SiconosVector& y)
 {
   DEBUG_BEGIN("OccR::computeh(double time, BlockVector& q0, SiconosVector& y)\n");
-  this->_contact2.contactShape().accept(*this->_geometer);
 
-  
-  
-  ContactShapeDistance& dist = this->_geometer->answer;
+  ContactShapeDistance dist = this->computeDistance(q0);
 
   DEBUG_PRINTF("---->%g P1=(%g, %g, %g) P2=(%g,%g,%g) N=(%g, %g, %g)\n", dist.value,
                dist.x1, dist.y1, dist.z1,
@@ -49,6 +49,53 @@ public:
    */
   void computeh(double time, const BlockVector& q0, SiconosVector& y);
 
+  /** Compute the distance between the two contact shapes for the
+   *  configuration q0 of the bodies. The distance of the previous
+   *  evaluation is reused when the relative pose of the bodies has
+   *  changed by less than the pose tolerance. The contact shapes must
+   *  have been moved to q0.
+   *
+   *  \param q0 : the state vector.
+   *  \return the distance, points and normal in the inertial frame.
+   */
+  const ContactShapeDistance& computeDistance(const BlockVector& q0);
+
+  /** Set the pose tolerance: the distance is not evaluated again
+   *  when both the relative translation and the relative rotation
+   *  quaternion of the bodies have changed by less than this value
+   *  (norm 2). With the default value 0, the distance is reused only
+   *  for the same relative pose.
+   *
+   *  \param tol : the new value.
+   */
+  void setPoseTolerance(double tol) { _poseTolerance = tol; };
+
+  /** Get the pose tolerance.
+   *
+   *  \return a double.
+   */
+  double poseTolerance() const { return _poseTolerance; };
+
+  /** Get the number of distance evaluations.
+   *
+   *  \return an unsigned int.
+   */
+  unsigned int distanceEvaluations() const { return _distanceEvaluations; };
+
+  /** Get the number of reused distances.
+   *
+   *  \return an unsigned int.
+   */
+  unsigned int distanceReuses() const { return _distanceReuses; };
+
+  /** Reset the distance evaluation statistics.
+   */
+  void resetDistanceStatistics()
+  {
+    _distanceEvaluations = 0;
+    _distanceReuses = 0;
+  };
+
   /** Set offset1, offset from first contact.
    *
    *  \param val : the new value.
@@ -71,7 +118,11 @@ public:
    *
    *  \param geometer the new geometer
    */
-  void setGeometer(SP::Geometer geometer) { _geometer = geometer; }
+  void setGeometer(SP::Geometer geometer)
+  {
+    _geometer = geometer;
+    _hasDistance = false;
+  }
 
   ACCEPT_STD_VISITORS();
 
@@ -83,6 +134,23 @@ protected:
 
   double _offset1;
   double _offset2;
+
+  /** Tolerance on the change of the relative pose. */
+  double _poseTolerance;
+
+  /** Relative pose (position, quaternion) of the last evaluation. */
+  double _relativePose[7];
+
+  /** Last evaluated distance, in the frame of the first body. */
+  ContactShapeDistance _relativeDistance;
+
+  /** Distance in the inertial frame, for the current pose. */
+  ContactShapeDistance _distance;
+
+  bool _hasDistance;
+
+  unsigned int _distanceEvaluations;
+  unsigned int _distanceReuses;
 };
 
 #endif
@@ -0,0 +1,440 @@
+#include "OccSpaceFilter.hpp"
+#include "OccBody.hpp"
+#include "OccContactShape.hpp"
+#include "OccContactFace.hpp"
+#include "OccContactEdge.hpp"
+#include "OccR.hpp"
+#include "ContactPoint.hpp"
+#include "SiconosException.hpp"
+
+#include <Simulation.hpp>
+#include <Interaction.hpp>
+#include <NonSmoothLaw.hpp>
+
+#include <TopoDS.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_MapOfShape.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <Bnd_Box.hxx>
+#include <gp_Trsf.hxx>
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+//#define DEBUG_MESSAGES 1
+#include "siconos_debug.h"
+
+/* axis aligned box: xmin, ymin, zmin, xmax, ymax, zmax */
+typedef std::array<double, 6> OccBox;
+
+/* a face or an edge of a contact shape */
+struct OccShapeLeaf
+{
+  SP::OccContactShape shape;
+  SP::ContactPoint point;
+
+  /* box in the frame of the contact shape */
+  OccBox localBox;
+
+  /* box in the inertial frame */
+  OccBox box;
+};
+
+/* node of the hierarchy: the left child follows its parent */
+struct OccShapeNode
+{
+  OccBox box;
+  int right;
+  int leaf;
+};
+
+/* bounding volume hierarchy over the faces and edges of a contact
+ * shape */
+struct OccShapeBVH
+{
+  /* null for a static shape */
+  SP::OccBody body;
+
+  /* the shape moved with the body, shared with the leaves */
+  SP::TopoDS_Shape shape;
+
+  unsigned int group;
+
+  std::vector<OccShapeLeaf> leaves;
+  std::vector<OccShapeNode> nodes;
+};
+
+static bool overlap(const OccBox& a, const OccBox& b, double margin)
+{
+  for(unsigned int i=0; i<3; ++i)
+  {
+    if(a[i] - margin > b[i+3] || b[i] - margin > a[i+3])
+      return false;
+  }
+  return true;
+}
+
+static double extent(const OccBox& a)
+{
+  return a[3] - a[0] + a[4] - a[1] + a[5] - a[2];
+}
+
+static void merge(const OccBox& a, const OccBox& b, OccBox& c)
+{
+  for(unsigned int i=0; i<3; ++i)
+  {
+    c[i] = std::min(a[i], b[i]);
+    c[i+3] = std::max(a[i+3], b[i+3]);
+  }
+}
+
+/* box of the transformed box */
+static void transform(const gp_Trsf& t, const OccBox& a, OccBox& b)
+{
+  double c[3], h[3];
+  for(unsigned int j=0; j<3; ++j)
+  {
+    c[j] = 0.5 * (a[j] + a[j+3]);
+    h[j] = 0.5 * (a[j+3] - a[j]);
+  }
+  for(unsigned int i=0; i<3; ++i)
+  {
+    double wc = t.Value(i+1, 4);
+    double wh = 0.;
+    for(unsigned int j=0; j<3; ++j)
+    {
+      wc += t.Value(i+1, j+1) * c[j];
+      wh += std::abs(t.Value(i+1, j+1)) * h[j];
+    }
+    b[i] = wc - wh;
+    b[i+3] = wc + wh;
+  }
+}
+
+/* add the face or the edge number index of the shape, local is the
+ * shape in its own frame */
+static void addLeaf(OccShapeBVH& bvh, const OccContactShape& shape,
+                    const TopoDS_Shape& local, TopAbs_ShapeEnum type,
+                    unsigned int index)
+{
+  TopExp_Explorer exp;
+  exp.Init(local, type);
+  for(unsigned int i=0; i<index && exp.More(); ++i, exp.Next());
+  if(!exp.More())
+  {
+    THROW_EXCEPTION("OccSpaceFilter: no such face or edge");
+  }
+
+  Bnd_Box box;
+  BRepBndLib::Add(exp.Current(), box, Standard_True);
+  if(box.IsVoid())
+    return;
+
+  OccShapeLeaf leaf;
+  box.Get(leaf.localBox[0], leaf.localBox[1], leaf.localBox[2],
+          leaf.localBox[3], leaf.localBox[4], leaf.localBox[5]);
+  leaf.box = leaf.localBox;
+  if(type == TopAbs_FACE)
+    leaf.shape.reset(new OccContactFace(shape, index));
+  else
+    leaf.shape.reset(new OccContactEdge(shape, index));
+  leaf.point.reset(new ContactPoint(*leaf.shape));
+  bvh.leaves.push_back(leaf);
+}
+
+/* median split of the leaves order[first:last] along the largest
+ * extent of their centers */
+static int buildNode(OccShapeBVH& bvh, std::vector<unsigned int>& order,
+                     unsigned int first, unsigned int last)
+{
+  int n = bvh.nodes.size();
+  OccShapeNode node;
+  node.right = -1;
+  node.leaf = -1;
+  bvh.nodes.push_back(node);
+
+  if(last - first == 1)
+  {
+    bvh.nodes[n].leaf = order[first];
+    return n;
+  }
+
+  double cmin[3], cmax[3];
+  std::fill(cmin, cmin + 3, std::numeric_limits<double>::infinity());
+  std::fill(cmax, cmax + 3, -std::numeric_limits<double>::infinity());
+  for(unsigned int k=first; k<last; ++k)
+  {
+    const OccBox& b = bvh.leaves[order[k]].localBox;
+    for(unsigned int i=0; i<3; ++i)
+    {
+      cmin[i] = std::min(cmin[i], b[i] + b[i+3]);
+      cmax[i] = std::max(cmax[i], b[i] + b[i+3]);
+    }
+  }
+  unsigned int axis = 0;
+  for(unsigned int i=1; i<3; ++i)
+  {
+    if(cmax[i] - cmin[i] > cmax[axis] - cmin[axis])
+      axis = i;
+  }
+
+  unsigned int mid = (first + last) / 2;
+  const std::vector<OccShapeLeaf>& leaves = bvh.leaves;
+  std::nth_element(order.begin() + first, order.begin() + mid,
+                   order.begin() + last,
+                   [&leaves, axis](unsigned int a, unsigned int b)
+                   {
+                     return leaves[a].localBox[axis] + leaves[a].localBox[axis+3]
+                       < leaves[b].localBox[axis] + leaves[b].localBox[axis+3];
+                   });
+
+  buildNode(bvh, order, first, mid);
+  int right = buildNode(bvh, order, mid, last);
+  bvh.nodes[n].right = right;
+  return n;
+}
+
+/* boxes of the leaves from the location of the shape, then boxes of
+ * the nodes, children first */
+static void refit(OccShapeBVH& bvh)
+{
+  const gp_Trsf& t = bvh.shape->Location().Transformation();
+  for(unsigned int k=0; k<bvh.leaves.size(); ++k)
+  {
+    transform(t, bvh.leaves[k].localBox, bvh.leaves[k].box);
+  }
+  for(int n=bvh.nodes.size()-1; n>=0; --n)
+  {
+    OccShapeNode& node = bvh.nodes[n];
+    if(node.leaf >= 0)
+      node.box = bvh.leaves[node.leaf].box;
+    else
+      merge(bvh.nodes[n+1].box, bvh.nodes[node.right].box, node.box);
+  }
+}
+
+/* overlapping leaves of two trees */
+static void overlaps(const OccShapeBVH& a, const OccShapeBVH& b,
+                     unsigned int ta, unsigned int tb, double margin,
+                     std::vector<OccSpaceFilter::LeafPair>& result)
+{
+  std::vector<std::pair<int, int> > stack(1, std::make_pair(0, 0));
+  while(!stack.empty())
+  {
+    int na = stack.back().first;
+    int nb = stack.back().second;
+    stack.pop_back();
+
+    const OccShapeNode& node_a = a.nodes[na];
+    const OccShapeNode& node_b = b.nodes[nb];
+    if(!overlap(node_a.box, node_b.box, margin))
+      continue;
+
+    if(node_a.leaf >= 0 && node_b.leaf >= 0)
+    {
+      result.push_back(
+        std::make_pair(std::make_pair(ta, (unsigned int)node_a.leaf),
+                       std::make_pair(tb, (unsigned int)node_b.leaf)));
+    }
+    // descend into the larger node
+    else if(node_a.leaf >= 0
+            || (node_b.leaf < 0 && extent(node_b.box) > extent(node_a.box)))
+    {
+      stack.push_back(std::make_pair(na, nb+1));
+      stack.push_back(std::make_pair(na, node_b.right));
+    }
+    else
+    {
+      stack.push_back(std::make_pair(na+1, nb));
+      stack.push_back(std::make_pair(node_a.right, nb));
+    }
+  }
+}
+
+OccSpaceFilter::OccSpaceFilter() :
+  SpaceFilter(),
+  _margin(0.),
+  _deflection(0.01),
+  _edgeContacts(false),
+  _distanceCalculator(new CadmbtbDistanceType())
+{}
+
+void OccSpaceFilter::insert(SP::OccBody body)
+{
+  for(unsigned int i=0; i<body->numberOfContactShapes(); ++i)
+  {
+    this->_insert(body, body->contactShape(i), body->contactShapeGroup(i));
+  }
+}
+
+void OccSpaceFilter::insert(SP::OccContactShape shape, unsigned int group)
+{
+  this->_insert(SP::OccBody(), *shape, group);
+}
+
+void OccSpaceFilter::_insert(SP::OccBody body, const OccContactShape& shape,
+                             unsigned int group)
+{
+  DEBUG_BEGIN("OccSpaceFilter::_insert(SP::OccBody body, const OccContactShape& shape, unsigned int group)\n");
+  SP::OccShapeBVH bvh(new OccShapeBVH());
+  bvh->body = body;
+  bvh->shape = shape.shape();
+  bvh->group = group;
+
+  // faces and edges in the frame of the shape
+  TopoDS_Shape local = shape.data().Located(TopLoc_Location());
+  if(_deflection > 0.)
+  {
+    BRepMesh_IncrementalMesh(local, _deflection, Standard_True);
+  }
+
+  const OccContactFace* face = dynamic_cast<const OccContactFace*>(&shape);
+  const OccContactEdge* edge = dynamic_cast<const OccContactEdge*>(&shape);
+  if(face)
+  {
+    addLeaf(*bvh, shape, local, TopAbs_FACE, face->_index);
+  }
+  else if(edge)
+  {
+    addLeaf(*bvh, shape, local, TopAbs_EDGE, edge->_index);
+  }
+  else
+  {
+    TopExp_Explorer exp;
+    unsigned int index = 0;
+    for(exp.Init(local, TopAbs_FACE); exp.More(); exp.Next(), ++index)
+    {
+      addLeaf(*bvh, shape, local, TopAbs_FACE, index);
+    }
+    if(_edgeContacts)
+    {
+      // an edge is explored once per face
+      TopTools_MapOfShape explored;
+      index = 0;
+      for(exp.Init(local, TopAbs_EDGE); exp.More(); exp.Next(), ++index)
+      {
+        if(explored.Add(exp.Current()))
+          addLeaf(*bvh, shape, local, TopAbs_EDGE, index);
+      }
+    }
+  }
+
+  if(!bvh->leaves.empty())
+  {
+    std::vector<unsigned int> order(bvh->leaves.size());
+    for(unsigned int k=0; k<order.size(); ++k)
+      order[k] = k;
+    buildNode(*bvh, order, 0, order.size());
+    refit(*bvh);
+  }
+  DEBUG_PRINTF("%zu faces or edges, %zu nodes\n", bvh->leaves.size(), bvh->nodes.size());
+
+  _trees.push_back(bvh);
+  DEBUG_END("OccSpaceFilter::_insert(SP::OccBody body, const OccContactShape& shape, unsigned int group)\n");
+}
+
+unsigned int OccSpaceFilter::numberOfLeaves() const
+{
+  unsigned int n = 0;
+  for(unsigned int t=0; t<_trees.size(); ++t)
+    n += _trees[t]->leaves.size();
+  return n;
+}
+
+void OccSpaceFilter::computeOverlaps()
+{
+  DEBUG_BEGIN("OccSpaceFilter::computeOverlaps()\n");
+  _overlaps.clear();
+
+  std::vector<unsigned int> order;
+  for(unsigned int t=0; t<_trees.size(); ++t)
+  {
+    if(!_trees[t]->nodes.empty())
+    {
+      refit(*_trees[t]);
+      order.push_back(t);
+    }
+  }
+
+  // sweep of the root boxes along x
+  std::sort(order.begin(), order.end(),
+            [this](unsigned int a, unsigned int b)
+            {
+              return _trees[a]->nodes[0].box[0] < _trees[b]->nodes[0].box[0];
+            });
+
+  for(unsigned int i=0; i<order.size(); ++i)
+  {
+    const OccShapeBVH& a = *_trees[order[i]];
+    for(unsigned int j=i+1; j<order.size(); ++j)
+    {
+      const OccShapeBVH& b = *_trees[order[j]];
+      if(b.nodes[0].box[0] - _margin > a.nodes[0].box[3])
+        break;
+      if(a.body == b.body)
+        continue;
+
+      // the dynamic body first, then in the order of insertion
+      unsigned int ta = order[i], tb = order[j];
+      if(!_trees[ta]->body || (_trees[tb]->body && tb < ta))
+        std::swap(ta, tb);
+      overlaps(*_trees[ta], *_trees[tb], ta, tb, _margin, _overlaps);
+    }
+  }
+
+  std::sort(_overlaps.begin(), _overlaps.end());
+  DEBUG_PRINTF("%zu overlapping pairs\n", _overlaps.size());
+  DEBUG_END("OccSpaceFilter::computeOverlaps()\n");
+}
+
+void OccSpaceFilter::updateInteractions(SP::Simulation simulation)
+{
+  DEBUG_BEGIN("OccSpaceFilter::updateInteractions(SP::Simulation simulation)\n");
+  this->computeOverlaps();
+
+  // unlink the pairs which do not overlap anymore
+  std::map<LeafPair, SP::Interaction>::iterator it = _interactions.begin();
+  while(it != _interactions.end())
+  {
+    if(std::binary_search(_overlaps.begin(), _overlaps.end(), it->first))
+    {
+      ++it;
+    }
+    else
+    {
+      DEBUG_PRINTF("unlink interaction %zu\n", it->second->number());
+      simulation->unlink(it->second);
+      _interactions.erase(it++);
+    }
+  }
+
+  // link the new pairs
+  for(unsigned int k=0; k<_overlaps.size(); ++k)
+  {
+    const LeafPair& pair = _overlaps[k];
+    if(_interactions.find(pair) != _interactions.end())
+      continue;
+
+    const OccShapeBVH& a = *_trees[pair.first.first];
+    const OccShapeBVH& b = *_trees[pair.second.first];
+    SP::NonSmoothLaw nslaw = nonSmoothLaw(a.group, b.group);
+    if(!nslaw)
+      continue;
+
+    SP::OccR relation(new OccR(*a.leaves[pair.first.second].point,
+                               *b.leaves[pair.second.second].point,
+                               *_distanceCalculator));
+    SP::Interaction inter(new Interaction(nslaw, relation));
+    if(b.body)
+      simulation->link(inter, a.body, b.body);
+    else
+      simulation->link(inter, a.body);
+    DEBUG_PRINTF("link interaction %zu\n", inter->number());
+    _interactions[pair] = inter;
+  }
+  DEBUG_END("OccSpaceFilter::updateInteractions(SP::Simulation simulation)\n");
+}
@@ -1,15 +1,173 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/** \file OccSpaceFilter.hpp
+    \brief Broadphase contact detection between OpenCascade contact
+    shapes.
+ */
 #ifndef OccSpaceFilter_hpp
 #define OccSpaceFilter_hpp
 
 #include "SpaceFilter.hpp"
+#include "Geometer.hpp"
 
+#include <map>
+#include <utility>
+#include <vector>
+
+/* local forward (see OccSpaceFilter.cpp) */
+DEFINE_SPTR(OccShapeBVH);
+
+/** Broadphase between the contact shapes of OccBody objects and
+ *  static contact shapes.
+ *
+ *  A bounding box hierarchy over the faces (and optionally the
+ *  edges) of each contact shape is built once, in the frame of the
+ *  shape, from its tessellation. At each step the boxes are refitted
+ *  from the location of the shape, and an OccR interaction is linked
+ *  for each pair of faces or edges of two bodies whose boxes are
+ *  closer than the margin. The interaction is unlinked when the boxes
+ *  are separated again.
+ *
+ *  The contact shapes of the filter are referenced by the OccR
+ *  relations: the filter must outlive the simulation.
+ */
 class OccSpaceFilter : public SpaceFilter
 {
 public:
-  OccSpaceFilter() : SpaceFilter() {};
+  /** (tree, leaf) identifier of a face or an edge. */
+  typedef std::pair<unsigned int, unsigned int> LeafId;
+
+  /** A pair of faces or edges, the one of the dynamic body first. */
+  typedef std::pair<LeafId, LeafId> LeafPair;
+
+  OccSpaceFilter();
+
+  /** Insert all the contact shapes of a body.
+   *
+   *  \param body the body.
+   */
+  void insert(SP::OccBody body);
+
+  /** Insert a static contact shape, the shape must have been moved
+   *  to its position.
+   *
+   *  \param shape the contact shape.
+   *  \param group the contact group.
+   */
+  void insert(SP::OccContactShape shape, unsigned int group = 0);
+
+  /** Set the margin: the faces or edges are in contact when their
+   *  bounding boxes are closer than this distance.
+   *
+   *  \param margin the new value.
+   */
+  void setMargin(double margin) { _margin = margin; };
+
+  /** Get the margin.
+   *
+   *  \return a double.
+   */
+  double margin() const { return _margin; };
+
+  /** Set the linear deflection of the tessellation of the inserted
+   *  shapes, relative to the size of their edges. With 0 the shapes
+   *  are not meshed and the existing tessellation or the geometry is
+   *  used.
+   *
+   *  \param deflection the new value.
+   */
+  void setDeflection(double deflection) { _deflection = deflection; };
+
+  /** Get the deflection of the tessellation.
+   *
+   *  \return a double.
+   */
+  double deflection() const { return _deflection; };
+
+  /** Set whether the edges of the inserted shapes are contact shapes
+   *  too. The contact shapes which are an OccContactEdge are always
+   *  taken into account.
+   *
+   *  \param value the new value.
+   */
+  void setEdgeContacts(bool value) { _edgeContacts = value; };
+
+  /** Get whether the edges are contact shapes.
+   *
+   *  \return a bool.
+   */
+  bool edgeContacts() const { return _edgeContacts; };
+
+  /** Set the distance calculator of the new OccR relations.
+   *
+   *  \param distance_calculator the distance calculator.
+   */
+  void setDistanceCalculator(SP::DistanceCalculatorType distance_calculator)
+  {
+    _distanceCalculator = distance_calculator;
+  };
+
+  /** Refit the bounding boxes from the current locations of the
+   *  shapes and compute the overlapping pairs of faces or edges.
+   */
+  void computeOverlaps();
+
+  /** Get the number of overlapping pairs of the last computation.
+   *
+   *  \return an unsigned int.
+   */
+  unsigned int numberOfOverlaps() const { return _overlaps.size(); };
+
+  /** Get the number of faces and edges of the inserted shapes.
+   *
+   *  \return an unsigned int.
+   */
+  unsigned int numberOfLeaves() const;
+
+  /** Broadphase contact detection: link an OccR interaction for each
+   *  new overlapping pair and unlink the interactions of the pairs
+   *  which do not overlap anymore.
+   *
+   *  \param simulation the current simulation setup
+   */
+  void updateInteractions(SP::Simulation simulation) override;
+
+protected:
+
+  double _margin;
+
+  double _deflection;
+
+  bool _edgeContacts;
+
+  SP::DistanceCalculatorType _distanceCalculator;
+
+  /** one tree per contact shape */
+  std::vector<SP::OccShapeBVH> _trees;
+
+  /** overlapping pairs, sorted */
+  std::vector<LeafPair> _overlaps;
 
-  virtual void updateInteractions(SP::Simulation) {};
+  /** interactions of the overlapping pairs */
+  std::map<LeafPair, SP::Interaction> _interactions;
 
+  void _insert(SP::OccBody body, const OccContactShape& shape,
+               unsigned int group);
 };
 
 #endif
@@ -11,8 +11,16 @@ class OccBody;
 
 #include "OccTimeStepping.hpp"
 #include "OccBody.hpp"
+#include "OccR.hpp"
 
 #include <NonSmoothDynamicalSystem.hpp>
+#include <Topology.hpp>
+#include <Interaction.hpp>
+#include <BlockVector.hpp>
+
+#include <exception>
+#include <iostream>
+#include <vector>
 
 #include <SiconosVisitor.hpp>
 
@@ -51,4 +59,89 @@ void OccTimeStepping::updateWorldFromDS()
     dsg.bundle(*dsi)->accept(up);
   }
 
+  this->computeDistances();
+}
+
+void OccTimeStepping::computeDistances()
+{
+  InteractionsGraph& indexSet0 = *_nsds->topology()->indexSet0();
+  InteractionsGraph::VIterator ui, uiend;
+
+  std::vector<OccR*> relations;
+  std::vector<BlockVector*> positions;
+  for(std::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
+  {
+    Interaction& inter = *indexSet0.bundle(*ui);
+    OccR* relation = dynamic_cast<OccR*>(inter.relation().get());
+    VectorOfBlockVectors& DSlink = inter.linkToDSVariables();
+    // the interactions not initialized yet are left to computeh
+    if(relation && DSlink.size() > NewtonEulerR::q0 && DSlink[NewtonEulerR::q0])
+    {
+      relations.push_back(relation);
+      positions.push_back(DSlink[NewtonEulerR::q0].get());
+    }
+  }
+
+  // exceptions must not escape the parallel region
+  std::exception_ptr error;
+  int n = (int)relations.size();
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic, 1)
+#endif
+  for(int i = 0; i < n; ++i)
+  {
+    try
+    {
+      relations[i]->computeDistance(*positions[i]);
+    }
+    catch(...)
+    {
+#ifdef _OPENMP
+      #pragma omp critical
+#endif
+      error = std::current_exception();
+    }
+  }
+  if(error)
+    std::rethrow_exception(error);
+}
+
+unsigned int OccTimeStepping::distanceEvaluations() const
+{
+  InteractionsGraph& indexSet0 = *_nsds->topology()->indexSet0();
+  InteractionsGraph::VIterator ui, uiend;
+  unsigned int count = 0;
+  for(std::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
+  {
+    OccR* relation = dynamic_cast<OccR*>(indexSet0.bundle(*ui)->relation().get());
+    if(relation)
+      count += relation->distanceEvaluations();
+  }
+  return count;
+}
+
+unsigned int OccTimeStepping::distanceReuses() const
+{
+  InteractionsGraph& indexSet0 = *_nsds->topology()->indexSet0();
+  InteractionsGraph::VIterator ui, uiend;
+  unsigned int count = 0;
+  for(std::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
+  {
+    OccR* relation = dynamic_cast<OccR*>(indexSet0.bundle(*ui)->relation().get());
+    if(relation)
+      count += relation->distanceReuses();
+  }
+  return count;
+}
+
+void OccTimeStepping::displayDistanceStatistics() const
+{
+  unsigned int evaluations = this->distanceEvaluations();
+  unsigned int reuses = this->distanceReuses();
+  unsigned int total = evaluations + reuses;
+  std::cout << "OccTimeStepping: " << evaluations << " distance evaluations, "
+            << reuses << " reused distances";
+  if(total)
+    std::cout << " (" << 100. * reuses / total << "% reused)";
+  std::cout << std::endl;
 }
@@ -12,8 +12,33 @@ public:
 
   OccTimeStepping(SP::NonSmoothDynamicalSystem nsds, SP::TimeDiscretisation td) : TimeStepping(nsds,td) {};
 
+  /** Move the contact shapes to the positions of the bodies and
+   *  evaluate the distances of the OccR contacts.
+   */
   virtual void updateWorldFromDS();
 
+  /** Evaluate the distances of all the OccR contacts, in parallel
+   *  when OpenMP is enabled. The contact shapes must have been moved
+   *  to the positions of the bodies.
+   */
+  void computeDistances();
+
+  /** Get the number of distance evaluations of the OccR contacts.
+   *
+   *  \return an unsigned int.
+   */
+  unsigned int distanceEvaluations() const;
+
+  /** Get the number of reused distances of the OccR contacts.
+   *
+   *  \return an unsigned int.
+   */
+  unsigned int distanceReuses() const;
+
+  /** Display the distance evaluation statistics of the OccR contacts.
+   */
+  void displayDistanceStatistics() const;
+
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include <gp_Quaternion.hxx>
 
 #include <iostream>
+#include <algorithm>
 //#define DEBUG_MESSAGES 1
 #include "siconos_debug.h"
 
@@ -145,13 +146,30 @@ void cadmbtb_myf_FaceEdge(double *x, double * fx, double * gx,const TopoDS_Face&
 
 
 
+/* start of the search in the parameter space: the middle of the UV
+ * bounds, or the previous closest points projected on the bounds */
+static void cadmbtb_initialGuess(int n, double * x, const double * binf, const double * bsup,
+                                 const Standard_Real* UV, bool warmStart)
+{
+  for(int i=0; i<n; ++i)
+  {
+    if(UV && warmStart)
+      x[i] = std::min(std::max(UV[i], binf[i]), bsup[i]);
+    else
+      x[i] = (binf[i]+bsup[i])*0.5;
+  }
+}
+
 // adapted from _CADMBTB_getMinDistanceFace*_using_n2qn1  (Olivier Bonnefon)
+// UV, if given, receives the parameters (u1, v1, u2, v2) of the
+// closest points, and the search starts from them if warmStart is true.
 void cadmbtb_distanceFaceFace(const OccContactFace& csh1,
                               const OccContactFace& csh2,
                               Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                               Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                               Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                              Standard_Real& MinDist)
+                              Standard_Real& MinDist,
+                              Standard_Real* UV, bool warmStart)
 {
   // need the 2 sp pointers to keep memory
   SPC::TopoDS_Face pface1 = csh1.contact();
@@ -186,10 +204,7 @@ void cadmbtb_distanceFaceFace(const OccContactFace& csh1,
   dxim[2]=1e-6*(bsup[2]-binf[2]);
   dxim[3]=1e-6*(bsup[3]-binf[3]);
 
-  x[0]=(binf[0]+bsup[0])*0.5;
-  x[1]=(binf[1]+bsup[1])*0.5;
-  x[2]=(binf[2]+bsup[2])*0.5;
-  x[3]=(binf[3]+bsup[3])*0.5;
+  cadmbtb_initialGuess(4, x, binf, bsup, UV, warmStart);
 
   cadmbtb_myf_FaceFace(x,&f,g,face1,face2);
 
@@ -206,20 +221,25 @@ void cadmbtb_distanceFaceFace(const OccContactFace& csh1,
   int n = 4;
 
 //      DEBUG_PRINTF("call n2qn1_: n=%d,x[0]=%e,x[1]=%e,x[2]=%e,x[3]=%e,fx=%e \n g[0]=%e,g[1]=%e,g[2]=%e,g[3]=%e \n dxim[0]=%e,dxim[1]=%e,dxim[2]=%e,dxim[3]=%e,epsabs=%e,imp=%d,io=%d,mode=%d,iter=%d,nsim=%d \n binf[0]=%e,binf[1]=%e,binf[2]=%e,binf[3]=%e \n bsup[0]=%e,bsup[1]=%e,bsup[2]=%e,bsup[3]=%e \n sizeD=%d,sizeI=%d\n",n,x[0],x[1],x[2],x[3],f,g[0],g[1],g[2],g[3],dxim[0],dxim[1],dxim[2],dxim[3],epsabs,imp,io,mode,iter,nsim,binf[0],binf[1],binf[2],binf[3],bsup[0],bsup[1],bsup[2],bsup[3],sizeD,sizeI);
-#ifdef HAS_FORTRAN
-  n2qn1_(&n, x, &f, g, dxim, &df1, &epsabs, &imp, &io,&mode, &iter, &nsim, binf, bsup, iz, rz, &reverse);
-#else
+#ifndef HAS_FORTRAN
   THROW_EXCEPTION("_CADMBTB_getMinDistanceFaceFace_using_n2qn1, Fortran Language is not enabled in siconos mechanisms. Compile with fortran if you need n2qn1");
+#else
+  // n2qn1 keeps its state between the reverse communication calls
+#ifdef _OPENMP
+  #pragma omp critical(cadmbtb_n2qn1)
 #endif
-  while(mode > 7)
   {
-    cadmbtb_myf_FaceFace(x,&f,g,face1,face2);
-#ifdef HAS_FORTRAN
     n2qn1_(&n, x, &f, g, dxim, &df1, &epsabs, &imp, &io,&mode, &iter, &nsim, binf, bsup, iz, rz, &reverse);
-#else
-    THROW_EXCEPTION("_CADMBTB_getMinDistanceFaceFace_using_n2qn1, Fortran Language is not enabled in siconos mechanisms. Compile with fortran if you need n2qn1");
-#endif
+    while(mode > 7)
+    {
+      cadmbtb_myf_FaceFace(x,&f,g,face1,face2);
+      n2qn1_(&n, x, &f, g, dxim, &df1, &epsabs, &imp, &io,&mode, &iter, &nsim, binf, bsup, iz, rz, &reverse);
+    }
   }
+#endif
+
+  if(UV)
+    for(int i=0; i<4; ++i) UV[i] = x[i];
 
   DEBUG_PRINTF("mode=%d and min value at u=%e,v=%e f=%e\n",mode,x[0],x[1],sqrt(f));
   DEBUG_PRINTF("_CADMBTB_getMinDistanceFaceFace_using_n2qn1 dist = %e\n",sqrt(f));
@@ -245,12 +265,15 @@ void cadmbtb_distanceFaceFace(const OccContactFace& csh1,
 
 
 /*idContact useful for the memory management of n2qn1.*/
+// UV, if given, receives the parameters (u1, v1, u2) of the closest
+// points, and the search starts from them if warmStart is true.
 void cadmbtb_distanceFaceEdge(
   const OccContactFace& csh1, const OccContactEdge& csh2,
   Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
   Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
   Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-  Standard_Real& MinDist)
+  Standard_Real& MinDist,
+  Standard_Real* UV, bool warmStart)
 {
 
   // need the 2 sp pointers to keep memory
@@ -284,9 +307,7 @@ void cadmbtb_distanceFaceEdge(
   dxim[1]=1e-6*(bsup[1]-binf[1]);
   dxim[2]=1e-6*(bsup[2]-binf[2]);
 
-  x[0]=(binf[0]+bsup[0])*0.5;
-  x[1]=(binf[1]+bsup[1])*0.5;
-  x[2]=(binf[2]+bsup[2])*0.5;
+  cadmbtb_initialGuess(3, x, binf, bsup, UV, warmStart);
   cadmbtb_myf_FaceEdge(x,&f,g,face1,edge2);
 
   df1=f;
@@ -300,20 +321,25 @@ void cadmbtb_distanceFaceEdge(
 
 //    DEBUG_PRINTF("call n2qn1_: n=%d,x[0]=%e,x[1]=%e,x[2]=%e,fx=%e \n g[0]=%e,g[1]=%e,g[2]=%e \n dxim[0]=%e,dxim[1]=%e,dxim[2]=%e,epsabs=%e,imp=%d,io=%d,mode=%d,iter=%d,nsim=%d \n binf[0]=%e,binf[1]=%e,binf[2]=%e \n bsup[0]=%e,bsup[1]=%e,bsup[2]=%e \n sizeD=%d,sizeI=%d\n",n,x[0],x[1],x[2],f,g[0],g[1],g[2],dxim[0],dxim[1],dxim[2],epsabs,imp,io,mode,iter,nsim,binf[0],binf[1],binf[2],bsup[0],bsup[1],bsup[2],sizeD,sizeI);
 
-#ifdef HAS_FORTRAN
-  n2qn1_(&n, x, &f, g, dxim, &df1, &epsabs, &imp, &io,&mode, &iter, &nsim, binf, bsup, iz, rz, &reverse);
-#else
+#ifndef HAS_FORTRAN
   THROW_EXCEPTION("_CADMBTB_getMinDistanceFaceFace_using_n2qn1, Fortran Language is not enabled in siconos mechanisms. Compile with fortran if you need n2qn1");
+#else
+  // n2qn1 keeps its state between the reverse communication calls
+#ifdef _OPENMP
+  #pragma omp critical(cadmbtb_n2qn1)
 #endif
-  while(mode > 7)
   {
-    cadmbtb_myf_FaceEdge(x,&f,g,face1,edge2);
-#ifdef HAS_FORTRAN
     n2qn1_(&n, x, &f, g, dxim, &df1, &epsabs, &imp, &io,&mode, &iter, &nsim, binf, bsup, iz, rz, &reverse);
-#else
-    THROW_EXCEPTION("_CADMBTB_getMinDistanceFaceFace_using_n2qn1, Fortran Language is not enabled in siconos mechanisms. Compile with fortran if you need n2qn1");
-#endif
+    while(mode > 7)
+    {
+      cadmbtb_myf_FaceEdge(x,&f,g,face1,edge2);
+      n2qn1_(&n, x, &f, g, dxim, &df1, &epsabs, &imp, &io,&mode, &iter, &nsim, binf, bsup, iz, rz, &reverse);
+    }
   }
+#endif
+
+  if(UV)
+    for(int i=0; i<3; ++i) UV[i] = x[i];
 
   MinDist=sqrt(f);
 
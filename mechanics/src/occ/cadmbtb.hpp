@@ -18,13 +18,15 @@ void cadmbtb_distanceFaceFace(const OccContactFace& csh1,
                               Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
                               Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
                               Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                              Standard_Real& MinDist);
+                              Standard_Real& MinDist,
+                              Standard_Real* UV = 0, bool warmStart = false);
 
 void cadmbtb_distanceFaceEdge(
   const OccContactFace& sh1, const OccContactEdge& sh2,
   Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
   Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
   Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-  Standard_Real& MinDist);
+  Standard_Real& MinDist,
+  Standard_Real* UV = 0, bool warmStart = false);
 
 #endif
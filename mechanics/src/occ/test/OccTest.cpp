@@ -8,9 +8,13 @@
 #include "ContactPoint.hpp"
 #include "WhichGeometer.hpp"
 #include "WhichGeometer.hpp"
+#include "OccR.hpp"
+#include "OccSpaceFilter.hpp"
+#include "BlockVector.hpp"
 
 #include <TopoDS_Shape.hxx>
 #include <BRepPrimAPI_MakeSphere.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
 #include <BRepTools.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
@@ -133,6 +137,69 @@ void OccTest::move()
   CPPUNIT_ASSERT(std::abs(rotat.W() - 0.35634832254989918) < 1e-9);
 
 }
+void OccTest::spaceFilter()
+{
+  BRepPrimAPI_MakeBox mkbox1(1., 1., 1.);
+  BRepPrimAPI_MakeBox mkbox2(1., 1., 1.);
+
+  SP::OccContactShape box1(new OccContactShape(mkbox1.Shape()));
+  SP::OccContactShape box2(new OccContactShape(mkbox2.Shape()));
+
+  SP::SiconosVector position1(new SiconosVector(7));
+  SP::SiconosVector position2(new SiconosVector(7));
+  SP::SiconosVector velocity(new SiconosVector(6));
+  SP::SimpleMatrix inertia(new SimpleMatrix(3,3));
+  position1->zero();
+  (*position1)(3) = 1.;
+  position2->zero();
+  (*position2)(0) = 3.;
+  (*position2)(3) = 1.;
+  velocity->zero();
+  inertia->eye();
+
+  SP::OccBody body1(new OccBody(position1, velocity, 1, inertia));
+  SP::OccBody body2(new OccBody(position2, velocity, 1, inertia));
+  body1->addContactShape(box1);
+  body2->addContactShape(box2);
+
+  OccSpaceFilter filter;
+  filter.setMargin(0.1);
+  filter.insert(body1);
+  filter.insert(body2);
+
+  // one leaf per face
+  CPPUNIT_ASSERT(filter.numberOfLeaves() == 12);
+
+  filter.computeOverlaps();
+  CPPUNIT_ASSERT(filter.numberOfOverlaps() == 0);
+
+  // the boxes are 0.05 apart: only the faces within the margin
+  (*body2->q())(0) = 1.05;
+  body2->updateContactShapes();
+  filter.computeOverlaps();
+  unsigned int overlaps = filter.numberOfOverlaps();
+  CPPUNIT_ASSERT(overlaps > 0);
+  CPPUNIT_ASSERT(overlaps < 36);
+
+  filter.setMargin(0.);
+  filter.computeOverlaps();
+  CPPUNIT_ASSERT(filter.numberOfOverlaps() == 0);
+
+  // rotated by pi/4 around z, the corner of the second box is inside
+  // the first one
+  const double pi = boost::math::constants::pi<double>();
+  (*body2->q())(3) = cos(pi/8.);
+  (*body2->q())(6) = sin(pi/8.);
+  body2->updateContactShapes();
+  filter.computeOverlaps();
+  CPPUNIT_ASSERT(filter.numberOfOverlaps() > 0);
+
+  (*body2->q())(0) = 3.;
+  body2->updateContactShapes();
+  filter.computeOverlaps();
+  CPPUNIT_ASSERT(filter.numberOfOverlaps() == 0);
+}
+
 #ifdef HAS_FORTRAN
 void OccTest::distance()
 {
@@ -216,4 +283,87 @@ void OccTest::distance()
   CPPUNIT_ASSERT(std::abs(dist.value - 1.0) < 1e-9);
 
 }
+
+void OccTest::distanceReuse()
+{
+  const double pi = boost::math::constants::pi<double>();
+
+  BRepPrimAPI_MakeSphere mksphere1(1, pi);
+  BRepPrimAPI_MakeSphere mksphere2(1, pi);
+
+  OccContactShape sphere1(mksphere1.Shape());
+  OccContactShape sphere2(mksphere2.Shape());
+
+  OccContactFace sphere1_contact(sphere1, 0);
+  OccContactFace sphere2_contact(sphere2, 0);
+
+  SP::SiconosVector position1(new SiconosVector(7));
+  SP::SiconosVector position2(new SiconosVector(7));
+  SP::SiconosVector velocity(new SiconosVector(6));
+  SP::SimpleMatrix inertia(new SimpleMatrix(3,3));
+  position1->zero();
+  (*position1)(3) = 1;
+
+  position2->zero();
+  (*position2)(0) = 3.;
+  (*position2)(3) = cos(pi/2.);
+  (*position2)(5) = sin(pi/2.);
+
+  velocity->zero();
+  inertia->eye();
+
+  SP::OccBody body1(new OccBody(position1, velocity, 1, inertia));
+  SP::OccBody body2(new OccBody(position2, velocity, 1, inertia));
+
+  body1->addContactShape(createSPtrOccContactShape(sphere1_contact));
+  body2->addContactShape(createSPtrOccContactShape(sphere2_contact));
+
+  ContactPoint contact1(body1->contactShape(0));
+  ContactPoint contact2(body2->contactShape(0));
+
+  OccR relation(contact1, contact2);
+  relation.resetDistanceStatistics();
+
+  BlockVector q0;
+  q0.insertPtr(body1->q());
+  q0.insertPtr(body2->q());
+  SiconosVector y(1);
+
+  relation.computeh(0., q0, y);
+  CPPUNIT_ASSERT(std::abs(y(0) - 1.0) < 1e-9);
+  double x1 = (*relation.pc1())(0);
+
+  // same pose: the distance is reused
+  relation.computeh(0., q0, y);
+  CPPUNIT_ASSERT(relation.distanceEvaluations() == 1);
+  CPPUNIT_ASSERT(relation.distanceReuses() == 1);
+
+  // same relative pose: the contact points follow the bodies
+  (*body1->q())(1) += 1.;
+  (*body2->q())(1) += 1.;
+  body1->updateContactShapes();
+  body2->updateContactShapes();
+  relation.computeh(0., q0, y);
+  CPPUNIT_ASSERT(relation.distanceEvaluations() == 1);
+  CPPUNIT_ASSERT(relation.distanceReuses() == 2);
+  CPPUNIT_ASSERT(std::abs(y(0) - 1.0) < 1e-9);
+  CPPUNIT_ASSERT(std::abs((*relation.pc1())(0) - x1) < 1e-9);
+  CPPUNIT_ASSERT(std::abs((*relation.pc1())(1) - 1.) < 1e-6);
+
+  // the second body moves away: new evaluation, from the previous
+  // closest points
+  (*body2->q())(0) += 1.;
+  body2->updateContactShapes();
+  relation.computeh(0., q0, y);
+  CPPUNIT_ASSERT(relation.distanceEvaluations() == 2);
+  CPPUNIT_ASSERT(std::abs(y(0) - 2.0) < 1e-9);
+
+  // below the pose tolerance, the distance is reused
+  relation.setPoseTolerance(1e-3);
+  (*body2->q())(0) += 1e-4;
+  body2->updateContactShapes();
+  relation.computeh(0., q0, y);
+  CPPUNIT_ASSERT(relation.distanceEvaluations() == 2);
+  CPPUNIT_ASSERT(std::abs(y(0) - 2.0) < 1e-9);
+}
 #endif
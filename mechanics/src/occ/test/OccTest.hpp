@@ -34,8 +34,12 @@ private:
   CPPUNIT_TEST(computeUVBounds);
 
   CPPUNIT_TEST(move);
+
+  CPPUNIT_TEST(spaceFilter);
 #ifdef HAS_FORTRAN
   CPPUNIT_TEST(distance);
+
+  CPPUNIT_TEST(distanceReuse);
 #endif
   CPPUNIT_TEST_SUITE_END();
 
@@ -46,8 +50,12 @@ private:
 
   void move();
 
+  void spaceFilter();
+
 #ifdef HAS_FORTRAN
   void distance();
+
+  void distanceReuse();
 #endif
   
 public:
@@ -65,6 +65,9 @@ if(WITH_TESTING)
   
   new_test(NAME lcp_test_DefaultSolverOptions SOURCES LinearComplementarity_DefaultSolverOptions_test.c)
 
+  # tableau vs LU updates for the pivoting methods, with warm start
+  new_test(SOURCES lcp_pivot_benchmark.c)
+
   new_tests_collection(
     DRIVER lcp_test_collection.c.in FORMULATION lcp COLLECTION TEST_LCP_COLLECTION_1
     EXTRA_SOURCES data_collection_1.c)
@@ -208,6 +211,12 @@ if(WITH_TESTING)
     DRIVER fc_test_collection.c.in FORMULATION fc3d COLLECTION TEST_QUARTIC_COLLECTION_1
     EXTRA_SOURCES data_collection_5.c test_quartic_1.c)
     
+  # NSGS vs multilevel NSGS on stacks and piles
+  new_test(SOURCES fc3d_nsgs_multilevel_benchmark.c)
+
+  # NSGS orderings of the contacts and symmetric sweeps
+  new_test(SOURCES fc3d_nsgs_ordering_benchmark.c)
+
   # --- LMGC driver ---
   new_test(SOURCES fc3d_newFromFortranData.c)
   new_test(SOURCES fc3d_LmgcDriver_test1.c)
@@ -59,6 +59,8 @@ enum FRICTION_SOLVER
   SICONOS_FRICTION_3D_PFP = 522,
   /** ADMM local formulation */
   SICONOS_FRICTION_3D_ADMM = 523,
+  /** Non-smooth Gauss Seidel with a coarse correction on aggregated contacts, local formulation */
+  SICONOS_FRICTION_3D_NSGS_ML = 524,
 
   /* 3D Frictional Contact solvers for one contact (used mainly inside NSGS solvers) */
 
@@ -133,6 +135,7 @@ extern const char* const   SICONOS_FRICTION_2D_ENUM_STR ;
 
 extern const char* const   SICONOS_FRICTION_3D_NSGS_STR ;
 extern const char* const   SICONOS_FRICTION_3D_NSGSV_STR ;
+extern const char* const   SICONOS_FRICTION_3D_NSGS_ML_STR ;
 extern const char* const   SICONOS_FRICTION_3D_PROX_STR;
 extern const char* const   SICONOS_FRICTION_3D_TFP_STR ;
 extern const char* const   SICONOS_FRICTION_3D_PFP_STR ;
@@ -258,14 +261,40 @@ enum SICONOS_FRICTION_3D_NSGS_IPARAM
   SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT =19,
   /** index in iparam to store the  */
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION =14,
+  /** index in iparam to store the ordering of the contacts (see SICONOS_FRICTION_3D_NSGS_ORDERING_ENUM) */
+  SICONOS_FRICTION_3D_NSGS_ORDERING =15,
+  /** index in iparam to store the symmetric (forward/backward) sweep strategy */
+  SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP =16,
 };
 enum SICONOS_FRICTION_3D_NSGS_DPARAM
 {
   /** index in dparam to store the relaxation strategy */
   SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE=8,
+  /** index in dparam to store the mean processor time of a sweep in seconds (out) */
+  SICONOS_FRICTION_3D_NSGS_SWEEP_TIME=10,
+  /** index in dparam to store the first component of the gravity direction
+      used by SICONOS_FRICTION_3D_NSGS_ORDERING_BOTTOM_UP (3 components) */
+  SICONOS_FRICTION_3D_NSGS_GRAVITY=11,
 };
 
 
+enum SICONOS_FRICTION_3D_NSGS_ML_IPARAM
+{
+  /** index in iparam to store the number of NSGS sweeps between two coarse corrections */
+  SICONOS_FRICTION_3D_NSGS_ML_SWEEPS = 9,
+  /** index in iparam to store the maximum number of contacts in an aggregate (0 for no limit) */
+  SICONOS_FRICTION_3D_NSGS_ML_AGGREGATE_SIZE = 10,
+  /** index in iparam to store the number of aggregates (out) */
+  SICONOS_FRICTION_3D_NSGS_ML_AGGREGATES = 11,
+  /** index in iparam to store the total number of NSGS sweeps (out) */
+  SICONOS_FRICTION_3D_NSGS_ML_SWEEPS_DONE = 12,
+};
+enum SICONOS_FRICTION_3D_NSGS_ML_DPARAM
+{
+  /** index in dparam to store the threshold on |W_ij| / sqrt(W_ii W_jj) for two contacts to be aggregated */
+  SICONOS_FRICTION_3D_NSGS_ML_STRENGTH_THRESHOLD = 9,
+};
+
 enum SICONOS_FRICTION_3D_NSGS_LOCALSOLVER_IPARAM
 {
   SICONOS_FRICTION_3D_NSGS_LOCALSOLVER_IPARAM_USE_TRIVIAL_SOLUTION=10
@@ -309,6 +338,26 @@ enum SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_ENUM
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE =1
 };
 
+enum SICONOS_FRICTION_3D_NSGS_ORDERING_ENUM
+{
+  /** contacts are swept in the order of the problem */
+  SICONOS_FRICTION_3D_NSGS_ORDERING_NO =0,
+  /** reverse Cuthill-McKee ordering of the contact graph */
+  SICONOS_FRICTION_3D_NSGS_ORDERING_RCM =1,
+  /** Morton (Z-curve) ordering of the contact points given in options->dWork */
+  SICONOS_FRICTION_3D_NSGS_ORDERING_MORTON =2,
+  /** contact points given in options->dWork sorted along the gravity direction,
+      from the bottom to the top */
+  SICONOS_FRICTION_3D_NSGS_ORDERING_BOTTOM_UP =3
+};
+
+enum SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_ENUM
+{
+  SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_FALSE =0,
+  /** odd iterations sweep forward, even iterations sweep backward */
+  SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_TRUE =1
+};
+
 enum SICONOS_FRICTION_3D_NSN_IPARAM
 {
   /** index in iparam to store the strategy for computing rho */
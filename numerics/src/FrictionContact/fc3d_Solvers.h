@@ -149,6 +149,33 @@ void fc3d_admm_free(FrictionContactProblem *problem, SolverOptions *options);
 void fc3d_nsgs_velocity(FrictionContactProblem *problem, double *reaction,
                         double *velocity, int *info, SolverOptions *options);
 
+/**
+    Multilevel Non-Smooth Gauss Seidel solver for friction-contact 3D problem
+
+    The contacts are aggregated on the strong normal couplings of the
+    Delassus operator. Each iteration performs a few NSGS sweeps (smoother,
+    internalSolvers[0]) followed by a coarse correction: one normal
+    correction per aggregate, bounded so that the reactions stay in their
+    cones, given by an LCP on P^T W_nn P (internalSolvers[1]).
+
+    \param problem the friction-contact 3D problem to solve
+    \param velocity global vector (n), in-out parameter
+    \param reaction global vector (n), in-out parameters
+    \param info return 0 if the solution is found
+    \param options the solver options :
+    [in] iparam[SICONOS_FRICTION_3D_NSGS_ML_SWEEPS] : number of NSGS sweeps
+    between two coarse corrections
+    [in] iparam[SICONOS_FRICTION_3D_NSGS_ML_AGGREGATE_SIZE] : maximum number
+    of contacts in an aggregate
+    [in] dparam[SICONOS_FRICTION_3D_NSGS_ML_STRENGTH_THRESHOLD] : threshold on
+    |W_ij| / sqrt(W_ii W_jj) for two contacts to be aggregated
+    [out] iparam[SICONOS_FRICTION_3D_NSGS_ML_AGGREGATES] : number of aggregates
+    [out] iparam[SICONOS_FRICTION_3D_NSGS_ML_SWEEPS_DONE] : total number of
+    NSGS sweeps
+*/
+void fc3d_nsgs_multilevel(FrictionContactProblem *problem, double *reaction,
+                          double *velocity, int *info, SolverOptions *options);
+
 /**
    Proximal point solver for friction-contact 3D problem
 
@@ -389,6 +416,7 @@ void fc3d_set_internalsolver_tolerance(FrictionContactProblem *problem,
  */
 void fc3d_nsgs_set_default(SolverOptions *options);
 void fc3d_nsgs_velocity_set_default(SolverOptions *options);
+void fc3d_nsgs_multilevel_set_default(SolverOptions *options);
 void fc3d_proximal_set_default(SolverOptions *options);
 void fc3d_tfp_set_default(SolverOptions *options);
 void fc3d_nsn_ac_set_default(SolverOptions *options);
@@ -35,6 +35,7 @@
 
 const char* const   SICONOS_FRICTION_3D_NSGS_STR = "FC3D_NSGS";
 const char* const   SICONOS_FRICTION_3D_NSGSV_STR = "FC3D_NSGSV";
+const char* const   SICONOS_FRICTION_3D_NSGS_ML_STR = "FC3D_NSGS_ML";
 const char* const   SICONOS_FRICTION_3D_TFP_STR = "FC3D_TFP";
 const char* const   SICONOS_FRICTION_3D_PFP_STR = "FC3D_PFP";
 const char* const   SICONOS_FRICTION_3D_NSN_AC_STR = "FC3D_NSN_AC";
@@ -121,6 +122,12 @@ int fc3d_driver(FrictionContactProblem* problem,
     fc3d_nsgs_velocity(problem, reaction, velocity, &info, options);
     break;
   }
+  case SICONOS_FRICTION_3D_NSGS_ML:
+  {
+    numerics_printf(" ========================== Call multilevel NSGS solver for Friction-Contact 3D problem ==========================\n");
+    fc3d_nsgs_multilevel(problem, reaction, velocity, &info, options);
+    break;
+  }
   /* ADMM*/
   case SICONOS_FRICTION_3D_ADMM:
   {
@@ -18,14 +18,18 @@
 #include <assert.h>                                    // for assert
 #include <float.h>                                     // for DBL_EPSILON
 #include <math.h>                                      // for fabs, sqrt
+#include <stdint.h>                                    // for uint64_t
 #include <stdio.h>                                     // for fclose, fopen
 #include <stdlib.h>                                    // for calloc, malloc
 #include <string.h>                                    // for NULL, memcpy
+#include <time.h>                                      // for clock
 #include "FrictionContactProblem.h"                    // for FrictionContac...
 #include "Friction_cst.h"                              // for SICONOS_FRICTI...
 #include "NumericsArrays.h"                            // for uint_shuffle
 #include "NumericsFwd.h"                               // for SolverOptions
+#include "NumericsMatrix.h"                            // for NumericsMatrix
 #include "SolverOptions.h"                             // for SolverOptions
+#include "SparseBlockMatrix.h"                         // for SBM_symmetric_...
 #include "fc3d_2NCP_Glocker.h"                         // for NCPGlocker_update
 #include "fc3d_NCPGlockerFixedPoint.h"                 // for fc3d_FixedP_in...
 #include "fc3d_Path.h"                                 // for fc3d_Path_init...
@@ -562,6 +566,228 @@ void statsIterationCallback(FrictionContactProblem *problem,
 
 
 
+/* Contact orderings for the NSGS sweep. The permutation is applied to
+ * the storage of W (SBM_symmetric_permutation) so that a sweep reads the
+ * blocks sequentially, and not only to the loop. */
+
+typedef struct
+{
+  uint64_t key;
+  double height;
+  unsigned int index;
+} fc3d_nsgs_ordering_key;
+
+static int fc3d_nsgs_compare_morton(const void * a, const void * b)
+{
+  const fc3d_nsgs_ordering_key * ka = (const fc3d_nsgs_ordering_key *)a;
+  const fc3d_nsgs_ordering_key * kb = (const fc3d_nsgs_ordering_key *)b;
+  if(ka->key != kb->key)
+    return (ka->key < kb->key) ? -1 : 1;
+  return (ka->index < kb->index) ? -1 : (ka->index > kb->index);
+}
+
+static int fc3d_nsgs_compare_height(const void * a, const void * b)
+{
+  const fc3d_nsgs_ordering_key * ka = (const fc3d_nsgs_ordering_key *)a;
+  const fc3d_nsgs_ordering_key * kb = (const fc3d_nsgs_ordering_key *)b;
+  if(ka->height != kb->height)
+    return (ka->height < kb->height) ? -1 : 1;
+  return (ka->index < kb->index) ? -1 : (ka->index > kb->index);
+}
+
+/* spread the 21 lower bits of x, two zeros between each bit */
+static uint64_t fc3d_nsgs_morton_spread(uint64_t x)
+{
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffffULL;
+  x = (x | x << 16) & 0x1f0000ff0000ffULL;
+  x = (x | x << 8) & 0x100f00f00f00f00fULL;
+  x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+  x = (x | x << 2) & 0x1249249249249249ULL;
+  return x;
+}
+
+/* Reverse Cuthill-McKee ordering of the graph of the blocks of W */
+static void fc3d_nsgs_ordering_rcm(SparseBlockStructuredMatrix * W, unsigned int nc, unsigned int * perm)
+{
+  unsigned int * degree = (unsigned int *)calloc(nc, sizeof(unsigned int));
+  char * visited = (char *)calloc(nc, sizeof(char));
+  fc3d_nsgs_ordering_key * start = (fc3d_nsgs_ordering_key *)malloc(nc * sizeof(fc3d_nsgs_ordering_key));
+
+  for(unsigned int row = 0; row < nc && row < W->filled1 - 1; ++row)
+    degree[row] = (unsigned int)(W->index1_data[row + 1] - W->index1_data[row]);
+
+  /* components are started from the contacts of smallest degree */
+  for(unsigned int i = 0; i < nc; ++i)
+  {
+    start[i].key = degree[i];
+    start[i].index = i;
+  }
+  qsort(start, nc, sizeof(fc3d_nsgs_ordering_key), fc3d_nsgs_compare_morton);
+
+  unsigned int head = 0, tail = 0;
+  for(unsigned int s = 0; s < nc; ++s)
+  {
+    if(visited[start[s].index])
+      continue;
+    visited[start[s].index] = 1;
+    perm[tail++] = start[s].index;
+    while(head < tail)
+    {
+      unsigned int row = perm[head++];
+      unsigned int first = tail;
+      if(row >= W->filled1 - 1)
+        continue;
+      for(size_t bn = W->index1_data[row]; bn < W->index1_data[row + 1]; ++bn)
+      {
+        unsigned int col = (unsigned int)W->index2_data[bn];
+        if(visited[col])
+          continue;
+        visited[col] = 1;
+        /* insertion by increasing degree */
+        unsigned int pos = tail++;
+        while(pos > first && degree[perm[pos - 1]] > degree[col])
+        {
+          perm[pos] = perm[pos - 1];
+          pos--;
+        }
+        perm[pos] = col;
+      }
+    }
+  }
+  assert(tail == nc);
+
+  for(unsigned int i = 0; i < nc / 2; ++i)
+  {
+    unsigned int tmp = perm[i];
+    perm[i] = perm[nc - 1 - i];
+    perm[nc - 1 - i] = tmp;
+  }
+  free(start);
+  free(visited);
+  free(degree);
+}
+
+/* Morton (Z-curve) or bottom-up ordering of the contact points */
+static void fc3d_nsgs_ordering_points(double * points, unsigned int nc, SolverOptions * options,
+                                      unsigned int * perm)
+{
+  fc3d_nsgs_ordering_key * keys = (fc3d_nsgs_ordering_key *)malloc(nc * sizeof(fc3d_nsgs_ordering_key));
+  if(options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] == SICONOS_FRICTION_3D_NSGS_ORDERING_MORTON)
+  {
+    double pmin[3] = {points[0], points[1], points[2]};
+    double pmax[3] = {points[0], points[1], points[2]};
+    for(unsigned int i = 1; i < nc; ++i)
+      for(int k = 0; k < 3; ++k)
+      {
+        pmin[k] = fmin(pmin[k], points[3 * i + k]);
+        pmax[k] = fmax(pmax[k], points[3 * i + k]);
+      }
+    for(unsigned int i = 0; i < nc; ++i)
+    {
+      keys[i].key = 0;
+      keys[i].index = i;
+      for(int k = 0; k < 3; ++k)
+      {
+        double extent = pmax[k] - pmin[k];
+        uint64_t cell = extent > 0. ? (uint64_t)((points[3 * i + k] - pmin[k]) / extent * 2097151.) : 0;
+        keys[i].key |= fc3d_nsgs_morton_spread(cell) << k;
+      }
+    }
+    qsort(keys, nc, sizeof(fc3d_nsgs_ordering_key), fc3d_nsgs_compare_morton);
+  }
+  else
+  {
+    double * g = &options->dparam[SICONOS_FRICTION_3D_NSGS_GRAVITY];
+    for(unsigned int i = 0; i < nc; ++i)
+    {
+      keys[i].height = -(g[0] * points[3 * i] + g[1] * points[3 * i + 1] + g[2] * points[3 * i + 2]);
+      keys[i].index = i;
+    }
+    qsort(keys, nc, sizeof(fc3d_nsgs_ordering_key), fc3d_nsgs_compare_height);
+  }
+  for(unsigned int i = 0; i < nc; ++i)
+    perm[i] = keys[i].index;
+  free(keys);
+}
+
+/* the contact swept at position k is perm[k]. Returns NULL if the
+ * ordering cannot be applied */
+static unsigned int * fc3d_nsgs_ordering(FrictionContactProblem * problem, SolverOptions * options)
+{
+  unsigned int nc = problem->numberOfContacts;
+  int ordering = options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING];
+  if(problem->M->storageType != NM_SPARSE_BLOCK || problem->dimension != 3)
+  {
+    numerics_warning("fc3d_nsgs", "the ordering of the contacts needs a sparse block matrix, it is skipped");
+    return NULL;
+  }
+  if(ordering != SICONOS_FRICTION_3D_NSGS_ORDERING_RCM
+      && (!options->dWork || options->dWorkSize < 3 * (size_t)nc))
+  {
+    numerics_warning("fc3d_nsgs", "the geometric ordering of the contacts needs the contact points in options->dWork, it is skipped");
+    return NULL;
+  }
+  unsigned int * perm = (unsigned int *)malloc(nc * sizeof(unsigned int));
+  if(ordering == SICONOS_FRICTION_3D_NSGS_ORDERING_RCM)
+    fc3d_nsgs_ordering_rcm(problem->M->matrix1, nc, perm);
+  else if(ordering == SICONOS_FRICTION_3D_NSGS_ORDERING_MORTON
+          || ordering == SICONOS_FRICTION_3D_NSGS_ORDERING_BOTTOM_UP)
+    fc3d_nsgs_ordering_points(options->dWork, nc, options, perm);
+  else
+  {
+    numerics_error("fc3d_nsgs", "iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] must be equal to "
+                   "SICONOS_FRICTION_3D_NSGS_ORDERING_NO (0), "
+                   "SICONOS_FRICTION_3D_NSGS_ORDERING_RCM (1), "
+                   "SICONOS_FRICTION_3D_NSGS_ORDERING_MORTON (2) or "
+                   "SICONOS_FRICTION_3D_NSGS_ORDERING_BOTTOM_UP (3)");
+    free(perm);
+    return NULL;
+  }
+  return perm;
+}
+
+/* NSGS on the problem permuted by perm */
+static void fc3d_nsgs_permuted(FrictionContactProblem* problem, double *reaction,
+                               double *velocity, int* info, SolverOptions* options,
+                               unsigned int * perm)
+{
+  unsigned int nc = problem->numberOfContacts;
+  int n = 3 * nc;
+  SparseBlockStructuredMatrix * W = SBM_new();
+  SBM_symmetric_permutation(perm, problem->M->matrix1, W);
+
+  double * q = (double *)malloc(n * sizeof(double));
+  double * mu = (double *)malloc(nc * sizeof(double));
+  double * r = (double *)malloc(n * sizeof(double));
+  double * u = (double *)malloc(n * sizeof(double));
+  for(unsigned int k = 0; k < nc; ++k)
+  {
+    unsigned int c = perm[k];
+    mu[k] = problem->mu[c];
+    memcpy(&q[3 * k], &problem->q[3 * c], 3 * sizeof(double));
+    memcpy(&r[3 * k], &reaction[3 * c], 3 * sizeof(double));
+    memcpy(&u[3 * k], &velocity[3 * c], 3 * sizeof(double));
+  }
+  FrictionContactProblem * permuted =
+    frictionContactProblem_new_with_data(3, nc, NM_new_SBM(n, n, W), q, mu);
+
+  int ordering = options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING];
+  options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] = SICONOS_FRICTION_3D_NSGS_ORDERING_NO;
+  fc3d_nsgs(permuted, r, u, info, options);
+  options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] = ordering;
+
+  for(unsigned int k = 0; k < nc; ++k)
+  {
+    unsigned int c = perm[k];
+    memcpy(&reaction[3 * c], &r[3 * k], 3 * sizeof(double));
+    memcpy(&velocity[3 * c], &u[3 * k], 3 * sizeof(double));
+  }
+  frictionContactProblem_free(permuted);
+  free(r);
+  free(u);
+}
+
 void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
                double *velocity, int* info, SolverOptions* options)
 {
@@ -608,6 +834,18 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
   if(*info == 0)
     return;
 
+  if(iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] != SICONOS_FRICTION_3D_NSGS_ORDERING_NO)
+  {
+    unsigned int * perm = fc3d_nsgs_ordering(problem, options);
+    if(perm)
+    {
+      fc3d_nsgs_permuted(problem, reaction, velocity, info, options, perm);
+      free(perm);
+      return;
+    }
+  }
+  int symmetric = iparam[SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP] == SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_TRUE;
+
   /*****  Initialize various solver options *****/
   localproblem = fc3d_local_problem_allocate(problem);
 
@@ -645,6 +883,7 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
   }
 
   /*****  NSGS Iterations *****/
+  clock_t sweep_start = clock();
 
   /* A special case for the most common options (should correspond
    * with mechanics_run.py **/
@@ -663,7 +902,8 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
 
       for(unsigned int i = 0 ; i < nc ; ++i)
       {
-        contact = i;
+        /* odd iterations sweep forward, even ones backward */
+        contact = (symmetric && !(iter % 2)) ? nc - 1 - i : i;
 
 
         solveLocalReaction(update_localproblem, local_solver, contact,
@@ -719,15 +959,16 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
       }
       for(unsigned int i = 0 ; i < nc ; ++i)
       {
+        unsigned int k = (symmetric && !(iter % 2)) ? nc - 1 - i : i;
         if(iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_TRUE
             || iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_TRUE_EACH_LOOP)
         {
           if(iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_TRUE_EACH_LOOP)
             uint_shuffle(scontacts, nc);
-          contact = scontacts[i];
+          contact = scontacts[k];
         }
         else
-          contact = i;
+          contact = k;
 
        if(iparam[SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT] >0)
         {
@@ -853,6 +1094,9 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
   }
 
 
+  dparam[SICONOS_FRICTION_3D_NSGS_SWEEP_TIME] =
+    iter ? (double)(clock() - sweep_start) / CLOCKS_PER_SEC / iter : 0.;
+
   /* Full criterium */
   if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL)
   {
@@ -891,7 +1135,12 @@ void fc3d_nsgs_set_default(SolverOptions* options)
   options->iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] = SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_FALSE;
   options->iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] = SICONOS_FRICTION_3D_NSGS_RELAXATION_FALSE;
   options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY] = 0;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] = SICONOS_FRICTION_3D_NSGS_ORDERING_NO;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP] = SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_FALSE;
   options->dparam[SICONOS_DPARAM_TOL] = 1e-4;
+  options->dparam[SICONOS_FRICTION_3D_NSGS_GRAVITY] = 0.;
+  options->dparam[SICONOS_FRICTION_3D_NSGS_GRAVITY + 1] = 0.;
+  options->dparam[SICONOS_FRICTION_3D_NSGS_GRAVITY + 2] = -1.;
   options->dparam[SICONOS_FRICTION_3D_DPARAM_INTERNAL_ERROR_RATIO] = 10.0;
   // Internal solver
   assert(options->numberOfInternalSolvers == 1);
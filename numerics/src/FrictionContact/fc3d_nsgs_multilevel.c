@@ -0,0 +1,345 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <assert.h>                       // for assert
+#include <float.h>                        // for DBL_EPSILON, DBL_MAX
+#include <math.h>                         // for fabs, sqrt, hypot, fmax
+#include <stdlib.h>                       // for malloc, calloc, free
+#include "CSparseMatrix_internal.h"       // for CSparseMatrix, CS_INT
+#include "FrictionContactProblem.h"       // for FrictionContactProblem
+#include "Friction_cst.h"                 // for SICONOS_FRICTION_3D_NSGS_ML...
+#include "LinearComplementarityProblem.h" // for LinearComplementarityProblem
+#include "NonSmoothDrivers.h"             // for linearComplementarity_driver
+#include "NumericsMatrix.h"               // for NumericsMatrix, NM_gemv
+#include "SiconosBlas.h"                  // for cblas_dcopy
+#include "SolverOptions.h"                // for SolverOptions, solver_opti...
+#include "SparseBlockMatrix.h"            // for SparseBlockStructuredMatrix
+#include "fc3d_Solvers.h"                 // for fc3d_nsgs, fc3d_nsgs_multil...
+#include "lcp_cst.h"                      // for SICONOS_LCP_LEMKE
+#include "numerics_verbose.h"             // for numerics_printf, numerics_e...
+
+/* Normal-normal couplings W[3i,3j] of the Delassus operator, stored by
+ * rows (CSR). They define the contact graph used for the aggregation and
+ * the coarse operator. */
+typedef struct
+{
+  unsigned int nc;
+  unsigned int * ptr;
+  unsigned int * idx;
+  double * val;
+} NormalGraph;
+
+static void add_coupling(unsigned int * count, unsigned int * ptr, unsigned int * idx, double * val,
+                         unsigned int i, unsigned int j, double v)
+{
+  if(ptr)
+  {
+    unsigned int pos = ptr[i] + count[i];
+    idx[pos] = j;
+    val[pos] = v;
+  }
+  count[i]++;
+}
+
+/* Walk through the normal-normal entries of M, either counting them (ptr
+ * == NULL) or storing them. Sparse block storage is read block by block,
+ * the other storages through their dense or triplet views. */
+static void walk_normal_couplings(NumericsMatrix * M, unsigned int nc, unsigned int * count,
+                                  unsigned int * ptr, unsigned int * idx, double * val)
+{
+  for(unsigned int i = 0; i < nc; ++i) count[i] = 0;
+
+  if(M->storageType == NM_SPARSE_BLOCK)
+  {
+    SparseBlockStructuredMatrix * W = M->matrix1;
+    for(unsigned int row = 0; row < W->filled1 - 1; ++row)
+    {
+      for(size_t bn = W->index1_data[row]; bn < W->index1_data[row + 1]; ++bn)
+      {
+        double v = W->block[bn][0];
+        if(v != 0.0)
+          add_coupling(count, ptr, idx, val, row, (unsigned int)W->index2_data[bn], v);
+      }
+    }
+  }
+  else if(M->storageType == NM_DENSE)
+  {
+    size_t n = 3 * nc;
+    for(unsigned int i = 0; i < nc; ++i)
+      for(unsigned int j = 0; j < nc; ++j)
+      {
+        double v = M->matrix0[3 * i + 3 * j * n];
+        if(v != 0.0)
+          add_coupling(count, ptr, idx, val, i, j, v);
+      }
+  }
+  else
+  {
+    CSparseMatrix * T = NM_triplet(M);
+    for(CS_INT k = 0; k < T->nz; ++k)
+    {
+      if(T->i[k] % 3 == 0 && T->p[k] % 3 == 0 && T->x[k] != 0.0)
+        add_coupling(count, ptr, idx, val, (unsigned int)(T->i[k] / 3), (unsigned int)(T->p[k] / 3), T->x[k]);
+    }
+  }
+}
+
+static void normal_graph_build(NumericsMatrix * M, unsigned int nc, NormalGraph * graph)
+{
+  unsigned int * count = (unsigned int *)malloc(nc * sizeof(unsigned int));
+  graph->nc = nc;
+  graph->ptr = (unsigned int *)malloc((nc + 1) * sizeof(unsigned int));
+
+  walk_normal_couplings(M, nc, count, NULL, NULL, NULL);
+  graph->ptr[0] = 0;
+  for(unsigned int i = 0; i < nc; ++i)
+    graph->ptr[i + 1] = graph->ptr[i] + count[i];
+
+  graph->idx = (unsigned int *)malloc(graph->ptr[nc] * sizeof(unsigned int));
+  graph->val = (double *)malloc(graph->ptr[nc] * sizeof(double));
+  walk_normal_couplings(M, nc, count, graph->ptr, graph->idx, graph->val);
+  free(count);
+}
+
+static void normal_graph_free(NormalGraph * graph)
+{
+  free(graph->ptr);
+  free(graph->idx);
+  free(graph->val);
+}
+
+static double normal_graph_diagonal(NormalGraph * graph, unsigned int i)
+{
+  for(unsigned int k = graph->ptr[i]; k < graph->ptr[i + 1]; ++k)
+    if(graph->idx[k] == i) return graph->val[k];
+  return 0.0;
+}
+
+/* Plain aggregation on the strong couplings of the contact graph:
+ * |W_ij| >= theta sqrt(W_ii W_jj). A first pass builds aggregates around
+ * contacts whose strong neighbours are all free, a second pass attaches the
+ * remaining contacts to the aggregate of their strongest neighbour, or
+ * starts a new aggregate. No aggregate gets more than max_size contacts.
+ * Returns the number of aggregates. */
+static unsigned int aggregate_contacts(NormalGraph * graph, double theta, unsigned int max_size,
+                                       unsigned int * aggregate)
+{
+  unsigned int nc = graph->nc;
+  unsigned int n_aggregates = 0;
+  unsigned int * size = (unsigned int *)calloc(nc, sizeof(unsigned int));
+  double * diag = (double *)malloc(nc * sizeof(double));
+  const unsigned int free_contact = nc;
+
+  for(unsigned int i = 0; i < nc; ++i)
+  {
+    aggregate[i] = free_contact;
+    diag[i] = fabs(normal_graph_diagonal(graph, i));
+  }
+
+#define STRONG(i, k) (graph->idx[k] != (i) &&                             \
+                      fabs(graph->val[k]) >= theta * sqrt(diag[i] * diag[graph->idx[k]]))
+
+  /* first pass: seeds with a free strong neighbourhood */
+  for(unsigned int i = 0; i < nc; ++i)
+  {
+    if(aggregate[i] != free_contact) continue;
+    int is_free = 1;
+    for(unsigned int k = graph->ptr[i]; k < graph->ptr[i + 1] && is_free; ++k)
+      if(STRONG(i, k) && aggregate[graph->idx[k]] != free_contact) is_free = 0;
+    if(!is_free) continue;
+
+    aggregate[i] = n_aggregates;
+    size[n_aggregates] = 1;
+    for(unsigned int k = graph->ptr[i]; k < graph->ptr[i + 1]; ++k)
+    {
+      if(size[n_aggregates] >= max_size) break;
+      if(STRONG(i, k))
+      {
+        aggregate[graph->idx[k]] = n_aggregates;
+        size[n_aggregates]++;
+      }
+    }
+    n_aggregates++;
+  }
+
+  /* second pass: remaining contacts */
+  for(unsigned int i = 0; i < nc; ++i)
+  {
+    if(aggregate[i] != free_contact) continue;
+    double strongest = 0.0;
+    unsigned int target = free_contact;
+    for(unsigned int k = graph->ptr[i]; k < graph->ptr[i + 1]; ++k)
+    {
+      unsigned int j = graph->idx[k];
+      if(STRONG(i, k) && aggregate[j] != free_contact && size[aggregate[j]] < max_size
+          && fabs(graph->val[k]) > strongest)
+      {
+        strongest = fabs(graph->val[k]);
+        target = aggregate[j];
+      }
+    }
+    if(target == free_contact)
+      target = n_aggregates++;
+    aggregate[i] = target;
+    size[target]++;
+  }
+#undef STRONG
+
+  free(size);
+  free(diag);
+  return n_aggregates;
+}
+
+void fc3d_nsgs_multilevel(FrictionContactProblem* problem, double *reaction,
+                          double *velocity, int* info, SolverOptions* options)
+{
+  int* iparam = options->iparam;
+  double* dparam = options->dparam;
+
+  unsigned int nc = problem->numberOfContacts;
+  unsigned int n = 3 * nc;
+  int itermax = iparam[SICONOS_IPARAM_MAX_ITER];
+  double tolerance = dparam[SICONOS_DPARAM_TOL];
+
+  if(options->numberOfInternalSolvers < 2)
+    numerics_error("fc3d_nsgs_multilevel",
+                   "The multilevel NSGS method needs options for the smoother (NSGS) "
+                   "and for the coarse solver (LCP), options->numberOfInternalSolvers should be 2");
+
+  SolverOptions * smoother_options = options->internalSolvers[0];
+  SolverOptions * coarse_options = options->internalSolvers[1];
+  if(smoother_options->solverId != SICONOS_FRICTION_3D_NSGS)
+    numerics_error("fc3d_nsgs_multilevel", "The smoother must be SICONOS_FRICTION_3D_NSGS.");
+
+  smoother_options->iparam[SICONOS_IPARAM_MAX_ITER] = iparam[SICONOS_FRICTION_3D_NSGS_ML_SWEEPS];
+  smoother_options->dparam[SICONOS_DPARAM_TOL] = tolerance;
+
+  /* Aggregation of the contacts and coarse operator P^T W_nn P, where P
+   * prolongates one normal correction per aggregate to all its contacts. */
+  NormalGraph graph;
+  normal_graph_build(problem->M, nc, &graph);
+
+  unsigned int max_size = iparam[SICONOS_FRICTION_3D_NSGS_ML_AGGREGATE_SIZE] > 0 ?
+                          (unsigned int)iparam[SICONOS_FRICTION_3D_NSGS_ML_AGGREGATE_SIZE] : nc;
+  unsigned int * aggregate = (unsigned int *)malloc(nc * sizeof(unsigned int));
+  unsigned int ng = aggregate_contacts(&graph, dparam[SICONOS_FRICTION_3D_NSGS_ML_STRENGTH_THRESHOLD],
+                                       max_size, aggregate);
+  iparam[SICONOS_FRICTION_3D_NSGS_ML_AGGREGATES] = (int)ng;
+
+  double * mc = (double *)calloc(ng * ng, sizeof(double));
+  NumericsMatrix * Mc = NM_create_from_data(NM_DENSE, ng, ng, mc);
+  for(unsigned int i = 0; i < nc; ++i)
+    for(unsigned int k = graph.ptr[i]; k < graph.ptr[i + 1]; ++k)
+      mc[aggregate[i] + aggregate[graph.idx[k]] * ng] += graph.val[k];
+  /* the Delassus operator may be singular on the coarse space */
+  for(unsigned int g = 0; g < ng; ++g)
+    mc[g + g * ng] += sqrt(DBL_EPSILON) * fabs(mc[g + g * ng]) + DBL_EPSILON;
+  normal_graph_free(&graph);
+
+  LinearComplementarityProblem coarse_problem;
+  coarse_problem.size = ng;
+  coarse_problem.M = Mc;
+  coarse_problem.q = (double *)malloc(ng * sizeof(double));
+  double * lower = (double *)malloc(ng * sizeof(double));
+  double * y = (double *)calloc(ng, sizeof(double));
+  double * w = (double *)calloc(ng, sizeof(double));
+
+  numerics_printf("---- FC3D - NSGS_ML - %i contacts in %i aggregates", nc, ng);
+
+  int iter = 0;
+  int sweeps = 0;
+  double error = 1.;
+  *info = 1;
+  while(iter < itermax)
+  {
+    ++iter;
+
+    /* smoothing */
+    int smoother_info = 1;
+    fc3d_nsgs(problem, reaction, velocity, &smoother_info, smoother_options);
+    sweeps += smoother_options->iparam[SICONOS_IPARAM_ITER_DONE];
+    error = smoother_options->dparam[SICONOS_DPARAM_RESIDU];
+    numerics_printf("---- FC3D - NSGS_ML - Iteration %i (%i sweeps) error = %14.7e <> %7.3e",
+                    iter, sweeps, error, tolerance);
+    if(smoother_info == 0)
+    {
+      *info = 0;
+      break;
+    }
+    if(iter == itermax)
+      break;
+
+    /* coarse correction: r_n += P d with d >= lower so that each contact
+     * stays in its cone, minimizing the quadratic energy of the normal
+     * part. With d = lower + y this is the LCP(Mc, P^T u + Mc lower). */
+    cblas_dcopy(n, problem->q, 1, velocity, 1);
+    NM_gemv(1.0, problem->M, reaction, 1.0, velocity);
+    for(unsigned int g = 0; g < ng; ++g)
+    {
+      lower[g] = -DBL_MAX;
+      coarse_problem.q[g] = 0.0;
+    }
+    for(unsigned int i = 0; i < nc; ++i)
+    {
+      unsigned int g = aggregate[i];
+      double rt = hypot(reaction[3 * i + 1], reaction[3 * i + 2]);
+      double mu = problem->mu[i];
+      double bound = (mu > 0.0 ? rt / mu : 0.0) - reaction[3 * i];
+      lower[g] = fmax(lower[g], bound);
+      coarse_problem.q[g] += velocity[3 * i] + mu * hypot(velocity[3 * i + 1], velocity[3 * i + 2]);
+    }
+    NM_gemv(1.0, Mc, lower, 1.0, coarse_problem.q);
+
+    int coarse_info = linearComplementarity_driver(&coarse_problem, y, w, coarse_options);
+    if(coarse_info)
+    {
+      numerics_printf("---- FC3D - NSGS_ML - coarse solver failed (info = %i), no correction",
+                      coarse_info);
+      continue;
+    }
+    for(unsigned int i = 0; i < nc; ++i)
+    {
+      unsigned int g = aggregate[i];
+      reaction[3 * i] += lower[g] + y[g];
+    }
+  }
+
+  iparam[SICONOS_IPARAM_ITER_DONE] = iter;
+  iparam[SICONOS_FRICTION_3D_NSGS_ML_SWEEPS_DONE] = sweeps;
+  dparam[SICONOS_DPARAM_RESIDU] = error;
+
+  free(aggregate);
+  free(coarse_problem.q);
+  free(lower);
+  free(y);
+  free(w);
+  NM_free(Mc);
+}
+
+void fc3d_nsgs_multilevel_set_default(SolverOptions* options)
+{
+  options->iparam[SICONOS_FRICTION_3D_NSGS_ML_SWEEPS] = 10;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_ML_AGGREGATE_SIZE] = 8;
+  options->dparam[SICONOS_FRICTION_3D_NSGS_ML_STRENGTH_THRESHOLD] = 0.25;
+
+  assert(options->numberOfInternalSolvers == 2);
+  /* smoother */
+  options->internalSolvers[0] = solver_options_create(SICONOS_FRICTION_3D_NSGS);
+  /* coarse solver, restarted from the basis of the previous cycle */
+  options->internalSolvers[1] = solver_options_create(SICONOS_LCP_LEMKE);
+}
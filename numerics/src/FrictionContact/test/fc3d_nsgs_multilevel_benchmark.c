@@ -0,0 +1,93 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Compare NSGS and multilevel NSGS on stacks and piles: number of sweeps
+ * and time to reach the default tolerance. The test fails if the multilevel
+ * solver does not solve a problem solved by NSGS. */
+
+#include <stdio.h>                   // for printf
+#include <stdlib.h>                  // for calloc, free
+#include <time.h>                    // for clock
+#include "FrictionContactProblem.h"  // for FrictionContactProblem, fricti...
+#include "Friction_cst.h"            // for SICONOS_FRICTION_3D_NSGS, SICON...
+#include "NonSmoothDrivers.h"        // for fc3d_driver
+#include "SolverOptions.h"           // for SolverOptions, solver_options_...
+
+typedef struct
+{
+  int info;
+  int sweeps;
+  double error;
+  double time;
+} run_result;
+
+static run_result run(FrictionContactProblem* problem, SolverOptions* options)
+{
+  run_result res;
+  int n = 3 * problem->numberOfContacts;
+  double* reaction = (double*)calloc(n, sizeof(double));
+  double* velocity = (double*)calloc(n, sizeof(double));
+  clock_t t = clock();
+  res.info = fc3d_driver(problem, reaction, velocity, options);
+  res.time = (double)(clock() - t) / CLOCKS_PER_SEC;
+  res.error = options->dparam[SICONOS_DPARAM_RESIDU];
+  if(options->solverId == SICONOS_FRICTION_3D_NSGS_ML)
+    res.sweeps = options->iparam[SICONOS_FRICTION_3D_NSGS_ML_SWEEPS_DONE];
+  else
+    res.sweeps = options->iparam[SICONOS_IPARAM_ITER_DONE];
+  free(reaction);
+  free(velocity);
+  return res;
+}
+
+int main(void)
+{
+  const char* data[] =
+  {
+    "./data/BoxesStack1-i100000-32.hdf5.dat",
+    "./data/KaplasTower-i1061-4.hdf5.dat",
+    "./data/RockPile_tob1.dat"
+  };
+  int n_data = (int)(sizeof(data) / sizeof(data[0]));
+  int out = 0;
+
+  printf("%-40s %5s | %-26s | %-26s | %s\n", "problem", "nc", "NSGS info/sweeps/s",
+         "NSGS_ML info/sweeps/s", "aggregates");
+  for(int i = 0; i < n_data; ++i)
+  {
+    FrictionContactProblem* problem = frictionContact_new_from_filename(data[i]);
+
+    SolverOptions* nsgs = solver_options_create(SICONOS_FRICTION_3D_NSGS);
+    nsgs->iparam[SICONOS_IPARAM_MAX_ITER] = 5000;
+    SolverOptions* ml = solver_options_create(SICONOS_FRICTION_3D_NSGS_ML);
+    ml->iparam[SICONOS_IPARAM_MAX_ITER] = 500;
+
+    run_result r0 = run(problem, nsgs);
+    run_result r1 = run(problem, ml);
+    printf("%-40s %5d | %2d %6d %9.2e %6.1e | %2d %6d %9.2e %6.1e | %d\n", data[i],
+           problem->numberOfContacts, r0.info, r0.sweeps, r0.time, r0.error,
+           r1.info, r1.sweeps, r1.time, r1.error, ml->iparam[SICONOS_FRICTION_3D_NSGS_ML_AGGREGATES]);
+    if(r0.info == 0 && r1.info != 0)
+      out = 1;
+
+    solver_options_delete(nsgs);
+    solver_options_delete(ml);
+    frictionContactProblem_free(problem);
+  }
+  return out;
+}
@@ -0,0 +1,116 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Compare the orderings of the contacts and the symmetric sweeps of NSGS:
+ * number of sweeps and time per sweep. The data files do not store the
+ * contact points, the geometric orderings are run on synthetic points and
+ * only checked for consistency: the test fails if the residual of the
+ * solution returned on the original problem differs from the one reported
+ * by the solver. */
+
+#include <math.h>                    // for fabs
+#include <stdio.h>                   // for printf
+#include <stdlib.h>                  // for calloc, free, rand
+#include "FrictionContactProblem.h"  // for FrictionContactProblem, fricti...
+#include "Friction_cst.h"            // for SICONOS_FRICTION_3D_NSGS, SICON...
+#include "NonSmoothDrivers.h"        // for fc3d_driver
+#include "SiconosBlas.h"             // for cblas_dnrm2
+#include "SolverOptions.h"           // for SolverOptions, solver_options_...
+#include "fc3d_compute_error.h"      // for fc3d_compute_error
+
+typedef struct
+{
+  const char* name;
+  int ordering;
+  int symmetric;
+} variant;
+
+int main(void)
+{
+  const char* data[] =
+  {
+    "./data/BoxesStack1-i100000-32.hdf5.dat",
+    "./data/KaplasTower-i1061-4.hdf5.dat",
+    "./data/Capsules-i122-1617.dat",
+    "./data/RockPile_tob1.dat"
+  };
+  variant variants[] =
+  {
+    {"NO", SICONOS_FRICTION_3D_NSGS_ORDERING_NO, SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_FALSE},
+    {"NO+SYM", SICONOS_FRICTION_3D_NSGS_ORDERING_NO, SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_TRUE},
+    {"RCM", SICONOS_FRICTION_3D_NSGS_ORDERING_RCM, SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_FALSE},
+    {"RCM+SYM", SICONOS_FRICTION_3D_NSGS_ORDERING_RCM, SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_TRUE},
+    {"MORTON", SICONOS_FRICTION_3D_NSGS_ORDERING_MORTON, SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_FALSE},
+    {"BOTTOM_UP", SICONOS_FRICTION_3D_NSGS_ORDERING_BOTTOM_UP, SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP_FALSE}
+  };
+  int n_data = (int)(sizeof(data) / sizeof(data[0]));
+  int n_variants = (int)(sizeof(variants) / sizeof(variants[0]));
+  int out = 0;
+
+  srand(1);
+  printf("%-40s %5s %-10s %4s %6s %9s %9s\n", "problem", "nc", "ordering", "info",
+         "sweeps", "s/sweep", "residual");
+  for(int i = 0; i < n_data; ++i)
+  {
+    FrictionContactProblem* problem = frictionContact_new_from_filename(data[i]);
+    int nc = problem->numberOfContacts;
+    int n = 3 * nc;
+    double norm_q = cblas_dnrm2(n, problem->q, 1);
+    double* reaction = (double*)calloc(n, sizeof(double));
+    double* velocity = (double*)calloc(n, sizeof(double));
+
+    for(int v = 0; v < n_variants; ++v)
+    {
+      SolverOptions* options = solver_options_create(SICONOS_FRICTION_3D_NSGS);
+      options->iparam[SICONOS_IPARAM_MAX_ITER] = 5000;
+      options->iparam[SICONOS_FRICTION_3D_NSGS_ORDERING] = variants[v].ordering;
+      options->iparam[SICONOS_FRICTION_3D_NSGS_SYMMETRIC_SWEEP] = variants[v].symmetric;
+      if(variants[v].ordering == SICONOS_FRICTION_3D_NSGS_ORDERING_MORTON
+          || variants[v].ordering == SICONOS_FRICTION_3D_NSGS_ORDERING_BOTTOM_UP)
+      {
+        options->dWorkSize = n;
+        options->dWork = (double*)malloc(n * sizeof(double));
+        for(int k = 0; k < n; ++k)
+          options->dWork[k] = (double)rand() / RAND_MAX;
+      }
+      for(int k = 0; k < n; ++k)
+        reaction[k] = velocity[k] = 0.;
+
+      int info = fc3d_driver(problem, reaction, velocity, options);
+
+      double error = 0.;
+      fc3d_compute_error(problem, reaction, velocity, options->dparam[SICONOS_DPARAM_TOL],
+                         options, norm_q, &error);
+      double reported = options->dparam[SICONOS_DPARAM_RESIDU];
+      printf("%-40s %5d %-10s %4d %6d %9.2e %9.2e\n", data[i], nc, variants[v].name, info,
+             options->iparam[SICONOS_IPARAM_ITER_DONE],
+             options->dparam[SICONOS_FRICTION_3D_NSGS_SWEEP_TIME], error);
+      if(fabs(error - reported) > 1e-6 * fabs(reported) + 1e-14)
+      {
+        printf("residual on the original problem %e differs from the reported one %e\n",
+               error, reported);
+        out = 1;
+      }
+      solver_options_delete(options);
+    }
+    free(reaction);
+    free(velocity);
+    frictionContactProblem_free(problem);
+  }
+  return out;
+}
@@ -24,6 +24,7 @@
 #include <stdio.h>                              // for printf, size_t, NULL
 #include <stdlib.h>                             // for free, malloc, calloc
 #include <string.h>                             // for memcpy
+#include "CSparseMatrix_internal.h"             // for CSparseMatrix, CS_INT
 #include "SiconosBlas.h"                              // for cblas_dgemv, CblasNoT...
 #include "FrictionContactProblem.h"             // for FrictionContactProblem
 #include "GenericMechanicalProblem.h"           // for listNumericsProblem
@@ -38,6 +39,7 @@
 #include "SparseBlockMatrix.h"                  // for SparseBlockStructured...
 #include "lcp_cst.h"                            // for SICONOS_LCP_ENUM
 #include "mlcp_cst.h"                           // for SICONOS_MLCP_ENUM
+#include "numerics_verbose.h"                   // for numerics_warning
 #include "pinv.h"                               // for pinv
 
 void _GMPReducedEquality(GenericMechanicalProblem* pInProblem, double * reducedProb, double * Qreduced, int * Me_size, int* Mi_size);
@@ -630,6 +632,221 @@ void gmp_reduced_solve(GenericMechanicalProblem* pInProblem, double *reaction, d
 
 }
 
+/* Solve Me_1 x = b for nrhs right hand sides, with the factors of
+ * Me_1 computed at the first call. */
+static int _GMPReducedSparseSolveMe1(NumericsMatrix* Me1, int symmetric, double * b, unsigned int nrhs)
+{
+  if(symmetric)
+    return NM_LDLT_solve(Me1, b, nrhs);
+  else
+    return NM_LU_solve(Me1, b, nrhs);
+}
+
+/*
+ * The equalities are eliminated, with sparse matrices.
+ *
+ *0=(Me_1 Me_2)(Re Ri)' + Qe
+ *Vi=(Mi_1 Mi_2)(Re Ri)' + Qi
+ *
+ *Re=-Me_1^{-1}(Me_2Ri+Qe)
+ *
+ *Vi=(Mi_2-Mi_1 Me_1^{-1} Me_2)Ri+Qi-Mi1 Me_1^{-1} Qe
+ *
+ * Me_1 is factorized once. Me_1^{-1} Me_2 is computed column by
+ * column, for the non empty columns of Me_2 only, and the Schur
+ * complement is assembled in a sparse block matrix whose blocks are the
+ * ones of the inequalities, so that the GS iterations of the reduced
+ * problem cost what they cost on the initial problem.
+ */
+void gmp_reduced_sparse_solve(GenericMechanicalProblem* pInProblem, double *reaction, double *velocity, int * info, SolverOptions* options)
+{
+  SparseBlockStructuredMatrix* m = pInProblem->M->matrix1;
+  unsigned int nbBlock = m->blocknumber0;
+  int Me_size;
+  int Mi_size;
+  _GMPReducedGetSizes(pInProblem, &Me_size, &Mi_size);
+
+  if((Me_size == 0 || Mi_size == 0))
+  {
+    gmp_gauss_seidel(pInProblem, reaction, velocity, info, options);
+    return;
+  }
+
+  /* position of the blocks in Me or Mi */
+  int * isEq = (int *) malloc(nbBlock * sizeof(int));
+  int * offset = (int *) malloc(nbBlock * sizeof(int));
+  unsigned int * blocksizeI = (unsigned int *) malloc(nbBlock * sizeof(unsigned int));
+  unsigned int nbBlockI = 0;
+  double *Qe = (double *) malloc(Me_size * sizeof(double));
+  double *Qi = (double *) malloc(Mi_size * sizeof(double));
+  listNumericsProblem * curProblem =  pInProblem->firstListElem;
+  int curPosEq = 0;
+  int curPosIq = 0;
+  int curPos = 0;
+  for(unsigned int numBlock = 0; numBlock < nbBlock; numBlock++)
+  {
+    int curSize = curProblem->size;
+    isEq[numBlock] = (curProblem->type == SICONOS_NUMERICS_PROBLEM_EQUALITY);
+    if(isEq[numBlock])
+    {
+      offset[numBlock] = curPosEq;
+      memcpy(Qe + curPosEq, pInProblem->q + curPos, curSize * sizeof(double));
+      curPosEq += curSize;
+    }
+    else
+    {
+      offset[numBlock] = curPosIq;
+      memcpy(Qi + curPosIq, pInProblem->q + curPos, curSize * sizeof(double));
+      curPosIq += curSize;
+      blocksizeI[nbBlockI++] = curPosIq;
+    }
+    curPos += curSize;
+    curProblem = curProblem->nextProblem;
+  }
+
+  /* the four parts of M, in triplet */
+  NumericsMatrix * Me1 = NM_create(NM_SPARSE, Me_size, Me_size);
+  NumericsMatrix * Me2 = NM_create(NM_SPARSE, Me_size, Mi_size);
+  NumericsMatrix * Mi1 = NM_create(NM_SPARSE, Mi_size, Me_size);
+  NumericsMatrix * Mi2 = NM_create(NM_SPARSE, Mi_size, Mi_size);
+  NM_triplet_alloc(Me1, 0);
+  NM_triplet_alloc(Me2, 0);
+  NM_triplet_alloc(Mi1, 0);
+  NM_triplet_alloc(Mi2, 0);
+  for(unsigned int row = 0; row < m->filled1 - 1; row++)
+  {
+    int nbRowInBlock = m->blocksize0[row] - (row ? m->blocksize0[row - 1] : 0);
+    for(size_t blockNum = m->index1_data[row]; blockNum < m->index1_data[row + 1]; blockNum++)
+    {
+      size_t col = m->index2_data[blockNum];
+      int nbColInBlock = m->blocksize1[col] - (col ? m->blocksize1[col - 1] : 0);
+      NumericsMatrix * part = isEq[row] ? (isEq[col] ? Me1 : Me2) : (isEq[col] ? Mi1 : Mi2);
+      double * block = m->block[blockNum];
+      for(int j = 0; j < nbColInBlock; j++)
+        for(int i = 0; i < nbRowInBlock; i++)
+          if(block[i + j * nbRowInBlock] != 0.0)
+            NM_entry(part, offset[row] + i, offset[col] + j, block[i + j * nbRowInBlock]);
+    }
+  }
+
+  int symmetric = NM_is_symmetric(Me1);
+  int factorized = symmetric ? NM_LDLT_factorize(Me1) : NM_LU_factorize(Me1);
+  if(factorized)
+  {
+    numerics_warning("gmp_reduced_sparse_solve",
+                     "the factorization of the equality block failed, call of gmp_reduced_solve.");
+    NM_free(Me1);
+    NM_free(Me2);
+    NM_free(Mi1);
+    NM_free(Mi2);
+    free(Qe);
+    free(Qi);
+    free(isEq);
+    free(offset);
+    free(blocksizeI);
+    gmp_reduced_solve(pInProblem, reaction, velocity, info, options);
+    return;
+  }
+
+  /* X = Me_1^{-1} Me_2, for the non empty columns of Me_2 */
+  CSparseMatrix * Me2csc = NM_csc(Me2);
+  NumericsMatrix * X = NM_create(NM_SPARSE, Me_size, Mi_size);
+  NM_triplet_alloc(X, Me2csc->p[Mi_size]);
+  double * xcol = (double *) malloc(Me_size * sizeof(double));
+  for(int j = 0; j < Mi_size; j++)
+  {
+    if(Me2csc->p[j] == Me2csc->p[j + 1])
+      continue;
+    for(int i = 0; i < Me_size; i++)
+      xcol[i] = 0.0;
+    for(CS_INT k = Me2csc->p[j]; k < Me2csc->p[j + 1]; k++)
+      xcol[Me2csc->i[k]] = Me2csc->x[k];
+    _GMPReducedSparseSolveMe1(Me1, symmetric, xcol, 1);
+    for(int i = 0; i < Me_size; i++)
+      if(xcol[i] != 0.0)
+        NM_entry(X, i, j, xcol[i]);
+  }
+
+  /* W = Mi_2 - Mi_1 X */
+  NumericsMatrix * Mi1X = NM_multiply(Mi1, X);
+  NumericsMatrix * W = NM_add(1.0, Mi2, -1.0, Mi1X);
+  SparseBlockStructuredMatrix * Wsbm = SBM_new();
+  SBM_from_csparse_blocks(nbBlockI, blocksizeI, NM_csc(W), Wsbm);
+
+  /* qi = Qi - Mi_1 Me_1^{-1} Qe */
+  memcpy(xcol, Qe, Me_size * sizeof(double));
+  _GMPReducedSparseSolveMe1(Me1, symmetric, xcol, 1);
+  NM_gemv(-1.0, Mi1, xcol, 1.0, Qi);
+
+  GenericMechanicalProblem * _pnumerics_GMP = genericMechanicalProblem_new();
+  curProblem =  pInProblem->firstListElem;
+  while(curProblem)
+  {
+    switch(curProblem->type)
+    {
+    case SICONOS_NUMERICS_PROBLEM_EQUALITY:
+    {
+      break;
+    }
+    case SICONOS_NUMERICS_PROBLEM_LCP:
+    {
+      gmp_add(_pnumerics_GMP, curProblem->type, curProblem->size);
+      break;
+    }
+    case SICONOS_NUMERICS_PROBLEM_FC3D:
+    {
+      FrictionContactProblem* pFC3D = (FrictionContactProblem*)gmp_add(_pnumerics_GMP, curProblem->type, curProblem->size);
+      *(pFC3D->mu) = *(((FrictionContactProblem*)curProblem->problem)->mu);
+      break;
+    }
+    default:
+      printf("GMPReduced  gmp_reduced_sparse_solve: problemType unknown: %d . \n", curProblem->type);
+    }
+    curProblem = curProblem->nextProblem;
+  }
+  _pnumerics_GMP->M = NM_new_SBM(Mi_size, Mi_size, Wsbm);
+  _pnumerics_GMP->q = Qi;
+  double *Rreduced = (double *) calloc(Mi_size, sizeof(double));
+  double *Vreduced = (double *) calloc(Mi_size, sizeof(double));
+  gmp_gauss_seidel(_pnumerics_GMP, Rreduced, Vreduced, info, options);
+  if(!*info)
+  {
+    /*Re computation*/
+    double * Re = (double*)malloc(Me_size * sizeof(double));
+    memcpy(Re, Qe, Me_size * sizeof(double));
+    NM_gemv(1.0, Me2, Rreduced, 1.0, Re);
+    _GMPReducedSparseSolveMe1(Me1, symmetric, Re, 1);
+    cblas_dscal(Me_size, -1.0, Re, 1);
+    gmp_reduced_convert_solution(pInProblem, reaction, velocity, Re, Rreduced, Vreduced);
+    double err;
+    int tolViolate = gmp_compute_error(pInProblem, reaction, velocity, options->dparam[SICONOS_DPARAM_TOL], options, &err);
+    if(tolViolate)
+    {
+      printf("GMPReducedSparse, warnning, reduced problem solved, but error of initial probleme violated tol = %e, err= %e\n", options->dparam[SICONOS_DPARAM_TOL], err);
+    }
+    free(Re);
+  }
+
+  free(Rreduced);
+  free(Vreduced);
+  NM_free(_pnumerics_GMP->M);
+  _pnumerics_GMP->M = NULL;
+  genericMechanicalProblem_free(_pnumerics_GMP, NUMERICS_GMP_FREE_GMP);
+  NM_free(W);
+  NM_free(Mi1X);
+  NM_free(X);
+  NM_free(Me1);
+  NM_free(Me2);
+  NM_free(Mi1);
+  NM_free(Mi2);
+  free(xcol);
+  free(Qe);
+  free(Qi);
+  free(isEq);
+  free(offset);
+  free(blocksizeI);
+}
+
 void _GMPReducedEquality(GenericMechanicalProblem* pInProblem, double * reducedProb, double * Qreduced, int * Me_size, int* Mi_size)
 {
 
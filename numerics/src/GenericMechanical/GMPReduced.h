@@ -35,6 +35,14 @@
  */
 void gmp_reduced_solve(GenericMechanicalProblem* pInProblem, double *reaction , double *velocity, int* info, SolverOptions* options);
 
+/* The equalities are eliminated as in gmp_reduced_solve, with sparse
+ * matrices: Me_1 is factorized once (LDLT if it is symmetric, LU
+ * otherwise) and the Schur complement W=Mi_2-Mi_1 Me_1^{-1} Me_2 is
+ * assembled as a sparse block matrix, with the blocks of the
+ * inequalities.
+ */
+void gmp_reduced_sparse_solve(GenericMechanicalProblem* pInProblem, double *reaction , double *velocity, int* info, SolverOptions* options);
+
 /*  The equalities are assembled in an single block.
  *
  * 0=(Me_1 Me_2)(Re Ri)' + Qe
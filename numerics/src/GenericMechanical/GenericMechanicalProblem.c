@@ -34,6 +34,9 @@ GenericMechanicalProblem * genericMechanicalProblem_new()
   paux->lastListElem = 0;
   paux->size = 0;
   paux->maxLocalSize = 0;
+  paux->subProblems = NULL;
+  paux->numberOfSubProblems = 0;
+  paux->subProblemsCapacity = 0;
   return paux;
 }
 
@@ -77,6 +80,10 @@ void genericMechanicalProblem_free(GenericMechanicalProblem * pGMP, unsigned int
     pGMP->lastListElem = pElem->prevProblem;
     free(pElem);
   }
+  free(pGMP->subProblems);
+  pGMP->subProblems = NULL;
+  pGMP->numberOfSubProblems = 0;
+  pGMP->subProblemsCapacity = 0;
   if(level & NUMERICS_GMP_FREE_MATRIX)
   {
     assert(pGMP->M);
@@ -99,6 +106,18 @@ void * gmp_add(GenericMechanicalProblem * pGMP, int problemType, int size)
   newProblem->type = problemType;
   newProblem->size = size;
   newProblem->error = 0;
+  if(pGMP->numberOfSubProblems == pGMP->subProblemsCapacity)
+  {
+    pGMP->subProblemsCapacity = pGMP->subProblemsCapacity ? 2 * pGMP->subProblemsCapacity : 16;
+    pGMP->subProblems = (gmp_subproblem*) realloc(pGMP->subProblems,
+                        pGMP->subProblemsCapacity * sizeof(gmp_subproblem));
+  }
+  gmp_subproblem * sub = &pGMP->subProblems[pGMP->numberOfSubProblems];
+  sub->type = problemType;
+  sub->size = size;
+  sub->row = pGMP->numberOfSubProblems++;
+  sub->pos = pGMP->size;
+  sub->elem = newProblem;
   pGMP->size += size;
   if(size > pGMP->maxLocalSize)
     pGMP->maxLocalSize = size;
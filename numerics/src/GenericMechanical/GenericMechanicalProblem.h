@@ -54,6 +54,25 @@ struct listNumericsProblem
   struct listNumericsProblem * prevProblem;
 };
 
+/** \struct gmp_subproblem GenericMechanicalProblem.h
+ * Descriptor of a sub-problem in the array of the sub-problems of a
+ * GenericMechanicalProblem, in the order of the rows of blocks.
+ *   \param type the problem type (SICONOS_NUMERICS_PROBLEM_TYPE)
+ *   \param size size of the local problem
+ *   \param row the number of the row of blocks
+ *   \param pos position of the local problem in the reaction and velocity
+ *   \param elem the sub-problem in the list
+ */
+struct gmp_subproblem
+{
+  int type;
+  int size;
+  int row;
+  int pos;
+  struct listNumericsProblem * elem;
+};
+typedef struct gmp_subproblem gmp_subproblem;
+
 
 /** \enum SICONOS_NUMERICS_PROBLEM_TYPE ids for the possible/allowed numerics problem formulations
  */
@@ -79,6 +98,9 @@ enum SICONOS_NUMERICS_PROBLEM_TYPE
  * \param maxLocalSize "private" manage by gmp_add
  * \param firstListElem "private" manage by gmp_add
  * \param lastListElem  "private" manage by gmp_add
+ * \param subProblems "private" manage by gmp_add, the descriptors of the sub-problems
+ * \param numberOfSubProblems "private" manage by gmp_add
+ * \param subProblemsCapacity "private" manage by gmp_add
  *
  *  Remark:
  *  The M and q contains the matrices of the GMP problem.
@@ -106,6 +128,12 @@ struct GenericMechanicalProblem
   listNumericsProblem *firstListElem;
   /*PRIVATE: manage by gmp_add.*/
   listNumericsProblem *lastListElem;
+  /*PRIVATE: manage by gmp_add, the sub-problems in an array.*/
+  gmp_subproblem *subProblems;
+  /*PRIVATE: manage by gmp_add.*/
+  int numberOfSubProblems;
+  /*PRIVATE: manage by gmp_add.*/
+  int subProblemsCapacity;
   //  void * * problems;
 };
 
@@ -41,7 +41,8 @@ extern "C"
    * \param[in,out] options structure used to define the solver(s) and their parameters
    *               option->iparam[0]:nb max of iterations
    *   option->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_WITH_LINESEARCH]:0 without 'LS' 1 with.
-   *   option->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_ISREDUCED]:0 GS block after block, 1 eliminate the equalities, 2 only one equality block, 3 solve the GMP as a MLCP.
+   *   option->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_ISREDUCED]:0 GS block after block, 1 eliminate the equalities, 2 only one equality block, 3 solve the GMP as a MLCP, 4 eliminate the equalities with sparse factors.
+   *   option->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_SWEEP]:0 sequential sweep, 1 colored sweep (parallel with OpenMP).
    *   option->iparam[SICONOS_IPARAM_ITER_DONE]: output, number of GS it.
    *   options->dparam[SICONOS_DPARAM_TOL]: tolerance
    * \return result (0 if successful otherwise 1).
@@ -36,6 +36,10 @@ enum GENERIC_MECHANICAL_SOLVER
 enum GENERIC_MECHANICAL_IPARAM
   {
    SICONOS_GENERIC_MECHANICAL_IPARAM_ISREDUCED = 2,
+   /** index in iparam to store the sweep strategy of the GS (see GENERIC_MECHANICAL_SWEEP) */
+   SICONOS_GENERIC_MECHANICAL_IPARAM_SWEEP = 3,
+   /** index in iparam to store the number of colors of the colored sweep (out) */
+   SICONOS_GENERIC_MECHANICAL_IPARAM_NUMBER_OF_COLORS = 4,
    SICONOS_GENERIC_MECHANICAL_IPARAM_WITH_LINESEARCH = 19,
   };
 
@@ -52,6 +56,16 @@ enum GENERIC_MECHANICAL_ISREDUCED
    SICONOS_GENERIC_MECHANICAL_SUBS_EQUALITIES = 1, // The equalities are substituated
    SICONOS_GENERIC_MECHANICAL_ASSEMBLE_EQUALITIES = 2, // Equalities are assemblated in one block
    SICONOS_GENERIC_MECHANICAL_MLCP_LIKE = 3, // Try to solve like a MLCP (==> No FC3d)
+   SICONOS_GENERIC_MECHANICAL_SUBS_EQUALITIES_SPARSE = 4, // The equalities are substituated with sparse factors
+  };
+
+/**\enum GENERIC_MECHANICAL_SWEEP Possible values for iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_SWEEP]  */
+enum GENERIC_MECHANICAL_SWEEP
+  {
+   SICONOS_GENERIC_MECHANICAL_SWEEP_SEQUENTIAL = 0, // sub-problems in the order of the rows
+   /* sub-problems without coupling block share a color, the colors are
+      swept one after the other, in parallel inside a color with OpenMP */
+   SICONOS_GENERIC_MECHANICAL_SWEEP_COLORED = 1,
   };
 
 extern const char* const  SICONOS_GENERIC_MECHANICAL_NSGS_STR;
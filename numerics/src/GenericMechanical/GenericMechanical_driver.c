@@ -38,6 +38,7 @@
 #include "Relay_Solvers.h"                 // for relay_compute_error
 #include "SiconosBlas.h"                   // for cblas_dnrm2, cblas_dgemv
 #include "SolverOptions.h"                 // for SolverOptions, solver_opti...
+#include "SparseBlockMatrix.h"             // for SparseBlockStructuredMatrix
 #include "fc3d_compute_error.h"            // for fc3d_unitary_compute_and_a...
 #include "fc2d_compute_error.h"            // for fc3d_unitary_compute_and_a...
 #include "lcp_cst.h"                       // for SICONOS_LCP_LEMKE
@@ -48,6 +49,9 @@
 /* #define DEBUG_STDOUT */
 /* #define DEBUG_MESSAGES */
 #include "siconos_debug.h"                         // for DEBUG_PRINTF, DEBUG_EXPR
+#ifdef _OPENMP
+#include <omp.h>                           // for omp_get_max_threads, omp_get...
+#endif
 
 #ifdef DEBUG_MESSAGES
 #include "NumericsVector.h"
@@ -57,7 +61,7 @@ const char* const   SICONOS_GENERIC_MECHANICAL_NSGS_STR = "GMP_NSGS";
 
 int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction, double *velocity, double tol, SolverOptions* options, double * err)
 {
-  listNumericsProblem * curProblem = pGMP->firstListElem;
+  listNumericsProblem * curProblem = NULL;
   NM_types storageType = pGMP->M->storageType;
   NumericsMatrix* numMat = pGMP->M;
   int currentRowNumber = 0;
@@ -72,10 +76,12 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction, double *
   numerics_printf("GenericMechanical compute_error BEGIN:\n");
 #endif
   /*update localProblem->q and compute V = M*R+Q of the GMP */
-  posInX = 0;
-  while(curProblem)
+  for(int k = 0; k < pGMP->numberOfSubProblems; k++)
   {
-    curSize = curProblem->size;
+    curProblem = pGMP->subProblems[k].elem;
+    currentRowNumber = pGMP->subProblems[k].row;
+    posInX = pGMP->subProblems[k].pos;
+    curSize = pGMP->subProblems[k].size;
 
     /*localproblem->q <-- GMP->q */
     memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
@@ -110,20 +116,15 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction, double *
 #ifdef GENERICMECHANICAL_DEBUG_COMPUTE_ERROR
     printDenseMatrice("velocity", 0, velocity + posInX, curSize, 1);
 #endif
-    /*next*/
-    posInX += curProblem->size;
-    curProblem = curProblem->nextProblem;
-    currentRowNumber++;
   }
 
 
   /*For each sub-problem, call the corresponding function computing the error.*/
-  posInX = 0;
-  currentRowNumber = 0;
-  curProblem = pGMP->firstListElem;
-  while(curProblem)
+  for(int k = 0; k < pGMP->numberOfSubProblems; k++)
   {
-    curSize = curProblem->size;
+    curProblem = pGMP->subProblems[k].elem;
+    posInX = pGMP->subProblems[k].pos;
+    curSize = pGMP->subProblems[k].size;
     double * Vl = velocity + posInX;
     double * Rl = reaction + posInX;
     for(ii = 0; ii < curSize; ii++)
@@ -209,10 +210,6 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction, double *
     default:
       numerics_printf("Numerics : gmp_gauss_seidel unknown problem type %d.\n", curProblem->type);
     }
-    /*next*/
-    posInX += curProblem->size;
-    curProblem = curProblem->nextProblem;
-    currentRowNumber++;
   }
 #ifdef GENERICMECHANICAL_DEBUG_COMPUTE_ERROR
   if(*err > tol)
@@ -232,6 +229,262 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction, double *
 static int SScmp = 0;
 static int SScmpTotal = 0;
 #endif
+
+/* Solve the sub-problem sub with the diagonal block diagBlock, the
+ * other blocks of its row being multiplied by the current reaction.
+ * internalSolvers are the options of the local solvers (LCP, FC3D,
+ * RELAY, FC2D). Returns the info of the local solver. */
+static int gmp_solve_subproblem(GenericMechanicalProblem* pGMP, gmp_subproblem* sub, double * diagBlock,
+                                double * reaction, double * velocity, SolverOptions ** internalSolvers)
+{
+  listNumericsProblem * curProblem = sub->elem;
+  NumericsMatrix* numMat = pGMP->M;
+  int currentRowNumber = sub->row;
+  int posInX = sub->pos;
+  size_t curSize = sub->size;
+  double * sol = reaction + posInX;
+  double * w = velocity + posInX;
+  int resLocalSolver = 0;
+
+  switch(sub->type)
+  {
+  case SICONOS_NUMERICS_PROBLEM_EQUALITY:
+  {
+    numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_EQUALITY");
+    NumericsMatrix M;
+    NM_fill(&M, NM_DENSE, curSize, curSize, diagBlock);
+
+    memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
+    NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, curProblem->q, NULL, 0);
+    for(size_t i = 0; i < curSize; ++i) sol[i] = -curProblem->q[i];
+
+    // resLocalSolver = NM_gesv(&M, sol, true);
+    resLocalSolver = NM_LU_solve(NM_preserve(&M), sol, 1);
+
+    M.matrix0 = NULL;
+    NM_clear(&M);
+    break;
+  }
+  case SICONOS_NUMERICS_PROBLEM_LCP:
+  {
+    numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_LCP");
+    /*Mz*/
+    LinearComplementarityProblem* lcpProblem = (LinearComplementarityProblem*) curProblem->problem;
+    lcpProblem->M->matrix0 = diagBlock;
+    /*about q.*/
+    memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
+    NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, lcpProblem->q, NULL, 0);
+    resLocalSolver = linearComplementarity_driver(lcpProblem, sol, w, internalSolvers[0]);
+    break;
+  }
+  case SICONOS_NUMERICS_PROBLEM_RELAY:
+  {
+    numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_RELAY");
+    /*Mz*/
+    RelayProblem* relayProblem = (RelayProblem*) curProblem->problem;
+    relayProblem->M->matrix0 = diagBlock;
+    /*about q.*/
+    memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
+    NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, relayProblem->q, NULL, 0);
+    resLocalSolver = relay_driver(relayProblem, sol, w, internalSolvers[2]);
+    break;
+  }
+  case SICONOS_NUMERICS_PROBLEM_FC3D:
+  {
+    numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_FC3D");
+    FrictionContactProblem * fcProblem = (FrictionContactProblem *)curProblem->problem;
+    assert(fcProblem);
+    assert(fcProblem->M);
+    assert(fcProblem->q);
+    fcProblem->M->matrix0 = diagBlock;
+    memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
+
+    DEBUG_EXPR_WE(
+      NV_display(curProblem->q,3);
+      for(int i =0 ; i < 3; i++)
+        numerics_printf("curProblem->q[%i]= %12.8e,\t fcProblem->q[%i]= %12.8e,\n",i,curProblem->q[i],i,fcProblem->q[i]);
+      );
+
+    NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, fcProblem->q, NULL, 0);
+
+    DEBUG_EXPR_WE(
+      for(int i =0 ; i < 3; i++)
+        numerics_printf("reaction[%i]= %12.8e,\t fcProblem->q[%i]= %12.8e,\n",
+                        i,reaction[i],i,fcProblem->q[i]);
+      );
+
+    /* We call the generic driver (rather than the specific) since we may choose between various local solvers */
+    resLocalSolver = fc3d_driver(fcProblem, sol, w, internalSolvers[1]);
+    //resLocalSolver=fc3d_unitary_enumerative_solve(fcProblem,sol,&options->internalSolvers[1]);
+    break;
+  }
+  case SICONOS_NUMERICS_PROBLEM_FC2D:
+  {
+    numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_FC2D");
+    FrictionContactProblem * fcProblem = (FrictionContactProblem *)curProblem->problem;
+    assert(fcProblem);
+    assert(fcProblem->M);
+    assert(fcProblem->q);
+    fcProblem->M->matrix0 = diagBlock;
+    memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
+
+    DEBUG_EXPR_WE(
+      NV_display(curProblem->q,2);
+      for(int i =0 ; i < 2; i++)
+        numerics_printf("curProblem->q[%i]= %12.8e,\t fcProblem->q[%i]= %12.8e,\n",i,curProblem->q[i],i,fcProblem->q[i]);
+      );
+
+    NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, fcProblem->q, NULL, 0);
+
+    DEBUG_EXPR_WE(
+      for(int i =0 ; i < 2; i++)
+        numerics_printf("reaction[%i]= %12.8e,\t fcProblem->q[%i]= %12.8e,\n",i,reaction[i],i,fcProblem->q[i]);
+      );
+
+    /* We call the generic driver (rather than the specific) since we may choose between various local solvers */
+    resLocalSolver = fc2d_driver(fcProblem, sol, w, internalSolvers[3]);
+    //resLocalSolver=fc3d_unitary_enumerative_solve(fcProblem,sol,&options->internalSolvers[1]);
+    break;
+  }
+  default:
+    numerics_printf("genericMechanical_GS Numerics : gmp_gauss_seidel unknown problem type %d.\n", sub->type);
+  }
+  return resLocalSolver;
+}
+
+/* Free a copy of the options of a local solver made by
+ * solver_options_copy: the callback, solverData and solverParameters
+ * are shared with the original options and are not freed. */
+static void gmp_thread_solver_free(SolverOptions * copy)
+{
+  copy->callback = NULL;
+  copy->solverData = NULL;
+  copy->solverParameters = NULL;
+  for(size_t i = 0; i < copy->numberOfInternalSolvers; i++)
+  {
+    gmp_thread_solver_free(copy->internalSolvers[i]);
+    copy->internalSolvers[i] = NULL;
+  }
+  solver_options_delete(copy);
+  free(copy);
+}
+
+typedef struct
+{
+  int color;
+  int type;
+  int size;
+  int row;
+} gmp_sweep_key;
+
+static int gmp_sweep_key_compare(const void * a, const void * b)
+{
+  const gmp_sweep_key * ka = (const gmp_sweep_key *) a;
+  const gmp_sweep_key * kb = (const gmp_sweep_key *) b;
+  if(ka->color != kb->color)
+    return ka->color - kb->color;
+  if(ka->type != kb->type)
+    return ka->type - kb->type;
+  if(ka->size != kb->size)
+    return ka->size - kb->size;
+  return ka->row - kb->row;
+}
+
+/* Order of the colored sweep. Two sub-problems coupled by a block of M
+ * (or of its transpose) have different colors (greedy coloring in the
+ * order of the rows), so that the sub-problems of a color may be
+ * solved in any order, or concurrently. Inside a color, the
+ * sub-problems are grouped by type and size.
+ * order receives the numbers of the sub-problems in the order of the
+ * sweep, the sub-problems of the color c being
+ * order[colorStart[c]:colorStart[c+1]].
+ * Returns the number of colors. */
+static int gmp_colored_sweep_order(GenericMechanicalProblem* pGMP, int * order, int * colorStart)
+{
+  SparseBlockStructuredMatrix * m = pGMP->M->matrix1;
+  int n = pGMP->numberOfSubProblems;
+  int nbRows = (int)m->filled1 - 1;
+  if(nbRows > n)
+    nbRows = n;
+
+  /* symmetric graph of the coupling blocks */
+  int * adjStart = (int *) calloc(n + 1, sizeof(int));
+  for(int row = 0; row < nbRows; row++)
+    for(size_t blockNum = m->index1_data[row]; blockNum < m->index1_data[row + 1]; blockNum++)
+    {
+      int col = (int)m->index2_data[blockNum];
+      if(col != row && col < n)
+      {
+        adjStart[row + 1]++;
+        adjStart[col + 1]++;
+      }
+    }
+  for(int i = 0; i < n; i++)
+    adjStart[i + 1] += adjStart[i];
+  int * adj = (int *) malloc(adjStart[n] * sizeof(int));
+  int * next = (int *) malloc(n * sizeof(int));
+  memcpy(next, adjStart, n * sizeof(int));
+  for(int row = 0; row < nbRows; row++)
+    for(size_t blockNum = m->index1_data[row]; blockNum < m->index1_data[row + 1]; blockNum++)
+    {
+      int col = (int)m->index2_data[blockNum];
+      if(col != row && col < n)
+      {
+        adj[next[row]++] = col;
+        adj[next[col]++] = row;
+      }
+    }
+
+  /* greedy coloring, forbidden[c] == i if the color c is taken by a
+   * neighbour of i */
+  int * color = next;
+  int * forbidden = (int *) malloc(n * sizeof(int));
+  for(int i = 0; i < n; i++)
+  {
+    color[i] = -1;
+    forbidden[i] = -1;
+  }
+  int nbColors = 0;
+  for(int i = 0; i < n; i++)
+  {
+    for(int k = adjStart[i]; k < adjStart[i + 1]; k++)
+      if(color[adj[k]] >= 0)
+        forbidden[color[adj[k]]] = i;
+    int c = 0;
+    while(forbidden[c] == i)
+      c++;
+    color[i] = c;
+    if(c + 1 > nbColors)
+      nbColors = c + 1;
+  }
+
+  gmp_sweep_key * keys = (gmp_sweep_key *) malloc(n * sizeof(gmp_sweep_key));
+  for(int i = 0; i < n; i++)
+  {
+    keys[i].color = color[i];
+    keys[i].type = pGMP->subProblems[i].type;
+    keys[i].size = pGMP->subProblems[i].size;
+    keys[i].row = i;
+  }
+  qsort(keys, n, sizeof(gmp_sweep_key), gmp_sweep_key_compare);
+  for(int c = 0; c <= nbColors; c++)
+    colorStart[c] = 0;
+  for(int i = 0; i < n; i++)
+  {
+    order[i] = keys[i].row;
+    colorStart[keys[i].color + 1]++;
+  }
+  for(int c = 0; c < nbColors; c++)
+    colorStart[c + 1] += colorStart[c];
+
+  free(keys);
+  free(forbidden);
+  free(next);
+  free(adj);
+  free(adjStart);
+  return nbColors;
+}
+
 //#define GMP_WRITE_PRB
 //static double sCoefLS=1.0;
 void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double * velocity, int * info,
@@ -249,21 +502,15 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
 #ifdef GENERICMECHANICAL_DEBUG_CMP
   SScmp++;
 #endif
-  listNumericsProblem * curProblem = 0;
   NM_types storageType = pGMP->M->storageType;
   NumericsMatrix* numMat = pGMP->M;
   int iterMax = options->iparam[SICONOS_IPARAM_MAX_ITER];
   int it = 0;
-  int currentRowNumber = 0;
-  //  int diagBlockNumber =0;
   double tol = options->dparam[SICONOS_DPARAM_TOL];
   double * err = &(options->dparam[SICONOS_DPARAM_RESIDU]);
   double * errLS = &(options->dparam[SICONOS_DPARAM_GMP_ERROR_LS]);
   int tolViolate = 1;
   int tolViolateLS = 1;
-  double * sol = 0;
-  double * w = 0;
-  int resLocalSolver = 0;
   int local_solver_error_occurred = 0;
   //numerics_printf("gmp_gauss_seidel \n");
   //genericMechanicalProblem_display(pGMP);
@@ -271,7 +518,73 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
   double * pBuffVelocity = NULL;
   int withLS = options->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_WITH_LINESEARCH];
   double * pCoefLS = &(options->dparam[SICONOS_DPARAM_GMP_COEFF_LS]);
-  double * bufForLocalProblemDense = (storageType == NM_DENSE) ? (double*) malloc(pGMP->maxLocalSize * pGMP->maxLocalSize * sizeof(double)) : 0;
+  int nbSubProblems = pGMP->numberOfSubProblems;
+  gmp_subproblem * subProblems = pGMP->subProblems;
+
+  /* The diagonal blocks are extracted once: pointers in the SBM, or
+   * copies stored contiguously for the other storages. */
+  double ** diagBlocks = (double **) malloc(nbSubProblems * sizeof(double *));
+  double * diagBuffer = NULL;
+  if(storageType == NM_SPARSE_BLOCK)
+  {
+    for(int k = 0; k < nbSubProblems; k++)
+      NM_extract_diag_block(numMat, subProblems[k].row, subProblems[k].pos, subProblems[k].size, &diagBlocks[k]);
+  }
+  else
+  {
+    size_t bufferSize = 0;
+    for(int k = 0; k < nbSubProblems; k++)
+      bufferSize += (size_t)subProblems[k].size * subProblems[k].size;
+    diagBuffer = (double *) malloc(bufferSize * sizeof(double));
+    bufferSize = 0;
+    for(int k = 0; k < nbSubProblems; k++)
+    {
+      diagBlocks[k] = diagBuffer + bufferSize;
+      NM_extract_diag_block(numMat, subProblems[k].row, subProblems[k].pos, subProblems[k].size, &diagBlocks[k]);
+      bufferSize += (size_t)subProblems[k].size * subProblems[k].size;
+    }
+  }
+
+  /* order of the sweep */
+  int * order = (int *) malloc(nbSubProblems * sizeof(int));
+  int * colorStart = (int *) malloc((nbSubProblems + 1) * sizeof(int));
+  int nbColors = 0;
+  if(options->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_SWEEP] == SICONOS_GENERIC_MECHANICAL_SWEEP_COLORED)
+  {
+    if(storageType == NM_SPARSE_BLOCK)
+    {
+      nbColors = gmp_colored_sweep_order(pGMP, order, colorStart);
+      options->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_NUMBER_OF_COLORS] = nbColors;
+      numerics_printf_verbose(1, "gmp_gauss_seidel: colored sweep of %d sub-problems with %d colors", nbSubProblems, nbColors);
+    }
+    else
+      numerics_warning("gmp_gauss_seidel", "the colored sweep needs a sparse block matrix, the sub-problems are swept in order.");
+  }
+  if(!nbColors)
+  {
+    /* one sequential sweep */
+    for(int k = 0; k < nbSubProblems; k++)
+      order[k] = k;
+    colorStart[0] = 0;
+    colorStart[1] = nbSubProblems;
+  }
+
+  /* the sub-problems of a color are solved concurrently, with a copy
+   * of the options of the local solvers per thread */
+  int nbThreads = 1;
+#ifdef _OPENMP
+  if(nbColors)
+    nbThreads = omp_get_max_threads();
+#endif
+  int nbInternalSolvers = (int)options->numberOfInternalSolvers;
+  SolverOptions ** threadSolvers = (SolverOptions **) malloc(nbThreads * nbInternalSolvers * sizeof(SolverOptions *));
+  for(int k = 0; k < nbInternalSolvers; k++)
+    threadSolvers[k] = options->internalSolvers[k];
+  for(int t = 1; t < nbThreads; t++)
+    for(int k = 0; k < nbInternalSolvers; k++)
+      threadSolvers[t * nbInternalSolvers + k] = solver_options_copy(options->internalSolvers[k]);
+  if(!nbColors)
+    nbColors = 1;
 
   if(options->dWork)
   {
@@ -288,10 +601,6 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
     SScmpTotal++;
 #endif
     memcpy(pPrevReaction, reaction, pGMP->size * sizeof(double));
-    currentRowNumber = 0;
-    curProblem =  pGMP->firstListElem;
-    int  posInX = 0;
-    size_t curSize = 0;
 
     DEBUG_PRINTF("GS it %d, initial value:\n", it);
     DEBUG_EXPR(
@@ -299,152 +608,28 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
       numerics_printf("R[%i]=%e | V[%i]=%e ", ii, reaction[ii], ii, velocity[ii]);
     );
 
-    while(curProblem)
+    for(int c = 0; c < nbColors; c++)
     {
-      numerics_printf_verbose(1,"Gauss-Seidel iteration %d. Problem (row) number %d ", it, currentRowNumber);
-      //if (currentRowNumber){
-      //  posInX = m->blocksize0[currentRowNumber-1];
-      //}
-      //curSize=m->blocksize0[currentRowNumber] - posInX;
-      curSize = curProblem->size;
-      curProblem->error = 0;
-      /*about the diagonal block:*/
-      //diagBlockNumber = NM_extract_diag_blockPos(m,currentRowNumber);
-      //diagBlockNumber = NM_extract_diag_blockPos(numMat,currentRowNumber,posInX,size);
-      double * diagBlock = 0;
-      if(storageType == NM_DENSE)  /*dense*/
-      {
-        NM_extract_diag_block(numMat, currentRowNumber, posInX, curSize, &bufForLocalProblemDense);
-        diagBlock = bufForLocalProblemDense;
-      }
-      else
-      {
-        NM_extract_diag_block(numMat, currentRowNumber, posInX, curSize, &diagBlock);
-
-      }
-
-      sol = reaction + posInX;
-      w = velocity + posInX;
-
-      switch(curProblem->type)
-      {
-      case SICONOS_NUMERICS_PROBLEM_EQUALITY:
-      {
-        numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_EQUALITY");
-        NumericsMatrix M;
-        NM_fill(&M, NM_DENSE, curSize, curSize, diagBlock);
-
-        memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
-        NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, curProblem->q, NULL, 0);
-        for(size_t i = 0; i < curSize; ++i) sol[i] = -curProblem->q[i];
-
-        // resLocalSolver = NM_gesv(&M, sol, true);
-        resLocalSolver = NM_LU_solve(NM_preserve(&M), sol, 1);
-
-        M.matrix0 = NULL;
-        NM_clear(&M);
-        break;
-      }
-      case SICONOS_NUMERICS_PROBLEM_LCP:
-      {
-        numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_LCP");
-        /*Mz*/
-        LinearComplementarityProblem* lcpProblem = (LinearComplementarityProblem*) curProblem->problem;
-        lcpProblem->M->matrix0 = diagBlock;
-        /*about q.*/
-        memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
-        NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, lcpProblem->q, NULL, 0);
-        resLocalSolver = linearComplementarity_driver(lcpProblem, sol, w, options->internalSolvers[0]);
-        break;
-      }
-      case SICONOS_NUMERICS_PROBLEM_RELAY:
-      {
-        numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_RELAY");
-        /*Mz*/
-        RelayProblem* relayProblem = (RelayProblem*) curProblem->problem;
-        relayProblem->M->matrix0 = diagBlock;
-        /*about q.*/
-        memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
-        NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, relayProblem->q, NULL, 0);
-        resLocalSolver = relay_driver(relayProblem, sol, w, options->internalSolvers[2]);
-        break;
-      }
-      case SICONOS_NUMERICS_PROBLEM_FC3D:
-      {
-        numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_FC3D");
-        FrictionContactProblem * fcProblem = (FrictionContactProblem *)curProblem->problem;
-        assert(fcProblem);
-        assert(fcProblem->M);
-        assert(fcProblem->q);
-        fcProblem->M->matrix0 = diagBlock;
-        memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
-
-        DEBUG_EXPR_WE(
-          NV_display(curProblem->q,3);
-          for(int i =0 ; i < 3; i++)
-            numerics_printf("curProblem->q[%i]= %12.8e,\t fcProblem->q[%i]= %12.8e,\n",i,curProblem->q[i],i,fcProblem->q[i]);
-          );
-
-        NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, fcProblem->q, NULL, 0);
-
-        DEBUG_EXPR_WE(
-          for(int i =0 ; i < 3; i++)
-            numerics_printf("reaction[%i]= %12.8e,\t fcProblem->q[%i]= %12.8e,\n",
-                            i,reaction[i],i,fcProblem->q[i]);
-          );
-
-        /* We call the generic driver (rather than the specific) since we may choose between various local solvers */
-        resLocalSolver = fc3d_driver(fcProblem, sol, w, options->internalSolvers[1]);
-        //resLocalSolver=fc3d_unitary_enumerative_solve(fcProblem,sol,&options->internalSolvers[1]);
-        break;
-      }
-      case SICONOS_NUMERICS_PROBLEM_FC2D:
-      {
-        numerics_printf_verbose(1, "solve SICONOS_NUMERICS_PROBLEM_FC2D");
-        FrictionContactProblem * fcProblem = (FrictionContactProblem *)curProblem->problem;
-        assert(fcProblem);
-        assert(fcProblem->M);
-        assert(fcProblem->q);
-        fcProblem->M->matrix0 = diagBlock;
-        memcpy(curProblem->q, &(pGMP->q[posInX]), curSize * sizeof(double));
-
-        DEBUG_EXPR_WE(
-          NV_display(curProblem->q,2);
-          for(int i =0 ; i < 2; i++)
-            numerics_printf("curProblem->q[%i]= %12.8e,\t fcProblem->q[%i]= %12.8e,\n",i,curProblem->q[i],i,fcProblem->q[i]);
-          );
-
-        NM_row_prod_no_diag(pGMP->size, curSize, currentRowNumber, posInX, numMat, reaction, fcProblem->q, NULL, 0);
-
-        DEBUG_EXPR_WE(
-          for(int i =0 ; i < 2; i++)
-            numerics_printf("reaction[%i]= %12.8e,\t fcProblem->q[%i]= %12.8e,\n",i,reaction[i],i,fcProblem->q[i]);
-          );
-
-        /* We call the generic driver (rather than the specific) since we may choose between various local solvers */
-        resLocalSolver = fc2d_driver(fcProblem, sol, w, options->internalSolvers[3]);
-        //resLocalSolver=fc3d_unitary_enumerative_solve(fcProblem,sol,&options->internalSolvers[1]);
-        break;
-      }
-      default:
-        numerics_printf("genericMechanical_GS Numerics : gmp_gauss_seidel unknown problem type %d.\n", curProblem->type);
-      }
-      if(resLocalSolver)
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic, 8) if(nbThreads > 1) reduction(|:local_solver_error_occurred)
+#endif
+      for(int k = colorStart[c]; k < colorStart[c + 1]; k++)
       {
-        curProblem->error = 1;
-        local_solver_error_occurred = 1;
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        int numProblem = order[k];
+        gmp_subproblem * sub = &subProblems[numProblem];
+        numerics_printf_verbose(1,"Gauss-Seidel iteration %d. Problem (row) number %d ", it, sub->row);
+        sub->elem->error = 0;
+        if(gmp_solve_subproblem(pGMP, sub, diagBlocks[numProblem], reaction, velocity,
+                                threadSolvers + thread * nbInternalSolvers))
+        {
+          sub->elem->error = 1;
+          local_solver_error_occurred = 1;
+        }
       }
-
-
-      /* DEBUG_EXPR(for (int ii = 0; ii < pGMP->size; ii++) */
-      /*              printf("R[%d]=%e | V[]=%e \n", ii, reaction[ii], velocity[ii]); */
-      /*            if (resLocalSolver) */
-      /*              printf("Numerics:GenericMechanical_drivers Local solver failed\n"); */
-      /*   ); */
-      posInX += curProblem->size;
-      curProblem = curProblem->nextProblem;
-      currentRowNumber++;
-
     }
     /*compute global error.*/
 
@@ -509,8 +694,6 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
     fclose(toto);
 #endif
 
-    //    if (storageType==NM_DENSE)
-    //      free(bufForLocalProblemDense);
     //    exit(0);
   }
   else
@@ -523,15 +706,11 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
 
   if(local_solver_error_occurred)
   {
-    currentRowNumber = 0;
-    curProblem =  pGMP->firstListElem;
-    while(curProblem)
+    for(int k = 0; k < nbSubProblems; k++)
     {
-      if(curProblem->error && verbose)
+      if(subProblems[k].elem->error && verbose)
         numerics_printf("genericMechanical_GS Numerics : Local solver FAILED row %d of type %s\n",
-                        currentRowNumber, ns_problem_id_to_name(curProblem->type));
-      curProblem = curProblem->nextProblem;
-      currentRowNumber++;
+                        subProblems[k].row, ns_problem_id_to_name(subProblems[k].type));
     }
   }
 
@@ -539,8 +718,14 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
   if(! options->dWork)
     free(pPrevReaction);
   *info = tolViolate;
-  if(storageType == NM_DENSE)
-    free(bufForLocalProblemDense);
+  for(int t = 1; t < nbThreads; t++)
+    for(int k = 0; k < nbInternalSolvers; k++)
+      gmp_thread_solver_free(threadSolvers[t * nbInternalSolvers + k]);
+  free(threadSolvers);
+  free(order);
+  free(colorStart);
+  free(diagBlocks);
+  free(diagBuffer);
   DEBUG_END("gmp_gauss_seidel(...)\n");
 }
 
@@ -584,6 +769,11 @@ int gmp_driver(GenericMechanicalProblem* problem, double *reaction, double *velo
       numerics_printf("gmp_driver : call of mlcp\n");
       gmp_as_mlcp(problem, reaction, velocity, &info, options);
     }
+    else if(options->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_ISREDUCED] == SICONOS_GENERIC_MECHANICAL_SUBS_EQUALITIES_SPARSE)
+    {
+      numerics_printf("gmp_driver : call of gmp_reduced_sparse_solve\n");
+      gmp_reduced_sparse_solve(problem, reaction, velocity, &info, options);
+    }
     else
     {
       numerics_printf("gmp_driver error, options->iparam[SICONOS_GENERIC_MECHANICAL_IPARAM_ISREDUCED] wrong value.\n");
@@ -168,6 +168,13 @@ extern "C"
    * 1 : iter = itermax
    * 2 : negative diagonal term
    *  \param[in,out] options structure used to define the solver and its parameters.
+   *
+   *  Problems of size at least iparam[SICONOS_LCP_IPARAM_LEMKE_LUMOD_SIZE] are
+   *  solved with the LU updates of lcp_pivot_lumod, and with the tableau if
+   *  this fails (0, the default, for the tableau only). With
+   *  iparam[SICONOS_LCP_IPARAM_PIVOT_WARM_START] (the default), the
+   *  complementary basis of the solution is kept in options->iWork and tried
+   *  first at the next call.
    */
   void lcp_lexicolemke(LinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options);
 
@@ -292,6 +299,25 @@ extern "C"
    */
   void lcp_pivot(LinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options);
   void lcp_pivot_covering_vector(LinearComplementarityProblem* problem, double* u , double* s, int *info , SolverOptions* options, double* cov_vec);
+
+  /** lcp_pivot_lumod is the Lemke method of lcp_pivot where the basis is kept
+   *  as a LU factorization updated at each pivot with lumod, instead of a
+   *  tableau. The basis is refactorized every
+   *  iparam[SICONOS_LCP_IPARAM_PIVOT_MAXMOD] updates, and the solution is
+   *  computed again from the final basis. When
+   *  iparam[SICONOS_LCP_IPARAM_PIVOT_WARM_START] is set, the complementary
+   *  basis of the solution is kept in options->iWork and tried first at the
+   *  next call on a problem of the same size: if it is still feasible, the
+   *  solution is obtained with a single factorization.
+   *
+   *  \param[in] problem structure that represents the LCP (M, q...)
+   *  \param[in,out] z a n-vector of doubles which contains the initial solution and returns the solution of the problem.
+   *  \param[in,out] w a n-vector of doubles which returns the solution of the problem.
+   *  \param[out] info an integer which returns the termination value:
+   * 0 : convergence
+   * 1 : iter = itermax
+   *  \param[in,out] options structure used to define the solver and its parameters.
+   */
   void lcp_pivot_lumod(LinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options);
   void lcp_pivot_lumod_covering_vector(LinearComplementarityProblem* problem, double* u , double* s, int *info , SolverOptions* options, double* cov_vec);
 
@@ -73,6 +73,12 @@ enum SICONOS_LCP_IPARAM
    SICONOS_LCP_IPARAM_ENUM_USE_DGELS =10,
    /** index in iparam to store to activate multiple solutions search */
    SICONOS_LCP_IPARAM_ENUM_MULTIPLE_SOLUTIONS =11,
+   /** index in iparam to store the number of LU updates before a refactorization of the basis (pivot with lumod) */
+   SICONOS_LCP_IPARAM_PIVOT_MAXMOD =12,
+   /** index in iparam to activate the warm start from the basis of the previous call (pivot with lumod) */
+   SICONOS_LCP_IPARAM_PIVOT_WARM_START =13,
+   /** index in iparam to store the size from which lexicolemke uses LU updates instead of the tableau, 0 for never */
+   SICONOS_LCP_IPARAM_LEMKE_LUMOD_SIZE =14,
   };
 
 enum SICONOS_LCP_DPARAM
@@ -82,6 +82,28 @@ void lcp_lexicolemke(LinearComplementarityProblem* problem, double *zlem, double
     return ;
   }
 
+  /* LU updates of the basis instead of the tableau (with their own warm start) */
+  int lumod_size = options->iparam[SICONOS_LCP_IPARAM_LEMKE_LUMOD_SIZE];
+  if(lumod_size > 0 && dim >= lumod_size)
+  {
+    lcp_pivot_lumod(problem, zlem, wlem, info, options);
+    if(*info == 0)
+    {
+      numerics_printf_verbose(1, "lcp_lexicolemke: solved with LU updates after %i pivots", options->iparam[SICONOS_IPARAM_ITER_DONE]);
+      return;
+    }
+    numerics_printf_verbose(1, "lcp_lexicolemke: LU updates failed, back to the tableau");
+  }
+
+  int warm_start = options->iparam[SICONOS_LCP_IPARAM_PIVOT_WARM_START];
+  if(warm_start && lcp_pivot_warm_start(problem, zlem, wlem, options))
+  {
+    numerics_printf_verbose(1, "lcp_lexicolemke: the basis of the previous call is still feasible");
+    *info = 0;
+    options->iparam[SICONOS_IPARAM_ITER_DONE] = 0;
+    return;
+  }
+
   double z0, zb, delta_lexico;
   double pivot, tovip, ratio;
   double tmp;
@@ -535,6 +557,9 @@ DEBUG_EXPR_WE(DEBUG_PRINT("new basis: ");
   if(Ifound) *info = 0;
   else *info = 1;
 
+  if(Ifound && warm_start)
+    lcp_pivot_keep_basis(dim, zlem, options);
+
   free(basis);
 
   for(i = 0 ; i < dim ; ++i) free(A[i]);
@@ -546,6 +571,9 @@ DEBUG_EXPR_WE(DEBUG_PRINT("new basis: ");
 void lcp_lexicolemke_set_default(SolverOptions* options)
 {
   options->iparam[SICONOS_LCP_IPARAM_PIVOTING_METHOD_TYPE] = 0;
+  options->iparam[SICONOS_LCP_IPARAM_PIVOT_MAXMOD] = 50;
+  options->iparam[SICONOS_LCP_IPARAM_PIVOT_WARM_START] = 1;
+  options->iparam[SICONOS_LCP_IPARAM_LEMKE_LUMOD_SIZE] = 0;
   options->dparam[2] = 0.0 ;
   options->dparam[3] = 0.0 ;
 }
@@ -107,6 +107,15 @@ void lcp_pivot_lumod_covering_vector(LinearComplementarityProblem* problem, doub
     printf("\n");
   });
 
+  unsigned warm_start = options->iparam[SICONOS_LCP_IPARAM_PIVOT_WARM_START] && !cov_vec;
+  if(warm_start && lcp_pivot_warm_start(problem, u, s, options))
+  {
+    DEBUG_PRINT("lcp_pivot_lumod :: the basis of the previous call is still feasible\n");
+    options->iparam[SICONOS_IPARAM_ITER_DONE] = 0;
+    *info = 0;
+    return;
+  }
+
   unsigned drive = dim+1;
   int bck_drive = -1;
   int block = -1;
@@ -114,7 +123,6 @@ void lcp_pivot_lumod_covering_vector(LinearComplementarityProblem* problem, doub
   unsigned nb_iter = 0;
   unsigned leaving = 0;
   unsigned itermax = options->iparam[SICONOS_IPARAM_MAX_ITER];
-  unsigned preAlloc = options->iparam[SICONOS_IPARAM_PREALLOC];
   unsigned pivot_selection_rule = options->iparam[SICONOS_LCP_IPARAM_PIVOTING_METHOD_TYPE];
 
   assert(itermax > 0 && "lcp_pivot_lumod_covering_vector itermax == 0, the algorithm will not run");
@@ -151,9 +159,8 @@ void lcp_pivot_lumod_covering_vector(LinearComplementarityProblem* problem, doub
   for(unsigned i = 0; i < dim*dim; i += dim+1) lexico_mat[i] = 1.;
   DEBUG_PRINT_MAT_ROW_MAJOR_NCOLS_SMALL_STR("lexico_mat", lexico_mat, dim, dim, dim);
 
-  /* Maximum number of columns changed in the matrix */
-  /* TODO: user settable and should not be bigger than the size of the matrix? */
-  unsigned maxmod = 50;
+  /* Maximum number of columns changed in the matrix before a refactorization */
+  unsigned maxmod = options->iparam[SICONOS_LCP_IPARAM_PIVOT_MAXMOD] > 0 ? options->iparam[SICONOS_LCP_IPARAM_PIVOT_MAXMOD] : 50;
 
   *info = 0;
 
@@ -621,13 +628,28 @@ exit_lcp_pivot:
   {
     DEBUG_PRINT("No solution found !\n");
   }
-
-  if(!preAlloc)
+  else
   {
-    free(basis);
-    free(mat);
-    SM_lumod_dense_free(lumod_data);
+    if(has_sol)
+    {
+      /* the basic variables were updated at each pivot and carry the
+       * round-off errors of the LU updates: compute them again from a
+       * factorization of the final basis */
+      int* active = (int*)calloc(dim, sizeof(int));
+      double tol = sqrt(DBL_EPSILON) * (1. + fabs(problem->q[cblas_idamax(dim, problem->q, 1)]));
+      for(unsigned i = 0; i < dim; ++i)
+      {
+        if(basis[i] > dim + 1) active[basis[i] - dim - 2] = 1;
+      }
+      pivot_complementary_basis_solve(dim, M, problem->q, active, u, s, tol);
+      free(active);
+    }
+    if(warm_start)
+      lcp_pivot_keep_basis(dim, u, options);
   }
+  free(basis);
+  free(mat);
+  SM_lumod_dense_free(lumod_data);
 
   /*  XXX Clean that --xhub */
   free(candidate_indx);
@@ -636,4 +658,6 @@ exit_lcp_pivot:
 void lcp_pivot_lumod_set_default(SolverOptions* options)
 {
   options->iparam[SICONOS_LCP_IPARAM_PIVOTING_METHOD_TYPE] = SICONOS_LCP_PIVOT_LEMKE;
+  options->iparam[SICONOS_LCP_IPARAM_PIVOT_MAXMOD] = 50;
+  options->iparam[SICONOS_LCP_IPARAM_PIVOT_WARM_START] = 0;
 }
@@ -31,6 +31,9 @@
 #include "sanitizer.h"           // for cblas_dcopy_msan
 #include "SiconosBlas.h"         // for cblas_daxpy, cblas_dscal
 #include "SiconosLapack.h"       // for DGETRS, lapack_int, DGETRF, LA_NOTRANS
+#include "LinearComplementarityProblem.h"  // for LinearComplementarityProblem
+#include "NumericsMatrix.h"      // for NumericsMatrix
+#include "SolverOptions.h"       // for SolverOptions
 
 #define TOL_LEXICO DBL_EPSILON*10000
 #define MIN_INCREASE 10
@@ -931,6 +934,77 @@ void do_pivot_lumod(SN_lumod_dense_data* restrict lumod_data, NumericsMatrix* re
   DEBUG_PRINT_MAT_ROW_MAJOR_NCOLS_SMALL2_STR("lexico_mat", lexico_mat, n, n, n, col_drive);
 }
 
+int pivot_complementary_basis_solve(unsigned n, double* restrict M, double* restrict q, int* restrict active, double* restrict z, double* restrict w, double tol)
+{
+  double* H = (double*)malloc(n * n * sizeof(double));
+  double* x = (double*)malloc(n * sizeof(double));
+  lapack_int* ipiv = (lapack_int*)malloc(n * sizeof(lapack_int));
+  lapack_int info = 0;
+
+  /* basis matrix with the same columns as SN_lumod_factorize: M[:, i] for
+   * z_i and -e_i for w_i, so that H x = -q */
+  for(unsigned i = 0; i < n; ++i)
+  {
+    if(active[i])
+      cblas_dcopy(n, &M[i * n], 1, &H[i * n], 1);
+    else
+    {
+      memset(&H[i * n], 0, n * sizeof(double));
+      H[i * n + i] = -1.;
+    }
+    x[i] = -q[i];
+  }
+
+  DGETRF(n, n, H, n, ipiv, &info);
+  if(info == 0)
+    DGETRS(LA_NOTRANS, n, 1, H, n, ipiv, x, n, &info);
+
+  int feasible = (info == 0);
+  for(unsigned i = 0; feasible && i < n; ++i)
+  {
+    if(!(x[i] >= -tol)) feasible = 0;
+  }
+
+  if(feasible)
+  {
+    for(unsigned i = 0; i < n; ++i)
+    {
+      double xi = x[i] > 0. ? x[i] : 0.;
+      z[i] = active[i] ? xi : 0.;
+      w[i] = active[i] ? 0. : xi;
+    }
+  }
+
+  free(H);
+  free(x);
+  free(ipiv);
+  return feasible;
+}
+
+int lcp_pivot_warm_start(LinearComplementarityProblem* problem, double* restrict z, double* restrict w, SolverOptions* options)
+{
+  unsigned n = problem->size;
+  if(!options->iWork || options->iWorkSize != n)
+    return 0;
+  return pivot_complementary_basis_solve(n, problem->M->matrix0, problem->q, options->iWork, z, w, 0.);
+}
+
+void lcp_pivot_keep_basis(unsigned n, double* z, SolverOptions* options)
+{
+  if(options->iWork && options->iWorkSize != n)
+  {
+    free(options->iWork);
+    options->iWork = NULL;
+  }
+  if(!options->iWork)
+  {
+    options->iWork = (int*)malloc(n * sizeof(int));
+    options->iWorkSize = n;
+  }
+  for(unsigned i = 0; i < n; ++i)
+    options->iWork[i] = z[i] > 0. ? 1 : 0;
+}
+
 void lcp_pivot_diagnose_info(int info)
 {
   switch(info)
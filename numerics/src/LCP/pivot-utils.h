@@ -24,7 +24,7 @@
 #ifndef PIVOT_UTILS_H
 #define PIVOT_UTILS_H
 
-#include "NumericsFwd.h"    // for NumericsMatrix
+#include "NumericsFwd.h"    // for NumericsMatrix, SolverOptions, LinearCo...
 #include "lumod_wrapper.h"  // for SN_lumod_dense_data
 #include "SiconosConfig.h" // for BUILD_AS_CPP // IWYU pragma: keep
 
@@ -171,6 +171,38 @@ void do_pivot_lumod(SN_lumod_dense_data* lumod_data, NumericsMatrix* M, double*
   void init_M_least_index(double* restrict mat, double* restrict M, unsigned int dim, double* restrict q);
   int init_M_lemke_warm_start(int n, double* restrict u, double* restrict mat, double* restrict M, double* restrict q, int* restrict basis, double* restrict cov_vec);
 
+  /** solve the LCP on a complementary basis: z_i is basic if active[i] is
+   * not 0, w_i otherwise
+   * \param n the dimension of the problem
+   * \param M the matrix of the LCP (dense, column major)
+   * \param q the vector of the LCP
+   * \param active the basic variables
+   * \param[out] z solution, set only if the basis is feasible
+   * \param[out] w solution, set only if the basis is feasible
+   * \param tol basic variables greater than -tol are accepted and set to 0
+   * if negative
+   * \return 1 if the basis is feasible, 0 otherwise
+   */
+  int pivot_complementary_basis_solve(unsigned n, double* restrict M, double* restrict q, int* restrict active, double* restrict z, double* restrict w, double tol);
+
+  /** try the complementary basis kept in options->iWork by a previous call
+   * to lcp_pivot_keep_basis on a problem of the same size
+   * \param problem the LCP
+   * \param[out] z solution, set only if the basis is feasible
+   * \param[out] w solution, set only if the basis is feasible
+   * \param options the options of the solver
+   * \return 1 if the basis is still feasible, 0 otherwise
+   */
+  int lcp_pivot_warm_start(LinearComplementarityProblem* problem, double* restrict z, double* restrict w, SolverOptions* options);
+
+  /** keep in options->iWork the complementary basis of a solution, for the
+   * warm start of the next call
+   * \param n the dimension of the problem
+   * \param z the solution
+   * \param options the options of the solver
+   */
+  void lcp_pivot_keep_basis(unsigned n, double* z, SolverOptions* options);
+
   const char* basis_to_name(unsigned nb, unsigned n);
   unsigned basis_to_number(unsigned nb, unsigned n);
 
@@ -0,0 +1,147 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Compare the tableau of lcp_lexicolemke with the LU updates of
+ * lcp_pivot_lumod on the LCP collection and on contact-like problems
+ * M = A A^T + I of increasing size, then check the warm start on a
+ * perturbed q. The test fails if lcp_lexicolemke with LU updates (and
+ * the tableau as fallback) does not solve a problem solved by the tableau,
+ * or if the warm start needs a pivot. */
+
+#include <stdio.h>                         // for printf
+#include <stdlib.h>                        // for malloc, free, rand
+#include <time.h>                          // for clock
+#include "LCP_Solvers.h"                   // for lcp_lexicolemke, lcp_pivot...
+#include "LinearComplementarityProblem.h"  // for LinearComplementarityProblem
+#include "NumericsMatrix.h"                // for NM_create_from_data
+#include "SolverOptions.h"                 // for SolverOptions, solver_opti...
+#include "lcp_cst.h"                       // for SICONOS_LCP_LEMKE, SICONOS...
+
+typedef struct
+{
+  int info;
+  int pivots;
+  double time;
+} run_result;
+
+static run_result run(LinearComplementarityProblem* problem, SolverOptions* options,
+                      void (*solver)(LinearComplementarityProblem*, double*, double*, int*, SolverOptions*))
+{
+  run_result res;
+  double* z = (double*)calloc(problem->size, sizeof(double));
+  double* w = (double*)calloc(problem->size, sizeof(double));
+  double error = 0.;
+  clock_t t = clock();
+  solver(problem, z, w, &res.info, options);
+  res.time = (double)(clock() - t) / CLOCKS_PER_SEC;
+  res.pivots = options->iparam[SICONOS_IPARAM_ITER_DONE];
+  if(res.info == 0)
+    res.info = lcp_compute_error(problem, z, w, 1e-8, &error);
+  free(z);
+  free(w);
+  return res;
+}
+
+static int compare(const char* name, LinearComplementarityProblem* problem)
+{
+  SolverOptions* tableau = solver_options_create(SICONOS_LCP_LEMKE);
+  SolverOptions* lumod = solver_options_create(SICONOS_LCP_PIVOT_LUMOD);
+  SolverOptions* lemke = solver_options_create(SICONOS_LCP_LEMKE);
+  lemke->iparam[SICONOS_LCP_IPARAM_LEMKE_LUMOD_SIZE] = 1;
+
+  run_result r0 = run(problem, tableau, lcp_lexicolemke);
+  run_result r1 = run(problem, lumod, lcp_pivot_lumod);
+  run_result r2 = run(problem, lemke, lcp_lexicolemke);
+  printf("%-40s %5d | %2d %6d %9.2e | %2d %6d %9.2e | %2d\n", name, problem->size,
+         r0.info, r0.pivots, r0.time, r1.info, r1.pivots, r1.time, r2.info);
+
+  solver_options_delete(tableau);
+  solver_options_delete(lumod);
+  solver_options_delete(lemke);
+  return (r0.info == 0 && r2.info != 0);
+}
+
+static LinearComplementarityProblem* contact_problem(int n)
+{
+  double* A = (double*)malloc(n * n * sizeof(double));
+  double* M = (double*)calloc(n * n, sizeof(double));
+  double* q = (double*)malloc(n * sizeof(double));
+  for(int i = 0; i < n * n; ++i)
+    A[i] = 2. * rand() / RAND_MAX - 1.;
+  for(int i = 0; i < n; ++i)
+  {
+    for(int j = 0; j < n; ++j)
+      for(int k = 0; k < n; ++k)
+        M[i + j * n] += A[i + k * n] * A[j + k * n];
+    M[i + i * n] += 1.;
+    q[i] = 2. * rand() / RAND_MAX - 1.;
+  }
+  free(A);
+  LinearComplementarityProblem* problem = newLCP();
+  problem->size = n;
+  problem->M = NM_create_from_data(NM_DENSE, n, n, M);
+  problem->q = q;
+  return problem;
+}
+
+int main(void)
+{
+  const char* data[] =
+  {
+    "./data/lcp_CPS_1.dat", "./data/lcp_CPS_2.dat", "./data/lcp_CPS_3.dat",
+    "./data/lcp_CPS_4.dat", "./data/lcp_CPS_4bis.dat", "./data/lcp_CPS_5.dat",
+    "./data/lcp_Pang_isolated_sol.dat", "./data/lcp_Pang_isolated_sol_perturbed.dat",
+    "./data/lcp_deudeu.dat", "./data/lcp_enum_fails.dat", "./data/lcp_exp_murty.dat",
+    "./data/lcp_exp_murty2.dat", "./data/lcp_inf_sol_perturbed.dat", "./data/lcp_mmc.dat",
+    "./data/lcp_ortiz.dat", "./data/lcp_tobenna.dat", "./data/lcp_trivial.dat"
+  };
+  int n_data = (int)(sizeof(data) / sizeof(data[0]));
+  int out = 0;
+
+  printf("%-40s %5s | %-19s | %-19s | %s\n", "problem", "n", "tableau info/piv/s", "lumod info/piv/s", "both");
+  for(int i = 0; i < n_data; ++i)
+  {
+    LinearComplementarityProblem* problem = newLCP();
+    linearComplementarity_newFromFilename(problem, data[i]);
+    out |= compare(data[i], problem);
+    freeLinearComplementarityProblem(problem);
+  }
+
+  srand(1);
+  int sizes[] = {100, 200, 400};
+  for(int i = 0; i < 3; ++i)
+  {
+    LinearComplementarityProblem* problem = contact_problem(sizes[i]);
+    out |= compare("contact", problem);
+
+    /* warm start: the same problem with a slightly different q */
+    SolverOptions* lumod = solver_options_create(SICONOS_LCP_PIVOT_LUMOD);
+    lumod->iparam[SICONOS_LCP_IPARAM_PIVOT_WARM_START] = 1;
+    run_result cold = run(problem, lumod, lcp_pivot_lumod);
+    for(int j = 0; j < problem->size; ++j)
+      problem->q[j] *= 1. + 1e-6;
+    run_result warm = run(problem, lumod, lcp_pivot_lumod);
+    printf("%-40s %5d | cold %6d %9.2e | warm %6d %9.2e\n", "contact, warm start", problem->size,
+           cold.pivots, cold.time, warm.pivots, warm.time);
+    if(warm.info || warm.pivots != 0)
+      out = 1;
+    solver_options_delete(lumod);
+    freeLinearComplementarityProblem(problem);
+  }
+  return out;
+}
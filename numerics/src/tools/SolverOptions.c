@@ -97,7 +97,7 @@ static SolverOptions* solver_options_initialize(int solver_id, int iter_max, dou
   //
   options->dWorkSize = 0;
   options->dWork = NULL;
-  options->dWorkSize = 0;
+  options->iWorkSize = 0;
   options->iWork = NULL;
   options->callback = NULL;
   options->numberOfInternalSolvers = number_of_internal_solvers;
@@ -248,11 +248,11 @@ SolverOptions * solver_options_copy(SolverOptions* source)
   // Create a new solver options, with default setup
   SolverOptions * options = solver_options_create(source->solverId);
 
-  for(size_t i=0; i < OPTIONS_PARAM_SIZE; ++i)
-  {
+  // iparam and dparam are allocated with iSize and dSize entries
+  for(int i=0; i < options->iSize && i < source->iSize; ++i)
     options->iparam[i] = source->iparam[i];
+  for(int i=0; i < options->dSize && i < source->dSize; ++i)
     options->dparam[i] = source->dparam[i];
-  }
 
   if(source->dWork)
   {
@@ -272,7 +272,12 @@ SolverOptions * solver_options_copy(SolverOptions* source)
   // this assert should be ensured by solver_options_create and initialize.
 
   for(size_t i=0; i<options->numberOfInternalSolvers; ++i)
+  {
+    // replace the default internal solvers set by solver_options_create
+    solver_options_delete(options->internalSolvers[i]);
+    free(options->internalSolvers[i]);
     options->internalSolvers[i] = solver_options_copy(source->internalSolvers[i]);
+  }
 
   // Warning pointer links!
   if(source->callback)
@@ -630,6 +635,7 @@ SolverOptions * solver_options_create(int solverId)
   {
     options = solver_options_initialize(solverId, 10000, 1e-12, 0);
     mlcp_direct_set_default(options);
+    options->iparam[SICONOS_LCP_IPARAM_PIVOT_WARM_START] = 1;
     break;
   }
 
@@ -719,6 +725,12 @@ SolverOptions * solver_options_create(int solverId)
     fc3d_nsgs_velocity_set_default(options);
     break;
   }
+  case SICONOS_FRICTION_3D_NSGS_ML:
+  {
+    options = solver_options_initialize(solverId, 1000, 1e-4, 2);
+    fc3d_nsgs_multilevel_set_default(options);
+    break;
+  }
   case SICONOS_FRICTION_3D_PROX:
   case SICONOS_GLOBAL_FRICTION_3D_PROX_WR:
   {
@@ -3163,6 +3163,105 @@ int SBM_from_csparse(int blocksize, const CSparseMatrix* const sparseMat, Sparse
 
 }
 
+int SBM_from_csparse_blocks(unsigned int blocknumber, const unsigned int* blocksize,
+                            const CSparseMatrix* const sparseMat, SparseBlockStructuredMatrix* A)
+{
+  DEBUG_PRINT("SBM_from_csparse_blocks start\n")
+  assert(sparseMat);
+  assert(sparseMat->nz == -1);
+  assert(blocknumber > 0);
+  assert(sparseMat->m == (CS_INT)blocksize[blocknumber - 1]);
+  assert(sparseMat->n == (CS_INT)blocksize[blocknumber - 1]);
+
+  CS_INT n = sparseMat->n;
+  CS_INT* Ap = sparseMat->p;
+  CS_INT* Ai = sparseMat->i;
+  double* Ax = sparseMat->x;
+
+  A->blocknumber0 = blocknumber;
+  A->blocknumber1 = blocknumber;
+  A->blocksize0 = (unsigned int*)malloc(blocknumber * sizeof(unsigned int));
+  A->blocksize1 = (unsigned int*)malloc(blocknumber * sizeof(unsigned int));
+  memcpy(A->blocksize0, blocksize, blocknumber * sizeof(unsigned int));
+  memcpy(A->blocksize1, blocksize, blocknumber * sizeof(unsigned int));
+  A->diagonal_blocks = NULL;
+  NDV_reset(&(A->version));
+
+  /* block row of each row */
+  unsigned int* rowblock = (unsigned int*)malloc(n * sizeof(unsigned int));
+  for(unsigned int b = 0, r = 0; b < blocknumber; b++)
+    for(; r < blocksize[b]; r++)
+      rowblock[r] = b;
+
+  /* marker[brow]: last block column with a block in brow, and its
+   * number in this block column */
+  int* marker = (int*)malloc(blocknumber * sizeof(int));
+  size_t* current = (size_t*)malloc(blocknumber * sizeof(size_t));
+  for(unsigned int b = 0; b < blocknumber; b++)
+    marker[b] = -1;
+
+  /* 1: count the non empty blocks of each block row */
+  A->filled1 = blocknumber + 1;
+  A->index1_data = (size_t*)calloc(A->filled1, sizeof(size_t));
+  for(unsigned int bcol = 0; bcol < blocknumber; bcol++)
+  {
+    CS_INT c0 = bcol ? blocksize[bcol - 1] : 0;
+    for(CS_INT col = c0; col < (CS_INT)blocksize[bcol]; col++)
+      for(CS_INT k = Ap[col]; k < Ap[col + 1]; k++)
+      {
+        unsigned int brow = rowblock[Ai[k]];
+        if(marker[brow] != (int)bcol)
+        {
+          marker[brow] = (int)bcol;
+          A->index1_data[brow + 1]++;
+        }
+      }
+  }
+  for(unsigned int b = 0; b < blocknumber; b++)
+  {
+    A->index1_data[b + 1] += A->index1_data[b];
+    marker[b] = -1;
+  }
+
+  A->nbblocks = A->index1_data[blocknumber];
+  A->filled2 = A->nbblocks;
+  A->index2_data = (size_t*)malloc(A->filled2 * sizeof(size_t));
+  A->block = (double**)malloc(A->nbblocks * sizeof(double*));
+
+  /* 2: fill the blocks, block columns are visited in increasing order
+   * so that they are sorted in each block row */
+  size_t* next = (size_t*)malloc(blocknumber * sizeof(size_t));
+  memcpy(next, A->index1_data, blocknumber * sizeof(size_t));
+  for(unsigned int bcol = 0; bcol < blocknumber; bcol++)
+  {
+    CS_INT c0 = bcol ? blocksize[bcol - 1] : 0;
+    for(CS_INT col = c0; col < (CS_INT)blocksize[bcol]; col++)
+      for(CS_INT k = Ap[col]; k < Ap[col + 1]; k++)
+      {
+        unsigned int brow = rowblock[Ai[k]];
+        unsigned int r0 = brow ? blocksize[brow - 1] : 0;
+        unsigned int nbRowInBlock = blocksize[brow] - r0;
+        if(marker[brow] != (int)bcol)
+        {
+          marker[brow] = (int)bcol;
+          current[brow] = next[brow]++;
+          A->index2_data[current[brow]] = bcol;
+          A->block[current[brow]] = (double*)calloc(nbRowInBlock * (blocksize[bcol] - c0),
+                                    sizeof(double));
+        }
+        A->block[current[brow]][(Ai[k] - r0) + (col - c0) * nbRowInBlock] = Ax[k];
+      }
+  }
+
+  free(next);
+  free(current);
+  free(marker);
+  free(rowblock);
+  DEBUG_PRINT("SBM_from_csparse_blocks end\n")
+
+  return 0;
+}
+
 int  SBM_to_sparse(const SparseBlockStructuredMatrix* const A, CSparseMatrix *outSparseMat)
 {
   DEBUG_BEGIN("SBM_to_sparse(...)\n");
@@ -3451,3 +3550,79 @@ void SBM_column_permutation(unsigned int *colIndex, SparseBlockStructuredMatrix*
   fclose(titi);
 #endif
 }
+
+void SBM_symmetric_permutation(unsigned int *perm, SparseBlockStructuredMatrix* A, SparseBlockStructuredMatrix*  C)
+{
+  assert(A->blocknumber0 == A->blocknumber1);
+  unsigned int nbRow = A->blocknumber0;
+
+  /* inverse permutation: the col numA of A is the col inv[numA] of C */
+  unsigned int * inv = (unsigned int*)malloc(nbRow * sizeof(unsigned int));
+  for(unsigned int rowC = 0; rowC < nbRow; rowC++)
+    inv[perm[rowC]] = rowC;
+
+  C->nbblocks = A->nbblocks;
+  C->block = (double**)malloc(A->nbblocks * sizeof(double*));
+  C->blocknumber0 = nbRow;
+  C->blocknumber1 = nbRow;
+  C->blocksize0 = (unsigned int*)malloc(nbRow * sizeof(unsigned int));
+  C->blocksize1 = (unsigned int*)malloc(nbRow * sizeof(unsigned int));
+  C->filled1 = nbRow + 1;
+  C->filled2 = A->nbblocks;
+  C->index1_data = (size_t*)malloc(C->filled1 * sizeof(size_t));
+  C->index2_data = (size_t*)malloc(C->filled2 * sizeof(size_t));
+  C->diagonal_blocks = NULL;
+  NDV_reset(&(C->version));
+
+  for(unsigned int rowC = 0; rowC < nbRow; rowC++)
+  {
+    unsigned int rowA = perm[rowC];
+    unsigned int nbRowInBlock = A->blocksize0[rowA];
+    if(rowA)
+      nbRowInBlock -= A->blocksize0[rowA - 1];
+    C->blocksize0[rowC] = rowC ? C->blocksize0[rowC - 1] + nbRowInBlock : nbRowInBlock;
+    C->blocksize1[rowC] = C->blocksize0[rowC];
+  }
+
+  /* position in A of each block of C, to sort the columns of a row */
+  size_t * blockInA = (size_t*)malloc(A->nbblocks * sizeof(size_t));
+  size_t curNbBlockC = 0;
+  C->index1_data[0] = 0;
+  for(unsigned int rowC = 0; rowC < nbRow; rowC++)
+  {
+    unsigned int rowA = perm[rowC];
+    size_t first = curNbBlockC;
+    if(rowA < A->filled1 - 1)
+    {
+      for(size_t numBlockInRowA = A->index1_data[rowA]; numBlockInRowA < A->index1_data[rowA + 1]; numBlockInRowA++)
+      {
+        /* insertion sort on the columns of C, rows are short */
+        size_t colC = inv[A->index2_data[numBlockInRowA]];
+        size_t pos = curNbBlockC;
+        while(pos > first && C->index2_data[pos - 1] > colC)
+        {
+          C->index2_data[pos] = C->index2_data[pos - 1];
+          blockInA[pos] = blockInA[pos - 1];
+          pos--;
+        }
+        C->index2_data[pos] = colC;
+        blockInA[pos] = numBlockInRowA;
+        curNbBlockC++;
+      }
+    }
+    C->index1_data[rowC + 1] = curNbBlockC;
+
+    unsigned int nbRowInBlock = C->blocksize0[rowC] - (rowC ? C->blocksize0[rowC - 1] : 0);
+    for(size_t blockNum = first; blockNum < curNbBlockC; blockNum++)
+    {
+      size_t colC = C->index2_data[blockNum];
+      unsigned int nbColInBlock = C->blocksize1[colC] - (colC ? C->blocksize1[colC - 1] : 0);
+      size_t size = nbRowInBlock * nbColInBlock;
+      C->block[blockNum] = (double*)malloc(size * sizeof(double));
+      memcpy(C->block[blockNum], A->block[blockInA[blockNum]], size * sizeof(double));
+    }
+  }
+  assert(curNbBlockC == A->nbblocks);
+  free(blockInA);
+  free(inv);
+}
@@ -248,11 +248,11 @@ extern "C"
      The routine has to be used with precaution. The allocation of C is not done
      since we want to add beta*C. We assume that the structure and the allocation
      of the matrix C are right. Especially:
-     
+
      - the blocks C(i,j) must exists
      - the sizes of blocks must be consistent
      - no extra block must be present in C
-     
+
      \param[in] alpha coefficient
      \param[in] A the matrix to be multiplied
      \param[in] B the matrix to be multiplied
@@ -266,7 +266,7 @@ extern "C"
   /**
      SparseBlockStructuredMatrix - SparseBlockStructuredMatrix multiplication C = A *B
      Correct allocation is performed
-     
+
      \param[in] A the matrix to be multiplied
      \param[in] B the matrix to be multiplied
      \return C the resulting matrix
@@ -279,7 +279,7 @@ extern "C"
 
   /**
      SparseBlockStructuredMatrix - SparseBlockStructuredMatrix addition C = alpha*A + beta*B
-     
+
      \param[in] A the matrix to be added
      \param[in] B the matrix to be added
      \param[in] alpha coefficient
@@ -291,7 +291,7 @@ extern "C"
   /**
      SparseBlockStructuredMatrix - SparseBlockStructuredMatrix addition C = alpha*A + beta*B + gamma*C without allocation.
      We assume that C has the correct structure
-     
+
      \param[in] A the matrix to be added
      \param[in] B the matrix to be added
      \param[in] alpha coefficient
@@ -316,7 +316,7 @@ extern "C"
 
   /**
      Row of a SparseMatrix - vector product y = rowA*x or y += rowA*x, rowA being a row of blocks of A
-     
+
      \param[in] sizeX dim of the vector x
      \param[in] sizeY dim of the vector y
      \param[in] currentRowNumber number of the required row of blocks
@@ -329,7 +329,7 @@ extern "C"
 
   /**
      Row of a SparseMatrix - vector product y = rowA*x or y += rowA*x, rowA being a row of blocks of A
-     
+
      \param[in] sizeX dim of the vector x
      \param[in] sizeY dim of the vector y
      \param[in] currentRowNumber number of the required row of blocks
@@ -342,7 +342,7 @@ extern "C"
 
   /**
      Row of a SparseMatrix - vector product y = rowA*x or y += rowA*x, rowA being a row of blocks of A of size 3x3
-     
+
      \param[in] sizeX dim of the vector x
      \param[in] sizeY dim of the vector y
      \param[in] currentRowNumber number of the required row of blocks
@@ -399,7 +399,7 @@ extern "C"
 
   /**
      Create from file a SparseBlockStructuredMatrix with  memory allocation
-     
+
      \param file the corresponding name of the file
      \return the matrix to be displayed
    */
@@ -407,7 +407,7 @@ extern "C"
 
   /**
      print in file  of the matrix content in Scilab format for each block
-     
+
      \param M the matrix to be displayed
      \param file the corresponding  file
   */
@@ -416,7 +416,7 @@ extern "C"
 
   /**
      print in file  of the matrix content
-     
+
      \param M the matrix to be displayed
      \param filename the corresponding file
   */
@@ -432,7 +432,7 @@ extern "C"
 
   /**
      Destructor for SparseBlockStructuredMatrixPred objects
-     
+
      \param blmatpred SparseBlockStructuredMatrix, the matrix to be destroyed.
    */
   void SBM_clear_pred(SparseBlockStructuredMatrixPred *blmatpred);
@@ -468,7 +468,7 @@ extern "C"
 
   /**
      get the element of row i and column j of the matrix M
-     
+
      \param M the SparseBlockStructuredMatrix matrix
      \param row the row index
      \param col the column index
@@ -478,7 +478,7 @@ extern "C"
 
   /**
      Copy of a SBM  A into B
-     
+
      \param[in] A the SparseBlockStructuredMatrix matrix to be copied
      \param[out]  B the SparseBlockStructuredMatrix matrix copy of A
      \param[in] copyBlock if copyBlock then the content of block are copied, else only the pointers are copied.
@@ -489,7 +489,7 @@ extern "C"
 
   /**
      Transpose  by copy of a SBM  A into B
-     
+
      \param[in] A the SparseBlockStructuredMatrix matrix to be copied
      \param[out]  B the SparseBlockStructuredMatrix matrix copy of transpose A
      \return 0 if ok
@@ -508,7 +508,7 @@ extern "C"
 
   /**
      Copy a SBM into a Dense Matrix
-     
+
      \param[in] A the SparseBlockStructuredMatrix matrix
      \param[in] denseMat pointer on the filled dense Matrix
   */
@@ -534,19 +534,19 @@ extern "C"
 
   /**
      Copy a block row of the SBM into a Dense Matrix
-     
+
      \param[in] A the SparseBlockStructuredMatrix matrix to be inversed.
      \param[in] row the block row index copied.
      \param[in] denseMat pointer on the filled dense Matrix.
      \param[in] rowPos line pos in the dense matrix.
      \param[in] rowNb total number of line of the dense matrix.
      The number of line copied is contained in M.
-     
+
    */
   void SBM_row_to_dense(const SparseBlockStructuredMatrix* const A, int row, double *denseMat, int rowPos, int rowNb);
 
   /**
-     
+
      \param [in] rowIndex: permutation: the row numC of C is the row rowIndex[numC] of A.
      \param [in] A The source SBM.
      \param [out] C The target SBM. It assumes the structure SBM has been allocated.
@@ -556,7 +556,7 @@ extern "C"
   void SBM_row_permutation(unsigned int *rowIndex, SparseBlockStructuredMatrix* A, SparseBlockStructuredMatrix*  C);
 
   /**
-     
+
      \param [in] colIndex: permutation: the col numC of C is the col colIndex[numC] of A.
      \param [in] A The source SBM.
      \param [out] C The target SBM. It assumes the structure SBM has been allocated.
@@ -565,6 +565,17 @@ extern "C"
   */
   void SBM_column_permutation(unsigned int *colIndex, SparseBlockStructuredMatrix* A, SparseBlockStructuredMatrix*  C);
 
+  /** Symmetric permutation \f$ C = P A P^T \f$ of a square SBM.
+     \param [in] perm: permutation: the row (and column) numC of C is the row (and column) perm[numC] of A.
+     \param [in] A The source SBM.
+     \param [out] C The target SBM. It assumes the structure SBM has been allocated.
+     The memory allocation for its menber is done inside.
+     NB : The blocks are copied in the order of the rows of C, so that
+     a sweep on the rows of C reads the blocks sequentially. The block
+     columns in each row of C are sorted.
+  */
+  void SBM_symmetric_permutation(unsigned int *perm, SparseBlockStructuredMatrix* A, SparseBlockStructuredMatrix*  C);
+
   void  SBCM_null(SparseBlockCoordinateMatrix* MC);
   
   SparseBlockCoordinateMatrix*  SBCM_new(void);
@@ -575,7 +586,7 @@ extern "C"
   /**
      allocate a SparseBlockCoordinateMatrix from a list of 3x3
      blocks
-     
+
      \param[in] m the number of rows
      \param[in] n the number of colums
      \param[in] nbblocks the number of blocks
@@ -606,14 +617,14 @@ extern "C"
 
   /**
      free a SparseBlockStructuredMatrix created with SBCM_to_SBM
-     
+
      \param[in,out] M a SparseBlockStructuredMatrix to free*/
   void SBM_free_from_SBCM(SparseBlockStructuredMatrix* M);
 
 
   /**
      Copy a Sparse Matrix into a SBM, with fixed blocksize
-     
+
      \param[in] blocksize the blocksize
      \param[in] sparseMat pointer on the Sparse Matrix
      \param[in,out] outSBM pointer on an empty SparseBlockStructuredMatrix
@@ -621,6 +632,19 @@ extern "C"
   */
   int SBM_from_csparse(int blocksize, const CSparseMatrix* const sparseMat, SparseBlockStructuredMatrix* outSBM);
 
+  /**
+     Copy a compressed column Sparse Matrix into a SBM, with the same
+     variable block sizes for rows and columns
+
+     \param[in] blocknumber the number of row (and column) blocks
+     \param[in] blocksize the cumulative block sizes, as blocksize0
+     \param[in] sparseMat pointer on the Sparse Matrix (csc)
+     \param[in,out] outSBM pointer on an empty SparseBlockStructuredMatrix
+     \return 0 in ok
+  */
+  int SBM_from_csparse_blocks(unsigned int blocknumber, const unsigned int* blocksize,
+                              const CSparseMatrix* const sparseMat, SparseBlockStructuredMatrix* outSBM);
+
 
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
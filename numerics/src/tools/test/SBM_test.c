@@ -23,6 +23,7 @@
  */
 
 #include "SBM_test.h"
+#include <math.h>                        // for fabs
 #include <stdio.h>                       // for printf, fclose, fopen, FILE
 #include <stdlib.h>                      // for free, malloc, calloc
 #include "CSparseMatrix_internal.h"               // for CSparseMatrix_spfree_on_stack
@@ -982,6 +983,74 @@ int test_SBM_row_permutation_all(void)
 }
 
 
+static int test_SBM_symmetric_permutation(SparseBlockStructuredMatrix *M)
+{
+  unsigned int nbRow = M->blocknumber0;
+  unsigned int * perm = (unsigned int*) malloc(nbRow * sizeof(unsigned int));
+  /* reverse the block rows and exchange the first two */
+  for(unsigned int i = 0; i < nbRow; i++)
+    perm[i] = nbRow - 1 - i;
+  if(nbRow > 2)
+  {
+    perm[0] = nbRow - 2;
+    perm[1] = nbRow - 1;
+  }
+  SparseBlockStructuredMatrix * MRes = SBM_new();
+  SBM_symmetric_permutation(perm, M, MRes);
+
+  /* scalar row of A corresponding to each scalar row of C */
+  unsigned int n = M->blocksize0[nbRow - 1];
+  unsigned int * scalarPerm = (unsigned int*) malloc(n * sizeof(unsigned int));
+  unsigned int k = 0;
+  for(unsigned int i = 0; i < nbRow; i++)
+  {
+    unsigned int start = perm[i] ? M->blocksize0[perm[i] - 1] : 0;
+    for(unsigned int r = start; r < M->blocksize0[perm[i]]; r++)
+      scalarPerm[k++] = r;
+  }
+  int info = (k != n) || (MRes->nbblocks != M->nbblocks);
+  for(unsigned int i = 0; i < n && !info; i++)
+    for(unsigned int j = 0; j < n; j++)
+      if(fabs(SBM_get_value(MRes, i, j) - SBM_get_value(M, scalarPerm[i], scalarPerm[j])) > 1e-14)
+      {
+        info = 1;
+        break;
+      }
+  /* columns are sorted in each row */
+  for(unsigned int i = 0; i < nbRow && !info; i++)
+    for(size_t b = MRes->index1_data[i] + 1; b < MRes->index1_data[i + 1]; b++)
+      if(MRes->index2_data[b - 1] >= MRes->index2_data[b])
+        info = 1;
+
+  SBM_clear(MRes);
+  free(MRes);
+  free(scalarPerm);
+  free(perm);
+  return info;
+}
+
+int test_SBM_symmetric_permutation_all(void)
+{
+  printf("========= Starts SBM tests SBM_symmetric_permutation ========= \n");
+  const char * files[] = {"data/SBM1.dat", "data/SBM2.dat"};
+  for(int f = 0; f < 2; f++)
+  {
+    FILE *file = fopen(files[f], "r");
+    SparseBlockStructuredMatrix * M = SBM_new_from_file(file);
+    fclose(file);
+    int res = test_SBM_symmetric_permutation(M);
+    SBM_clear(M);
+    if(res)
+    {
+      printf("========= Failed SBM tests SBM_symmetric_permutation for %s ========= \n", files[f]);
+      return 1;
+    }
+  }
+  printf("========= Ends SBM tests SBM_symmetric_permutation  :  successfull ========= \n");
+  return 0;
+}
+
+
 int test_SBM_row_to_dense_all(void)
 {
 
@@ -1284,6 +1353,8 @@ int main()
 
   info += test_SBM_row_permutation_all();
 
+  info += test_SBM_symmetric_permutation_all();
+
   info += SBM_extract_component_3x3_all();
 
   return info;
@@ -45,4 +45,6 @@ int test_SBM_column_permutation_all(void);
 
 int test_SBM_row_permutation_all(void);
 
+int test_SBM_symmetric_permutation_all(void);
+
 int SBM_extract_component_3x3_all(void);